@@ -0,0 +1,67 @@
+TEMPLATE = app
+TARGET = pathfinder-benchmark
+
+# The headless benchmark driver: loads a map, runs every search algorithm on a
+# seeded random query set and prints latency percentiles, expansions, frontier
+# peaks and allocations per algorithm. Other modes (--mode) time the other query
+# services on the same queries. It does not need spl.jar or a display.
+#
+# Usage: pathfinder-benchmark res/map-san-francisco.txt --queries 500
+#        pathfinder-benchmark res/map-san-francisco.txt --mode one-to-all
+#        pathfinder-benchmark res/map-san-francisco.txt --mode load --binary sf.pfmap
+
+CONFIG += console
+CONFIG += thread
+CONFIG -= app_bundle
+CONFIG -= qt
+CONFIG += warn_off
+CONFIG -= c++11
+
+# the search code and the map reader, without the GUI (PathfinderGUI, WorldDisplay)
+SOURCES += $$PWD/src/BatchQueryEngine.cpp
+SOURCES += $$PWD/src/Color.cpp
+SOURCES += $$PWD/src/CompiledRoadGraph.cpp
+SOURCES += $$PWD/src/ContractionHierarchy.cpp
+SOURCES += $$PWD/src/CustomizableHierarchy.cpp
+SOURCES += $$PWD/src/DistanceTableEngine.cpp
+SOURCES += $$PWD/src/Heuristic.cpp
+SOURCES += $$PWD/src/IncrementalPlanner.cpp
+SOURCES += $$PWD/src/LandmarkHeuristic.cpp
+SOURCES += $$PWD/src/OneToAllSearch.cpp
+SOURCES += $$PWD/src/RoadGraph.cpp
+SOURCES += $$PWD/src/RoadMapBinary.cpp
+SOURCES += $$PWD/src/RoadMapReader.cpp
+SOURCES += $$PWD/src/RouteCache.cpp
+SOURCES += $$PWD/src/SpatialIndex.cpp
+SOURCES += $$PWD/src/TravelTimeProfiles.cpp
+SOURCES += $$PWD/src/TurnCosts.cpp
+SOURCES += $$PWD/src/pathfinder.cpp
+SOURCES += $$PWD/src/bench/*.cpp
+
+# the parts of the C++ library that the search code uses; platform.cpp, which
+# talks to the Java back-end, is replaced by src/bench/headless.cpp
+SOURCES += $$PWD/lib/CPPLib/collections/hashcode.cpp
+SOURCES += $$PWD/lib/CPPLib/io/tokenscanner.cpp
+SOURCES += $$PWD/lib/CPPLib/system/error.cpp
+SOURCES += $$PWD/lib/CPPLib/util/observable.cpp
+SOURCES += $$PWD/lib/CPPLib/util/point.cpp
+SOURCES += $$PWD/lib/CPPLib/util/strlib.cpp
+
+INCLUDEPATH += $$PWD/lib/CPPLib/
+INCLUDEPATH += $$PWD/lib/CPPLib/collections/
+INCLUDEPATH += $$PWD/lib/CPPLib/io/
+INCLUDEPATH += $$PWD/lib/CPPLib/system/
+INCLUDEPATH += $$PWD/lib/CPPLib/util/
+INCLUDEPATH += $$PWD/src/
+
+QMAKE_CXXFLAGS += -std=c++11
+QMAKE_CXXFLAGS += -O2
+QMAKE_CXXFLAGS += -Wall
+QMAKE_CXXFLAGS += -Wextra
+QMAKE_CXXFLAGS += -Wno-sign-compare
+QMAKE_CXXFLAGS += -Werror=return-type
+QMAKE_CXXFLAGS += -Werror=uninitialized
+
+# benchmark.cpp replaces the global operator new/delete with malloc/free to count
+# allocations, which newer GCCs mistake for a mismatched new/free pair
+QMAKE_CXXFLAGS += -Wno-mismatched-new-delete
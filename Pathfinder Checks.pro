@@ -0,0 +1,74 @@
+TEMPLATE = app
+TARGET = pathfinder-checks
+
+# The correctness checks of the parts of the search code the GUI cannot show to
+# be right: the renderer thread that draws the search animation (EventRing and
+# AsyncRenderer, under a stress load), the spatial queries (SpatialIndex against
+# a scan of every node) and the edge-based search (against Dijkstra's algorithm
+# on an explicit line graph). It is built with ThreadSanitizer, so a data race
+# between the search and the renderer fails the run even when the colors come
+# out right. Like the benchmark it does not need spl.jar or a display.
+#
+# Usage: pathfinder-checks                 (run from the project directory)
+#        pathfinder-checks --maps res turn-costs
+
+CONFIG += console
+CONFIG += thread
+CONFIG -= app_bundle
+CONFIG -= qt
+CONFIG += warn_off
+CONFIG -= c++11
+
+# the search code, the map reader and the renderer thread, without the GUI
+# (PathfinderGUI, WorldDisplay)
+SOURCES += $$PWD/src/AsyncRenderer.cpp
+SOURCES += $$PWD/src/BatchQueryEngine.cpp
+SOURCES += $$PWD/src/Color.cpp
+SOURCES += $$PWD/src/CompiledRoadGraph.cpp
+SOURCES += $$PWD/src/ContractionHierarchy.cpp
+SOURCES += $$PWD/src/CustomizableHierarchy.cpp
+SOURCES += $$PWD/src/DistanceTableEngine.cpp
+SOURCES += $$PWD/src/Heuristic.cpp
+SOURCES += $$PWD/src/IncrementalPlanner.cpp
+SOURCES += $$PWD/src/LandmarkHeuristic.cpp
+SOURCES += $$PWD/src/OneToAllSearch.cpp
+SOURCES += $$PWD/src/RoadGraph.cpp
+SOURCES += $$PWD/src/RoadMapBinary.cpp
+SOURCES += $$PWD/src/RoadMapReader.cpp
+SOURCES += $$PWD/src/RouteCache.cpp
+SOURCES += $$PWD/src/SpatialIndex.cpp
+SOURCES += $$PWD/src/TravelTimeProfiles.cpp
+SOURCES += $$PWD/src/TurnCosts.cpp
+SOURCES += $$PWD/src/pathfinder.cpp
+SOURCES += $$PWD/src/bench/headless.cpp
+SOURCES += $$PWD/src/check/*.cpp
+
+# the parts of the C++ library that the search code uses; platform.cpp, which
+# talks to the Java back-end, is replaced by src/bench/headless.cpp
+SOURCES += $$PWD/lib/CPPLib/collections/hashcode.cpp
+SOURCES += $$PWD/lib/CPPLib/io/tokenscanner.cpp
+SOURCES += $$PWD/lib/CPPLib/system/error.cpp
+SOURCES += $$PWD/lib/CPPLib/util/observable.cpp
+SOURCES += $$PWD/lib/CPPLib/util/point.cpp
+SOURCES += $$PWD/lib/CPPLib/util/strlib.cpp
+
+INCLUDEPATH += $$PWD/lib/CPPLib/
+INCLUDEPATH += $$PWD/lib/CPPLib/collections/
+INCLUDEPATH += $$PWD/lib/CPPLib/io/
+INCLUDEPATH += $$PWD/lib/CPPLib/system/
+INCLUDEPATH += $$PWD/lib/CPPLib/util/
+INCLUDEPATH += $$PWD/src/
+INCLUDEPATH += $$PWD/src/check/
+
+QMAKE_CXXFLAGS += -std=c++11
+QMAKE_CXXFLAGS += -O1
+QMAKE_CXXFLAGS += -g
+QMAKE_CXXFLAGS += -Wall
+QMAKE_CXXFLAGS += -Wextra
+QMAKE_CXXFLAGS += -Wno-sign-compare
+QMAKE_CXXFLAGS += -Werror=return-type
+QMAKE_CXXFLAGS += -Werror=uninitialized
+
+# ThreadSanitizer, in the compiler and the linker
+QMAKE_CXXFLAGS += -fsanitize=thread
+QMAKE_LFLAGS += -fsanitize=thread
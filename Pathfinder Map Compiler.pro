@@ -0,0 +1,52 @@
+TEMPLATE = app
+TARGET = pathfinder-compile-map
+
+# The map compiler: reads a world text file and writes it as a binary map
+# (see src/RoadMapBinary.h) that the searches can memory-map instead of parsing.
+# Like the benchmark it does not need spl.jar or a display.
+#
+# Usage: pathfinder-compile-map res/map-san-francisco.txt map-san-francisco.pfmap
+
+CONFIG += console
+CONFIG += thread
+CONFIG -= app_bundle
+CONFIG -= qt
+CONFIG += warn_off
+CONFIG -= c++11
+
+# the graph, the map reader and the binary format, without the GUI
+SOURCES += $$PWD/src/Color.cpp
+SOURCES += $$PWD/src/CompiledRoadGraph.cpp
+SOURCES += $$PWD/src/ContractionHierarchy.cpp
+SOURCES += $$PWD/src/CustomizableHierarchy.cpp
+SOURCES += $$PWD/src/RoadGraph.cpp
+SOURCES += $$PWD/src/RoadMapBinary.cpp
+SOURCES += $$PWD/src/RoadMapReader.cpp
+SOURCES += $$PWD/src/SpatialIndex.cpp
+SOURCES += $$PWD/src/TravelTimeProfiles.cpp
+SOURCES += $$PWD/src/bench/headless.cpp
+SOURCES += $$PWD/src/tools/*.cpp
+
+# the parts of the C++ library that the graph and the reader use; see
+# Pathfinder Benchmark.pro
+SOURCES += $$PWD/lib/CPPLib/collections/hashcode.cpp
+SOURCES += $$PWD/lib/CPPLib/io/tokenscanner.cpp
+SOURCES += $$PWD/lib/CPPLib/system/error.cpp
+SOURCES += $$PWD/lib/CPPLib/util/observable.cpp
+SOURCES += $$PWD/lib/CPPLib/util/point.cpp
+SOURCES += $$PWD/lib/CPPLib/util/strlib.cpp
+
+INCLUDEPATH += $$PWD/lib/CPPLib/
+INCLUDEPATH += $$PWD/lib/CPPLib/collections/
+INCLUDEPATH += $$PWD/lib/CPPLib/io/
+INCLUDEPATH += $$PWD/lib/CPPLib/system/
+INCLUDEPATH += $$PWD/lib/CPPLib/util/
+INCLUDEPATH += $$PWD/src/
+
+QMAKE_CXXFLAGS += -std=c++11
+QMAKE_CXXFLAGS += -O2
+QMAKE_CXXFLAGS += -Wall
+QMAKE_CXXFLAGS += -Wextra
+QMAKE_CXXFLAGS += -Wno-sign-compare
+QMAKE_CXXFLAGS += -Werror=return-type
+QMAKE_CXXFLAGS += -Werror=uninitialized
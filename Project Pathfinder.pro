@@ -3,6 +3,7 @@ TEMPLATE = app
 CONFIG += no_include_pwd   # make sure we do not accidentally #include files placed in 'resources'
 CONFIG += warn_off         # turn off default -Wall (we will add it back ourselves)
 CONFIG -= c++11            # turn off default -std=gnu++11
+CONFIG += thread           # link the thread library (batch queries, renderer)
 
 PROJECT_FILTER =
 
@@ -5,6 +5,11 @@
  * to represent <b><i>graphs,</i></b> which consist of a set of
  * <b><i>nodes</i></b> (vertices) and a set of <b><i>arcs</i></b> (edges).
  * 
+ * @version 2026/10/16
+ * - added an opt-in hashed indexing mode (see GraphIndexing)
+ * - hashed mode files the arcs of each node by finish node for getArc
+ * - added an opt-in arena storage mode (see GraphStorage)
+ * - fixed containsArc(arc), which called a getEdgeSet method that does not exist
  * @version 2016/12/01
  * - removed memory leaks of graph vertex and edge structures
  * - fixed bug in containsNode method (was returning false positives)
@@ -37,7 +42,16 @@
 #ifndef _graph_h
 #define _graph_h
 
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <new>
 #include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 #include "collections.h"
 #include "error.h"
 #include "hashcode.h"
@@ -45,6 +59,69 @@
 #include "set.h"
 #include "tokenscanner.h"
 
+/*
+ * Class: GraphIndexing<NodeType>
+ * ------------------------------
+ * Chooses how a <code>Graph</code> whose nodes are of the given type indexes
+ * its nodes and arcs.  By default, nodes are looked up by name in an ordered
+ * map, and the node and arc sets are kept in order as they change, so every
+ * <code>addArc</code> or node check costs string comparisons down a tree.
+ *
+ * <p>A node type opts into hashed indexing by specializing this class before
+ * any graph of that type is used:
+ *
+ *<pre>
+ *    template <>
+ *    struct GraphIndexing<MyNode> {
+ *        enum { HASHED = 1 };
+ *    };
+ *</pre>
+ *
+ * <p>A hashed graph gives each node a dense integer ID, kept in an
+ * <code>int</code> field called <code>index</code> that the node type must
+ * then provide; it finds names through a hash table and checks membership by
+ * ID.  The ordered node and arc sets behind <code>getNodeSet</code>,
+ * <code>getArcSet</code> and the node iterators are rebuilt on first use after
+ * a change instead of being kept up to date, so a graph that has changed must
+ * not be read from several threads at once until they have been requested.
+ * The public interface and the iteration order are the same in both modes.
+ */
+template <typename NodeType>
+struct GraphIndexing {
+    enum { HASHED = 0 };
+};
+
+/*
+ * Class: GraphStorage<NodeType>
+ * -----------------------------
+ * This traits class selects where a <code>Graph</code> keeps the nodes and
+ * arcs it owns.  By default every node and arc is a separate heap object,
+ * made with <code>new</code> and freed with <code>delete</code> one by one.
+ *
+ * <p>A node type opts into arena storage by specializing this class, in the
+ * same way as <code>GraphIndexing</code>:
+ *
+ *<pre>
+ *    template <>
+ *    struct GraphStorage<MyNode> {
+ *        enum { ARENA = 1 };
+ *    };
+ *</pre>
+ *
+ * <p>The graph then carves the nodes and arcs it creates, and the ones made
+ * with <code>createNode</code> and <code>createArc</code>, out of a few large
+ * blocks, so building a big graph takes few allocations and keeps its nodes
+ * and arcs close together in memory.  Removing a node or arc runs its
+ * destructor but leaves its memory in the arena until the graph is cleared,
+ * which frees the blocks all at once; an arc type that is trivially
+ * destructible costs nothing to tear down.  Nodes and arcs the client made
+ * with <code>new</code> are still deleted as usual.
+ */
+template <typename NodeType>
+struct GraphStorage {
+    enum { ARENA = 0 };
+};
+
 /*
  * Class: Graph<NodeType, ArcType>
  * -------------------------------
@@ -59,6 +136,8 @@
  * <ul>
  *   <li>A <code>string</code> field called <code>name</code>
  *   <li>A <code>Set&lt;ArcType *&gt;</code> field called <code>arcs</code>
+ *   <li>An <code>int</code> field called <code>index</code>, if the node type
+ *       opts into hashed indexing (see <code>GraphIndexing</code>)
  * </ul>
  *
  * <p>The <code>ArcType</code> definition must include:
@@ -184,6 +263,21 @@ public:
     bool containsNode(const std::string& name) const;
     bool containsNode(NodeType* node) const;
 
+    /*
+     * Method: createArc, createNode
+     * Usage: ArcType* arc = g.createArc(args);
+     *        NodeType* node = g.createNode(args);
+     * ---------------------------------------
+     * Constructs an arc or node from the given constructor arguments in the
+     * storage of this graph (see <code>GraphStorage</code>), without adding it
+     * to the graph.  The result must then be passed to <code>addArc</code> or
+     * <code>addNode</code>, which take ownership of it as usual.
+     */
+    template <typename... Args>
+    ArcType* createArc(Args&&... args);
+    template <typename... Args>
+    NodeType* createNode(Args&&... args);
+
     /*
      * Method: equals
      * Usage: if (graph.equals(graph2)) ...
@@ -591,11 +685,382 @@ public:
     };
 
 private:
+    /*
+     * Private class: GraphIndex<HASHED>
+     * ---------------------------------
+     * The node lookup, the arc lookup and the ordered node and arc sets of a
+     * graph, in each of the two indexing modes.  The arc set of each node is
+     * kept by the graph.
+     * The second parameter only lets the modes be partial specializations, which
+     * unlike explicit ones may be declared inside the class.
+     */
+    template <bool HASHED, typename Unused = void>
+    class GraphIndex;
+
+    template <typename Unused>
+    class GraphIndex<false, Unused> {
+    public:
+        explicit GraphIndex(GraphComparator comparator)
+            : nodes(comparator), arcs(comparator) {
+            // empty
+        }
+
+        NodeType* getNode(const std::string& name) const {
+            return nodeMap.get(name);
+        }
+
+        bool containsName(const std::string& name) const {
+            return nodeMap.containsKey(name);
+        }
+
+        bool containsNode(NodeType* node) const {
+            return node && nodeMap.containsKey(node->name) && nodeMap.get(node->name) == node;
+        }
+
+        bool containsArc(ArcType* arc) const {
+            return arcs.contains(arc);
+        }
+
+        ArcType* findArc(NodeType* start, NodeType* finish) const {
+            for (ArcType* arc : start->arcs) {
+                if (arc->finish == finish) {
+                    return arc;
+                }
+            }
+            return nullptr;
+        }
+
+        void addNode(NodeType* node) {
+            nodes.add(node);
+            nodeMap[node->name] = node;
+        }
+
+        void replaceNode(NodeType* existingNode, NodeType* node) {
+            *existingNode = *node;   // copy state from parameter
+        }
+
+        void removeNode(NodeType* node) {
+            nodes.remove(node);
+            nodeMap.remove(node->name);
+        }
+
+        void addArc(ArcType* arc) {
+            arcs.add(arc);
+        }
+
+        void removeArc(ArcType* arc) {
+            arcs.remove(arc);
+        }
+
+        const Set<NodeType*>& nodeSet() const {
+            return nodes;
+        }
+
+        const Set<ArcType*>& arcSet() const {
+            return arcs;
+        }
+
+        int nodeCount() const {
+            return nodes.size();
+        }
+
+        template <typename Allocator>
+        void deleteAll(Allocator& allocator) {
+            for (NodeType* node : nodes) {
+                allocator.destroy(node);
+            }
+            for (ArcType* arc : arcs) {
+                allocator.destroy(arc);
+            }
+            arcs.clear();
+            nodes.clear();
+            nodeMap.clear();
+        }
+
+    private:
+        Set<NodeType*> nodes;                  /* The set of nodes in the graph */
+        Set<ArcType*> arcs;                    /* The set of arcs in the graph  */
+        Map<std::string, NodeType*> nodeMap;   /* A map from names to nodes     */
+    };
+
+    template <typename Unused>
+    class GraphIndex<true, Unused> {
+    public:
+        explicit GraphIndex(GraphComparator comparator)
+            : nodes(comparator), arcs(comparator) {
+            // empty
+        }
+
+        NodeType* getNode(const std::string& name) const {
+            auto found = nodeMap.find(name);
+            return found == nodeMap.end() ? nullptr : found->second;
+        }
+
+        bool containsName(const std::string& name) const {
+            return nodeMap.count(name) != 0;
+        }
+
+        bool containsNode(NodeType* node) const {
+            return node && node->index >= 0 && node->index < (int) nodeList.size()
+                    && nodeList[node->index] == node;
+        }
+
+        /* Every arc is in the arc set of its start node. */
+        bool containsArc(ArcType* arc) const {
+            return containsNode(arc->start) && arc->start->arcs.contains(arc);
+        }
+
+        /*
+         * Of several arcs between the same nodes, the one at the lowest address
+         * comes first in the arc set of the start node, and so it is the one the
+         * ordered mode finds too.
+         */
+        ArcType* findArc(NodeType* start, NodeType* finish) const {
+            const std::vector<ArcEntry>& entries = outArcs[start->index];
+            auto found = std::lower_bound(entries.begin(), entries.end(),
+                                          ArcEntry(finish, nullptr), entryLess);
+            return found != entries.end() && found->first == finish ? found->second : nullptr;
+        }
+
+        void addNode(NodeType* node) {
+            node->index = nodeList.size();
+            nodeList.push_back(node);
+            outArcs.emplace_back();
+            indexArcs(node);
+            nodeMap[node->name] = node;
+            nodesStale = true;
+        }
+
+        /* The copied state must not include the ID. */
+        void replaceNode(NodeType* existingNode, NodeType* node) {
+            int id = existingNode->index;
+            *existingNode = *node;   // copy state from parameter
+            existingNode->index = id;
+            indexArcs(existingNode);
+            arcsStale = true;
+        }
+
+        /* The last node moves into the hole, so that the IDs stay dense. */
+        void removeNode(NodeType* node) {
+            NodeType* last = nodeList.back();
+            last->index = node->index;
+            nodeList[node->index] = last;
+            nodeList.pop_back();
+            outArcs[node->index].swap(outArcs.back());
+            outArcs.pop_back();
+            nodeMap.erase(node->name);
+            node->index = -1;
+            nodesStale = true;
+        }
+
+        void addArc(ArcType* arc) {
+            std::vector<ArcEntry>& entries = outArcs[arc->start->index];
+            ArcEntry entry(arc->finish, arc);
+            entries.insert(std::lower_bound(entries.begin(), entries.end(), entry, entryLess),
+                           entry);
+            arcsStale = true;
+        }
+
+        void removeArc(ArcType* arc) {
+            std::vector<ArcEntry>& entries = outArcs[arc->start->index];
+            ArcEntry entry(arc->finish, arc);
+            auto found = std::lower_bound(entries.begin(), entries.end(), entry, entryLess);
+            if (found != entries.end() && found->second == arc) {
+                entries.erase(found);
+            }
+            arcsStale = true;
+        }
+
+        const Set<NodeType*>& nodeSet() const {
+            if (nodesStale) {
+                nodes.clear();
+                for (NodeType* node : nodeList) {
+                    nodes.add(node);
+                }
+                nodesStale = false;
+            }
+            return nodes;
+        }
+
+        const Set<ArcType*>& arcSet() const {
+            if (arcsStale) {
+                arcs.clear();
+                for (NodeType* node : nodeList) {
+                    for (ArcType* arc : node->arcs) {
+                        arcs.add(arc);
+                    }
+                }
+                arcsStale = false;
+            }
+            return arcs;
+        }
+
+        int nodeCount() const {
+            return nodeList.size();
+        }
+
+        template <typename Allocator>
+        void deleteAll(Allocator& allocator) {
+            for (NodeType* node : nodeList) {
+                for (ArcType* arc : node->arcs) {
+                    allocator.destroy(arc);
+                }
+                allocator.destroy(node);
+            }
+            nodeList.clear();
+            outArcs.clear();
+            nodeMap.clear();
+            nodes.clear();
+            arcs.clear();
+            nodesStale = false;
+            arcsStale = false;
+        }
+
+    private:
+        /* An arc out of a node, filed under its finish node. */
+        typedef std::pair<NodeType*, ArcType*> ArcEntry;
+
+        static bool entryLess(const ArcEntry& e1, const ArcEntry& e2) {
+            std::less<void*> less;
+            if (e1.first != e2.first) {
+                return less(e1.first, e2.first);
+            }
+            return less(e1.second, e2.second);
+        }
+
+        /* Files the arcs in the arc set of the node under their finish nodes. */
+        void indexArcs(NodeType* node) {
+            std::vector<ArcEntry>& entries = outArcs[node->index];
+            entries.clear();
+            for (ArcType* arc : node->arcs) {
+                entries.push_back(ArcEntry(arc->finish, arc));
+            }
+            std::sort(entries.begin(), entries.end(), entryLess);
+        }
+
+        std::vector<NodeType*> nodeList;                    /* The nodes by ID   */
+        std::vector<std::vector<ArcEntry>> outArcs;  /* Arcs by ID, then finish */
+        std::unordered_map<std::string, NodeType*> nodeMap; /* The nodes by name */
+        mutable Set<NodeType*> nodes;    /* The ordered node set, rebuilt on use */
+        mutable Set<ArcType*> arcs;      /* The ordered arc set, rebuilt on use  */
+        mutable bool nodesStale = false;
+        mutable bool arcsStale = false;
+    };
+
+    /*
+     * Private class: GraphAllocator<ARENA>
+     * ------------------------------------
+     * Makes and frees the nodes and arcs of a graph, in each of the two
+     * storage modes.
+     */
+    template <bool ARENA, typename Unused = void>
+    class GraphAllocator;
+
+    template <typename Unused>
+    class GraphAllocator<false, Unused> {
+    public:
+        template <typename T, typename... Args>
+        T* create(Args&&... args) {
+            return new T(std::forward<Args>(args)...);
+        }
+
+        template <typename T>
+        void destroy(T* object) {
+            delete object;
+        }
+
+        void release() {
+            // empty
+        }
+    };
+
+    template <typename Unused>
+    class GraphAllocator<true, Unused> {
+    public:
+        GraphAllocator() = default;
+
+        /* A copied graph copies its nodes and arcs into an arena of its own. */
+        GraphAllocator(const GraphAllocator&) {
+            // empty
+        }
+
+        GraphAllocator& operator =(const GraphAllocator&) {
+            return *this;
+        }
+
+        ~GraphAllocator() {
+            release();
+        }
+
+        template <typename T, typename... Args>
+        T* create(Args&&... args) {
+            return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        }
+
+        /* Objects in the arena are destroyed in place; others were made with new. */
+        template <typename T>
+        void destroy(T* object) {
+            if (!owns(object)) {
+                delete object;
+            } else if (!std::is_trivially_destructible<T>::value) {
+                object->~T();
+            }
+        }
+
+        /* Frees every block; the objects in them must have been destroyed. */
+        void release() {
+            for (char* block : blocks) {
+                std::free(block);
+            }
+            blocks.clear();
+            blockEnds.clear();
+            next = limit = nullptr;
+        }
+
+    private:
+        enum { FIRST_BLOCK_SIZE = 4096 };
+
+        std::vector<char*> blocks;      /* The blocks, oldest first           */
+        std::vector<char*> blockEnds;   /* The end of each block              */
+        char* next = nullptr;           /* The free space in the newest block */
+        char* limit = nullptr;
+
+        /* Each block is twice the size of the one before, so there are few. */
+        void* allocate(size_t size, size_t align) {
+            uintptr_t start = (reinterpret_cast<uintptr_t>(next) + align - 1) & ~(align - 1);
+            if (!next || start + size > reinterpret_cast<uintptr_t>(limit)) {
+                size_t blockSize = blocks.empty() ? (size_t) FIRST_BLOCK_SIZE
+                                                  : 2 * (size_t) (blockEnds.back() - blocks.back());
+                blockSize = std::max(blockSize, size + align);
+                char* block = static_cast<char*>(std::malloc(blockSize));
+                if (!block) {
+                    throw std::bad_alloc();
+                }
+                blocks.push_back(block);
+                blockEnds.push_back(block + blockSize);
+                next = block;
+                limit = block + blockSize;
+                start = (reinterpret_cast<uintptr_t>(next) + align - 1) & ~(align - 1);
+            }
+            next = reinterpret_cast<char*>(start + size);
+            return reinterpret_cast<void*>(start);
+        }
+
+        bool owns(const void* object) const {
+            std::less<const void*> less;
+            for (size_t i = 0; i < blocks.size(); i++) {
+                if (!less(object, blocks[i]) && less(object, blockEnds[i])) {
+                    return true;
+                }
+            }
+            return false;
+        }
+    };
+
     /* Instance variables */
-    Set<NodeType*> nodes;                  /* The set of nodes in the graph */
-    Set<ArcType*> arcs;                    /* The set of arcs in the graph  */
-    Map<std::string, NodeType*> nodeMap;   /* A map from names to nodes     */
     GraphComparator comparator;            /* The comparator for this graph */
+    GraphIndex<GraphIndexing<NodeType>::HASHED> index;   /* Nodes and arcs  */
+    GraphAllocator<GraphStorage<NodeType>::ARENA> allocator;   /* Their storage */
 
 public:
     /*
@@ -656,16 +1121,14 @@ private:
  * arcs set are given the correct comparison functions.
  */
 template <typename NodeType, typename ArcType>
-Graph<NodeType, ArcType>::Graph() {
-    comparator = GraphComparator();
-    nodes = Set<NodeType*>(comparator);
-    arcs = Set<ArcType*>(comparator);
+Graph<NodeType, ArcType>::Graph()
+    : comparator(), index(comparator) {
+    // empty
 }
 
 template <typename NodeType, typename ArcType>
-Graph<NodeType, ArcType>::Graph(const Graph& src) {
-    nodes = Set<NodeType*>(comparator);
-    arcs = Set<ArcType*>(comparator);
+Graph<NodeType, ArcType>::Graph(const Graph& src)
+    : comparator(), index(comparator) {
     deepCopy(src);
 }
 
@@ -702,7 +1165,7 @@ ArcType* Graph<NodeType, ArcType>::addArc(NodeType* n1, NodeType* n2) {
     if (arc) {
         return arc;
     } else {
-        arc = new ArcType();
+        arc = allocator.template create<ArcType>();
         arc->start = n1;
         arc->finish = n2;
         return addArc(arc);
@@ -719,7 +1182,7 @@ ArcType* Graph<NodeType, ArcType>::addArc(ArcType* arc) {
         addNode(arc->finish);
     }
     arc->start->arcs.add(arc);
-    arcs.add(arc);
+    index.addArc(arc);
     return arc;
 }
 
@@ -738,7 +1201,7 @@ NodeType* Graph<NodeType, ArcType>::addNode(const std::string& name) {
     if (node) {
         return node;   // vertex already exists
     }
-    node = new NodeType();
+    node = allocator.template create<NodeType>();
     node->arcs = Set<ArcType*>(comparator);
     node->name = name;
     return addNode(node);
@@ -749,11 +1212,10 @@ NodeType* Graph<NodeType, ArcType>::addNode(NodeType* node) {
     verifyNotNull(node, "addNode");
     NodeType* existingNode = getNode(node->name);
     if (existingNode) {
-        *existingNode = *node;   // copy state from parameter
+        index.replaceNode(existingNode, node);
         return existingNode;
     } else {
-        nodes.add(node);
-        nodeMap[node->name] = node;
+        index.addNode(node);
         return node;
     }
 }
@@ -763,19 +1225,13 @@ NodeType* Graph<NodeType, ArcType>::addNode(NodeType* node) {
  * ---------------------------
  * The implementation of clear first frees the nodes and arcs in
  * their respective sets and then uses the Set class clear method
- * to ensure that these sets are empty.
+ * to ensure that these sets are empty.  In arena storage, the
+ * blocks that held the nodes and arcs are then freed together.
  */
 template <typename NodeType, typename ArcType>
 void Graph<NodeType, ArcType>::clear() {
-    for (NodeType* node : nodes) {
-        delete node;
-    }
-    for (ArcType* arc : arcs) {
-        delete arc;
-    }
-    arcs.clear();
-    nodes.clear();
-    nodeMap.clear();
+    index.deleteAll(allocator);
+    allocator.release();
 }
 
 template <typename NodeType, typename ArcType>
@@ -814,25 +1270,29 @@ bool Graph<NodeType, ArcType>::containsArc(const std::string& node1, const std::
 
 template <typename NodeType, typename ArcType>
 bool Graph<NodeType, ArcType>::containsArc(ArcType* arc) const {
-    if (!arc) {
-        return false;
-    } else {
-        return this->getEdgeSet().contains(arc);
-    }
+    return isExistingArc(arc);
 }
 
 template <typename NodeType, typename ArcType>
 bool Graph<NodeType, ArcType>::containsNode(const std::string& name) const {
-    return nodeMap.containsKey(name);
+    return index.containsName(name);
 }
 
 template <typename NodeType, typename ArcType>
 bool Graph<NodeType, ArcType>::containsNode(NodeType* node) const {
-    if (node) {
-        return nodes.contains(node);
-    } else {
-        return false;
-    }
+    return isExistingNode(node);
+}
+
+template <typename NodeType, typename ArcType>
+template <typename... Args>
+ArcType* Graph<NodeType, ArcType>::createArc(Args&&... args) {
+    return allocator.template create<ArcType>(std::forward<Args>(args)...);
+}
+
+template <typename NodeType, typename ArcType>
+template <typename... Args>
+NodeType* Graph<NodeType, ArcType>::createNode(Args&&... args) {
+    return allocator.template create<NodeType>(std::forward<Args>(args)...);
 }
 
 
@@ -846,12 +1306,7 @@ ArcType* Graph<NodeType, ArcType>::getArc(NodeType* node1, NodeType* node2) cons
     if (!containsNode(node1) || !containsNode(node2)) {
         return nullptr;
     }
-    for (ArcType* arc : getArcSet(node1)) {
-        if (arc->finish == node2) {
-            return arc;
-        }
-    }
-    return nullptr;
+    return index.findArc(node1, node2);
 }
 
 template <typename NodeType, typename ArcType>
@@ -861,7 +1316,7 @@ ArcType* Graph<NodeType, ArcType>::getArc(const std::string& node1, const std::s
 
 template <typename NodeType, typename ArcType>
 const Set<ArcType*>& Graph<NodeType, ArcType>::getArcSet() const {
-    return arcs;
+    return index.arcSet();
 }
 
 template <typename NodeType, typename ArcType>
@@ -877,7 +1332,7 @@ const Set<ArcType*>& Graph<NodeType, ArcType>::getArcSet(const std::string& name
 
 template <typename NodeType, typename ArcType>
 NodeType* Graph<NodeType, ArcType>::getExistingNode(const std::string& name, const std::string& member) const {
-    NodeType* node = nodeMap.get(name);
+    NodeType* node = index.getNode(name);
     if (!node) {
         error("Graph::" + member + ": no node named " + name);
     }
@@ -886,12 +1341,12 @@ NodeType* Graph<NodeType, ArcType>::getExistingNode(const std::string& name, con
 
 template <typename NodeType, typename ArcType>
 bool Graph<NodeType, ArcType>::isExistingArc(ArcType* arc) const {
-    return arc && arcs.contains(arc);
+    return arc && index.containsArc(arc);
 }
 
 template <typename NodeType, typename ArcType>
 bool Graph<NodeType, ArcType>::isExistingNode(NodeType* node) const {
-    return node && nodeMap.containsKey(node->name) && nodeMap.get(node->name) == node;
+    return index.containsNode(node);
 }
 
 template <typename NodeType, typename ArcType>
@@ -1014,7 +1469,7 @@ Set<NodeType*> Graph<NodeType, ArcType>::getNeighbors(const std::string& name) c
  */
 template <typename NodeType, typename ArcType>
 NodeType* Graph<NodeType, ArcType>::getNode(const std::string& name) const {
-    return nodeMap.get(name);
+    return index.getNode(name);
 }
 
 /*
@@ -1026,7 +1481,7 @@ NodeType* Graph<NodeType, ArcType>::getNode(const std::string& name) const {
  */
 template <typename NodeType, typename ArcType>
 const Set<NodeType*>& Graph<NodeType, ArcType>::getNodeSet() const {
-    return nodes;
+    return index.nodeSet();
 }
 
 /*
@@ -1043,19 +1498,14 @@ bool Graph<NodeType, ArcType>::isConnected(NodeType* n1, NodeType* n2) const {
     if (!isExistingNode(n1) || !isExistingNode(n2)) {
         return false;
     }
-    for (ArcType* arc : n1->arcs) {
-        if (arc->finish == n2) {
-            return true;
-        }
-    }
-    return false;
+    return index.findArc(n1, n2) != nullptr;
 }
 
 template <typename NodeType, typename ArcType>
 bool Graph<NodeType, ArcType>::isConnected(const std::string& s1, const std::string& s2) const {
     // don't call getExistingNode here because it will throw an error
     // if s1 or s2 is not found; should just make the call return false
-    return isConnected(nodeMap.get(s1), nodeMap.get(s2));
+    return isConnected(getNode(s1), getNode(s2));
 }
 
 template <typename NodeType, typename ArcType>
@@ -1070,7 +1520,7 @@ bool Graph<NodeType, ArcType>::isNeighbor(NodeType* node1, NodeType* node2) cons
 
 template <typename NodeType, typename ArcType>
 bool Graph<NodeType, ArcType>::isEmpty() const {
-    return nodes.isEmpty();
+    return index.nodeCount() == 0;
 }
 
 /*
@@ -1087,7 +1537,7 @@ template <typename NodeType, typename ArcType>
 void Graph<NodeType, ArcType>::removeArc(const std::string& s1, const std::string& s2) {
     // don't call getExistingNode here because it will throw an error
     // if s1 or s2 is not found; should just make the call have no effect
-    removeArc(nodeMap.get(s1), nodeMap.get(s2));
+    removeArc(getNode(s1), getNode(s2));
 }
 
 template <typename NodeType, typename ArcType>
@@ -1098,8 +1548,8 @@ void Graph<NodeType, ArcType>::removeArc(NodeType* n1, NodeType* n2) {
         return;
     }
     Vector<ArcType*> toRemove;
-    for (ArcType* arc : arcs) {
-        if (arc->start == n1 && arc->finish == n2) {
+    for (ArcType* arc : n1->arcs) {
+        if (arc->finish == n2) {
             toRemove.add(arc);
         }
     }
@@ -1114,8 +1564,8 @@ void Graph<NodeType, ArcType>::removeArc(ArcType* arc) {
         return;
     }
     arc->start->arcs.remove(arc);
-    arcs.remove(arc);
-    delete arc;
+    index.removeArc(arc);
+    allocator.destroy(arc);
 }
 
 /*
@@ -1130,7 +1580,7 @@ template <typename NodeType, typename ArcType>
 void Graph<NodeType, ArcType>::removeNode(const std::string& name) {
     // don't call getExistingNode here because it will throw an error
     // if name is not found; should just make the call have no effect
-    removeNode(nodeMap.get(name));
+    removeNode(getNode(name));
 }
 
 template <typename NodeType, typename ArcType>
@@ -1141,7 +1591,7 @@ void Graph<NodeType, ArcType>::removeNode(NodeType* node) {
         return;
     }
     Vector<ArcType*> toRemove;
-    for (ArcType* arc : arcs) {
+    for (ArcType* arc : getArcSet()) {
         if (arc->start == node || arc->finish == node) {
             toRemove.add(arc);
         }
@@ -1149,9 +1599,8 @@ void Graph<NodeType, ArcType>::removeNode(NodeType* node) {
     for (ArcType* arc : toRemove) {
         removeArc(arc);
     }
-    nodes.remove(node);
-    nodeMap.remove(node->name);
-    delete node;
+    index.removeNode(node);
+    allocator.destroy(node);
 }
 
 /*
@@ -1179,13 +1628,13 @@ bool Graph<NodeType, ArcType>::scanGraphEntry(TokenScanner& scanner) {
 #endif
         return false;
     }
-    ArcType* forward = new ArcType();
+    ArcType* forward = allocator.template create<ArcType>();
     forward->start = n1;
     forward->finish = n2;
     addArc(forward);
     ArcType* backward = nullptr;
     if (op == "-") {
-        backward = new ArcType();
+        backward = allocator.template create<ArcType>();
         backward->start = n2;
         backward->finish = n1;
         addArc(backward);
@@ -1209,7 +1658,7 @@ NodeType* Graph<NodeType, ArcType>::scanNode(TokenScanner& scanner) {
     }
     NodeType* node = getNode(token);
     if (!node) {
-        node = new NodeType();
+        node = allocator.template create<NodeType>();
         node->name = token;
         scanNodeData(scanner, node);
         addNode(node);
@@ -1226,7 +1675,7 @@ NodeType* Graph<NodeType, ArcType>::scanNode(TokenScanner& scanner) {
  */
 template <typename NodeType, typename ArcType>
 int Graph<NodeType, ArcType>::size() const {
-    return nodes.size();
+    return index.nodeCount();
 }
 
 template <typename NodeType, typename ArcType>
@@ -1260,14 +1709,14 @@ Graph<NodeType, ArcType>::operator =(const Graph& src) {
  */
 template <typename NodeType, typename ArcType>
 void Graph<NodeType, ArcType>::deepCopy(const Graph& src) {
-    for (NodeType* oldNode : src.nodes) {
-        NodeType* newNode = new NodeType();
+    for (NodeType* oldNode : src.getNodeSet()) {
+        NodeType* newNode = allocator.template create<NodeType>();
         *newNode = *oldNode;
         newNode->arcs.clear();
         addNode(newNode);
     }
-    for (ArcType* oldArc : src.arcs) {
-        ArcType* newArc = new ArcType();
+    for (ArcType* oldArc : src.getArcSet()) {
+        ArcType* newArc = allocator.template create<ArcType>();
         *newArc = *oldArc;
         newArc->start = getExistingNode(oldArc->start->name, "deepCopy");
         newArc->finish = getExistingNode(oldArc->finish->name, "deepCopy");
@@ -1360,9 +1809,8 @@ int Graph<NodeType, ArcType>::graphCompare(const Graph<NodeType, ArcType>& graph
 template <typename NodeType, typename ArcType>
 bool Graph<NodeType, ArcType>::operator ==(const Graph& graph2) const {
     // optimization: if sizes not same, graphs not equal
-    if (nodes.size() != graph2.nodes.size()
-            || arcs.size() != graph2.arcs.size()
-            || nodeMap.size() != graph2.nodeMap.size()) {
+    if (size() != graph2.size()
+            || getArcSet().size() != graph2.getArcSet().size()) {
         return false;
     }
     return graphCompare(graph2) == 0;
@@ -5,6 +5,8 @@
  * to the appropriate methods in the Platform class, which is implemented
  * separately for each architecture.
  * 
+ * @version 2026/10/16
+ * - added beginBatch/endBatch methods
  * @version 2016/11/24
  * - added setCloseOperation
  * @version 2016/11/02
@@ -220,6 +222,10 @@ std::string GWindow::regionToString(Region region) {
 }
 
 
+void GWindow::beginBatch() {
+    stanfordcpplib::getPlatform()->gwindow_beginBatch();
+}
+
 void GWindow::center() {
     setLocation(CENTER_MAGIC_VALUE, CENTER_MAGIC_VALUE);
 }
@@ -395,6 +401,10 @@ void GWindow::fillOval(double x, double y, double width, double height) {
     }
 }
 
+void GWindow::endBatch() {
+    stanfordcpplib::getPlatform()->gwindow_endBatch();
+}
+
 void GWindow::fillOval(const GRectangle & bounds) {
     if (isOpen()) {
         fillOval(bounds.getX(), bounds.getY(), bounds.getWidth(), bounds.getHeight());
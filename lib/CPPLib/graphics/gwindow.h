@@ -4,6 +4,8 @@
  * This file defines the <code>GWindow</code> class which supports
  * drawing graphical objects on the screen.
  * 
+ * @version 2026/10/16
+ * - added beginBatch/endBatch methods
  * @version 2016/11/24
  * - added setCloseOperation
  * @version 2016/11/02
@@ -176,6 +178,21 @@ public:
     void addToRegion(GLabel* gobj, Region region);
     void addToRegion(GLabel* gobj, const std::string& region);
 
+    /*
+     * Method: beginBatch
+     * Usage: gw.beginBatch();
+     * -----------------------
+     * Starts collecting the commands that graphics calls send to the Java
+     * back end instead of writing each one to the pipe as it is made.  The
+     * matching call to <code>endBatch</code> sends everything collected in a
+     * single write, so drawing a scene of thousands of objects costs one write
+     * rather than several per object.  Batches may be nested; only the
+     * outermost <code>endBatch</code> sends.  A call that waits for a result
+     * from the back end, such as creating a <code>GLabel</code>, sends what
+     * has been collected so far first.  The batch covers every window.
+     */
+    void beginBatch();
+
     /*
      * Sets the (x, y) location of the window to be the center of the screen.
      */
@@ -296,6 +313,15 @@ public:
      */
     void drawString(const std::string& text, double x, double y);
 
+    /*
+     * Method: endBatch
+     * Usage: gw.endBatch();
+     * ---------------------
+     * Ends a batch started by <code>beginBatch</code>, sending the commands
+     * collected in it if it is the outermost one.
+     */
+    void endBatch();
+
     /*
      * Method: fillOval
      * Usage: gw.fillOval(bounds);
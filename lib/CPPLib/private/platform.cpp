@@ -4,6 +4,9 @@
  * This file implements the platform interface by passing commands to
  * a Java back end that manages the display.
  * 
+ * @version 2026/10/16
+ * - added gwindow_beginBatch/endBatch to send many commands in one write
+ * - commands can be sent from more than one thread
  * @version 2016/11/25
  * - added clipboard_get/set
  * - added gtable_setCell/Column/RowFont
@@ -141,6 +144,7 @@ static int& pout(bool check = true) {
 #include <iomanip>
 #include <iostream>
 #include <ios>
+#include <mutex>
 #include <signal.h>
 #include <sstream>
 #include <string>
@@ -183,6 +187,15 @@ STATIC_VARIABLE_DECLARE_MAP_EMPTY(HashMap, std::string, GWindowData*, windowTabl
 STATIC_VARIABLE_DECLARE_MAP_EMPTY(HashMap, std::string, GObject*, sourceTable)
 STATIC_VARIABLE_DECLARE(stanfordcpplib::ConsoleStreambuf*, cinout_new_buf, nullptr)
 
+// commands held back while a batch is open; see gwindow_beginBatch
+STATIC_VARIABLE_DECLARE(int, pipeBatchDepth, 0)
+STATIC_VARIABLE_DECLARE_BLANK(std::string, pipeBatch)
+
+// guards the pipe and the batch, so that another thread (such as a renderer)
+// can send commands that wait for no result while the main thread runs;
+// recursive because a long command is sent as several putPipe calls
+STATIC_VARIABLE_DECLARE_BLANK(std::recursive_mutex, pipeMutex)
+
 #ifdef _WIN32
 STATIC_VARIABLE_DECLARE(HANDLE, rdFromJBE, nullptr)
 STATIC_VARIABLE_DECLARE(HANDLE, wrFromJBE, nullptr)
@@ -195,6 +208,7 @@ STATIC_VARIABLE_DECLARE_BLANK(pid_t, javaBackEndPid)
 
 
 /* static function prototypes */
+static void flushPipeBatch();
 static std::string getJavaCommand();
 static std::string getPipe();
 static std::string getResult(bool consumeAcks = true, bool stopOnEvent = false,
@@ -213,6 +227,7 @@ static GEvent parseWindowEvent(TokenScanner& scanner, EventType type);
 static std::string& programName();
 static void putPipe(const std::string& line);
 static void putPipeLongString(const std::string& line);
+static void writePipe(const std::string& text);
 static int scanChar(TokenScanner& scanner);
 static GDimension scanDimension(const std::string& str);
 static double scanDouble(TokenScanner& scanner);
@@ -1237,6 +1252,18 @@ void Platform::gwindow_draw(const GWindow& gw, const GObject* gobj) {
     putPipe(os.str());
 }
 
+void Platform::gwindow_beginBatch() {
+    std::lock_guard<std::recursive_mutex> lock(STATIC_VARIABLE(pipeMutex));
+    STATIC_VARIABLE(pipeBatchDepth)++;
+}
+
+void Platform::gwindow_endBatch() {
+    std::lock_guard<std::recursive_mutex> lock(STATIC_VARIABLE(pipeMutex));
+    if (STATIC_VARIABLE(pipeBatchDepth) > 0 && --STATIC_VARIABLE(pipeBatchDepth) == 0) {
+        flushPipeBatch();
+    }
+}
+
 void Platform::gwindow_drawInBackground(const GWindow& gw, const GObject* gobj) {
     std::ostringstream os;
     os << "GWindow.drawInBackground(\"" << gw.gwd << "\", \"" << gobj << "\")";
@@ -2499,6 +2526,18 @@ void setExitEnabled(bool enabled) {
 } // namespace stanfordcpplib
 
 
+/*
+ * Sends the commands held back by an open batch, if any, in a single write.
+ */
+static void flushPipeBatch() {
+    std::lock_guard<std::recursive_mutex> lock(STATIC_VARIABLE(pipeMutex));
+    if (!STATIC_VARIABLE(pipeBatch).empty()) {
+        std::string text;
+        text.swap(STATIC_VARIABLE(pipeBatch));
+        writePipe(text);
+    }
+}
+
 static void putPipeLongString(const std::string& line) {
     // break into chunks
     // precondition: line does not contain substring "LongCommand.end()"
@@ -2634,6 +2673,7 @@ static void initPipe() {
 
 // Windows implementation; see Unix implementation elsewhere in this file
 static void putPipe(const std::string& line) {
+    std::lock_guard<std::recursive_mutex> lock(STATIC_VARIABLE(pipeMutex));
     if (line.length() > STATIC_VARIABLE(PIPE_MAX_COMMAND_LENGTH)) {
         putPipeLongString(line);
         return;
@@ -2643,11 +2683,28 @@ static void putPipe(const std::string& line) {
 #ifdef PIPE_DEBUG
     fprintf(stderr, "putPipe(\"%s\")\n", line.c_str());  fflush(stderr);
 #endif // PIPE_DEBUG
+    if (STATIC_VARIABLE(pipeBatchDepth) > 0) {
+        STATIC_VARIABLE(pipeBatch) += line;
+        STATIC_VARIABLE(pipeBatch) += '\n';
+        return;
+    }
     if (!WinCheck(WriteFile(STATIC_VARIABLE(wrToJBE), line.c_str(), line.length(), &nch, nullptr))) return;
     if (!WinCheck(WriteFile(STATIC_VARIABLE(wrToJBE), "\n", 1, &nch, nullptr))) return;
     WinCheck(FlushFileBuffers(STATIC_VARIABLE(wrToJBE)));
 }
 
+// Windows implementation; see Unix implementation elsewhere in this file
+static void writePipe(const std::string& text) {
+    size_t written = 0;
+    while (written < text.length()) {
+        DWORD nch;
+        if (!WinCheck(WriteFile(STATIC_VARIABLE(wrToJBE), text.c_str() + written,
+                                text.length() - written, &nch, nullptr))) return;
+        written += nch;
+    }
+    WinCheck(FlushFileBuffers(STATIC_VARIABLE(wrToJBE)));
+}
+
 // Windows implementation; see Unix implementation elsewhere in this file
 static std::string getPipe() {
     std::string line = "";
@@ -2784,6 +2841,7 @@ static void initPipe() {
 
 // Unix implementation; see Windows implementation elsewhere in this file
 static void putPipe(const std::string& line) {
+    std::lock_guard<std::recursive_mutex> lock(STATIC_VARIABLE(pipeMutex));
     if (line.length() > STATIC_VARIABLE(PIPE_MAX_COMMAND_LENGTH)) {
         putPipeLongString(line);
         return;
@@ -2791,10 +2849,29 @@ static void putPipe(const std::string& line) {
 #ifdef PIPE_DEBUG
     fprintf(stderr, "putPipe(\"%s\")\n", line.c_str());  fflush(stderr);
 #endif
+    if (STATIC_VARIABLE(pipeBatchDepth) > 0) {
+        STATIC_VARIABLE(pipeBatch) += line;
+        STATIC_VARIABLE(pipeBatch) += '\n';
+        return;
+    }
     LinCheck(write(pout(), line.c_str(), line.length()));
     LinCheck(write(pout(), "\n", 1));
 }
 
+// Unix implementation; see Windows implementation elsewhere in this file
+static void writePipe(const std::string& text) {
+    size_t written = 0;
+    while (written < text.length()) {
+        ssize_t result = write(pout(), text.c_str() + written, text.length() - written);
+        if (result < 0 && errno == EINTR) {
+            continue;
+        } else if (result <= 0) {
+            return;   // the back end has gone away
+        }
+        written += result;
+    }
+}
+
 // Unix implementation; see Windows implementation elsewhere in this file
 static std::string getPipe() {
 #ifdef PIPE_DEBUG
@@ -2826,6 +2903,8 @@ static std::string getPipe() {
 
 static std::string getResult(bool consumeAcks, bool stopOnEvent,
                              const std::string& caller) {
+    // a command that waits for its result must not sit in an open batch
+    flushPipeBatch();
     while (true) {
 #ifdef PIPE_DEBUG
         fprintf(stderr, "getResult(): calling getPipe() ...\n");  fflush(stderr);
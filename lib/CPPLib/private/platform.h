@@ -5,6 +5,8 @@
  * the platform-specific parts of the StanfordCPPLib package.  This file is
  * logically part of the implementation and is not interesting to clients.
  *
+ * @version 2026/10/16
+ * - added gwindow_beginBatch/endBatch
  * @version 2016/11/25
  * - added clipboard_get/set
  * - added gtable_setCell/Column/RowFont
@@ -284,6 +286,7 @@ public:
     void gtimer_stop(const GTimer& timer);
 
     void gwindow_addToRegion(const GWindow& gw, GObject* gobj, const std::string& region);
+    void gwindow_beginBatch();
     void gwindow_clear(const GWindow& gw);
     void gwindow_clearCanvas(const GWindow& gw);
     void gwindow_close(const GWindow& gw);
@@ -292,6 +295,7 @@ public:
     void gwindow_delete(const GWindow& gw);
     void gwindow_draw(const GWindow& gw, const GObject* gobj);
     void gwindow_drawInBackground(const GWindow& gw, const GObject* gobj);
+    void gwindow_endBatch();
     void gwindow_exitGraphics(bool abortBlockedConsoleIO = true);
     GDimension gwindow_getCanvasSize(const GWindow& gw);
     GDimension gwindow_getContentPaneSize(const GWindow& gw);
@@ -0,0 +1,110 @@
+/**
+ * @brief This file implements the renderer thread that draws published node colors.
+ * @headerfile AsyncRenderer.h
+ * @version 2026/10/16
+ */
+
+#include "AsyncRenderer.h"
+#include "error.h"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+    /*
+     * The number of events the ring holds (2 MB of them): enough for a search
+     * publishing an event every 100 ns to run on while a 25 ms frame is drawn.
+     */
+    const int RING_CAPACITY = 1 << 18;
+
+    /* How long the renderer sleeps between drains of the ring. */
+    const std::chrono::milliseconds DRAIN_INTERVAL(1);
+}
+
+AsyncRenderer::AsyncRenderer(int nodeCount, FrameDrawer drawFrame)
+    : drawFrame(drawFrame),
+      ring(RING_CAPACITY),
+      latest(nodeCount, Color::WHITE),
+      changed(nodeCount, false) {
+}
+
+AsyncRenderer::~AsyncRenderer() {
+    if (isRunning()) {
+        stop();
+    }
+}
+
+void AsyncRenderer::start(int frameIntervalMS) {
+    if (isRunning()) {
+        error("AsyncRenderer::start: the renderer is already running");
+    }
+    stopping = false;
+    dropped = false;
+    drawn = 0;
+    skipped = 0;
+    renderer = std::thread(&AsyncRenderer::run, this, std::max(frameIntervalMS, 0));
+}
+
+bool AsyncRenderer::stop() {
+    if (!isRunning()) {
+        error("AsyncRenderer::stop: the renderer is not running");
+    }
+    stopping = true;
+    renderer.join();
+    return dropped;
+}
+
+/*
+ * Frames are due on a fixed schedule. When the renderer falls behind it moves
+ * the schedule forward past the frames it missed instead of drawing them late.
+ */
+void AsyncRenderer::run(int frameIntervalMS) {
+    typedef std::chrono::steady_clock Clock;
+    const std::chrono::milliseconds interval(frameIntervalMS);
+    Clock::time_point nextFrame = Clock::now() + interval;
+    while (!stopping) {
+        drainRing();
+        Clock::time_point now = Clock::now();
+        if (frameIntervalMS > 0 && now >= nextFrame) {
+            drawPending();
+            now = Clock::now();
+            nextFrame += interval;
+            if (nextFrame <= now) {
+                int missed = static_cast<int>((now - nextFrame) / interval) + 1;
+                skipped += missed;
+                nextFrame += missed * interval;
+            }
+        }
+        std::this_thread::sleep_for(frameIntervalMS > 0
+                ? std::min<Clock::duration>(DRAIN_INTERVAL, nextFrame - now)
+                : Clock::duration(DRAIN_INTERVAL));
+    }
+
+    /* The publisher has finished, so this drain sees every event it got in. */
+    drainRing();
+    drawPending();
+}
+
+void AsyncRenderer::drainRing() {
+    ring.drain([this](const ColorEvent& event) {
+        latest[event.node] = event.color;
+        if (!changed[event.node]) {
+            changed[event.node] = true;
+            pending.push_back(event.node);
+        }
+    });
+}
+
+void AsyncRenderer::drawPending() {
+    if (pending.empty()) {
+        return;
+    }
+    frame.clear();
+    for (int node : pending) {
+        ColorEvent event = { node, latest[node] };
+        frame.push_back(event);
+        changed[node] = false;
+    }
+    pending.clear();
+    drawFrame(frame);
+    drawn++;
+}
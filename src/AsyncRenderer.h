@@ -0,0 +1,111 @@
+/**
+ * @brief This file declares a renderer thread that draws the node colors a
+ * search publishes, at its own pace, without holding the search up.
+ * @class AsyncRenderer.cpp
+ * @version 2026/10/16
+ */
+
+#ifndef _asyncrenderer_h
+#define _asyncrenderer_h
+
+#include "Color.h"
+#include "EventRing.h"
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+/* A node taking on a color, as published by a search. */
+struct ColorEvent {
+    int node;
+    Color color;
+};
+
+/*
+ * Moves the drawing of node colors off the thread that runs the search.
+ *
+ * The search thread publishes (node, color) events into an EventRing, which
+ * costs a few stores and never blocks. A renderer thread drains the ring about
+ * once a millisecond and keeps only the latest color of each node, so a node
+ * that turns yellow and then green before the next frame is drawn once. Every
+ * frame interval it hands the nodes that changed since the last frame to the
+ * frame drawer. If drawing a frame takes longer than the interval, the frames
+ * that fell due meanwhile are skipped rather than drawn late, so a slow display
+ * only makes the animation coarser; the search never waits for it.
+ *
+ * If the search publishes faster than the renderer drains, so that the ring
+ * fills up, the events that do not fit are dropped and stop() reports it; the
+ * caller then has to redraw the final colors itself.
+ */
+class AsyncRenderer {
+public:
+    /*
+     * Draws one frame: the nodes that changed since the last one, each with its
+     * latest color. Runs on the renderer thread.
+     */
+    typedef std::function<void(const std::vector<ColorEvent>& frame)> FrameDrawer;
+
+    /*
+     * Creates a renderer for graphs with the given number of nodes that draws
+     * frames with the given function. The thread is not started yet.
+     */
+    AsyncRenderer(int nodeCount, FrameDrawer drawFrame);
+
+    /* Stops the thread if it is running. */
+    ~AsyncRenderer();
+
+    AsyncRenderer(const AsyncRenderer&) = delete;
+    AsyncRenderer& operator =(const AsyncRenderer&) = delete;
+
+    /*
+     * Starts the renderer thread, which draws a frame every frameIntervalMS
+     * milliseconds while there are changes to show. With an interval of 0 it
+     * draws nothing until stop() draws the final frame.
+     */
+    void start(int frameIntervalMS);
+
+    /*
+     * Draws what is still pending as a final frame and stops the thread. Returns
+     * whether any event was dropped because the ring was full.
+     */
+    bool stop();
+
+    /* Returns whether the thread has been started and not yet stopped. */
+    bool isRunning() const { return renderer.joinable(); }
+
+    /*
+     * Publishes a node's new color. Only one thread may publish, and only while
+     * the renderer is running.
+     */
+    void publish(int node, Color color) {
+        ColorEvent event = { node, color };
+        if (!ring.push(event)) {
+            dropped = true;
+        }
+    }
+
+    /* Returns the number of frames drawn and skipped since the last start(). */
+    int framesDrawn() const { return drawn; }
+    int framesSkipped() const { return skipped; }
+
+private:
+    void run(int frameIntervalMS);
+    void drainRing();
+    void drawPending();
+
+    FrameDrawer drawFrame;
+    EventRing<ColorEvent> ring;
+    std::thread renderer;
+    std::atomic<bool> stopping{false};
+    bool dropped = false;                    // written by the publishing thread only
+
+    /* The renderer thread's state. */
+    std::vector<Color> latest;               // latest color of each changed node
+    std::vector<bool> changed;               // whether a node is in pending
+    std::vector<int> pending;                // nodes changed since the last frame
+    std::vector<ColorEvent> frame;
+    int drawn = 0;
+    int skipped = 0;
+};
+
+#endif // _asyncrenderer_h
@@ -0,0 +1,159 @@
+/**
+ * @brief This file implements the batch query engine.
+ * @headerfile BatchQueryEngine.h
+ * @version 2026/10/16
+ */
+
+#include "BatchQueryEngine.h"
+#include "error.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+/* Private constants only needed in this file. */
+namespace {
+    /*
+     * The number of queries a worker claims at a time. Claiming a few at once keeps
+     * the workers from contending on the shared counter, while staying small enough
+     * that a batch of long queries is still spread evenly.
+     */
+    const int QUERIES_PER_CLAIM = 16;
+}
+
+BatchQueryEngine::Worker::Worker(int nodeCount, size_t idaTableBytes)
+    : forward(nodeCount),
+      backward(nodeCount),
+      frontier(nodeCount),
+      depthFirst(nodeCount, idaTableBytes) {
+    // empty
+}
+
+BatchQueryEngine::BatchQueryEngine(const RoadGraph& graph, int threadCount,
+                                   size_t idaTableBytes)
+    : graph(graph),
+      idaTableBytes(idaTableBytes),
+      workerNodeCount(graph.compile().nodeCount()),
+      builtVersion(graph.version()) {
+    if (threadCount <= 0) {
+        threadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    for (int i = 0; i < threadCount; i++) {
+        workers.emplace_back(new Worker(workerNodeCount, idaTableBytes));
+    }
+}
+
+BatchQueryEngine::~BatchQueryEngine() {
+    // empty; the workers are released by their unique_ptrs
+}
+
+/*
+ * A new version may come with a new hierarchy even when the snapshot is kept,
+ * as after RoadGraph::setEdgeCost, so the hierarchy queries always go. The
+ * workspaces are indexed by node ID and only need replacing if the number of
+ * nodes has changed.
+ */
+void BatchQueryEngine::refresh() {
+    if (graph.version() == builtVersion) {
+        return;
+    }
+    int nodeCount = graph.compile().nodeCount();
+    for (auto& worker : workers) {
+        if (nodeCount != workerNodeCount) {
+            worker.reset(new Worker(nodeCount, idaTableBytes));
+        } else {
+            worker->hierarchyQuery.reset();
+        }
+    }
+    workerNodeCount = nodeCount;
+    builtVersion = graph.version();
+}
+
+/*
+ * Everything the workers share is built up front on the calling thread: the CSR
+ * snapshot, the hierarchy, the crow-fly bound and the queries' node IDs. After that
+ * the workers only read shared state, and the calling thread works through the
+ * batch alongside them.
+ */
+std::vector<RouteResult> BatchQueryEngine::run(const std::vector<RouteQuery>& queries,
+                                               BatchAlgorithm algorithm,
+                                               const Heuristic* heuristic) {
+    refresh();
+    const CompiledRoadGraph& compiled = graph.compile();
+    for (const RouteQuery& query : queries) {
+        if (compiled.idOf(query.source) == -1 || compiled.idOf(query.target) == -1) {
+            error("BatchQueryEngine::run: query node is not in the graph");
+        }
+    }
+    if (algorithm == BatchAlgorithm::CONTRACTION_HIERARCHY) {
+        const ContractionHierarchy& hierarchy = graph.hierarchy();
+        for (auto& worker : workers) {
+            if (!worker->hierarchyQuery) {
+                worker->hierarchyQuery.reset(new ContractionHierarchyQuery(hierarchy));
+            }
+        }
+    }
+    CrowFlyHeuristic crowFly(graph);
+    const Heuristic& guide = heuristic ? *heuristic : crowFly;
+
+    std::vector<RouteResult> results(queries.size());
+    int total = static_cast<int>(queries.size());
+    std::atomic<int> nextQuery(0);
+    auto work = [&](Worker& worker) {
+        while (true) {
+            int first = nextQuery.fetch_add(QUERIES_PER_CLAIM, std::memory_order_relaxed);
+            if (first >= total) {
+                return;
+            }
+            int last = std::min(first + QUERIES_PER_CLAIM, total);
+            for (int i = first; i < last; i++) {
+                answer(worker, queries[i], algorithm, guide, results[i]);
+            }
+        }
+    };
+
+    int helpers = std::min(threadCount(), (total + QUERIES_PER_CLAIM - 1) / QUERIES_PER_CLAIM) - 1;
+    std::vector<std::thread> threads;
+    for (int i = 1; i <= helpers; i++) {
+        threads.emplace_back(work, std::ref(*workers[i]));
+    }
+    work(*workers[0]);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    return results;
+}
+
+void BatchQueryEngine::answer(Worker& worker, const RouteQuery& query, BatchAlgorithm algorithm,
+                              const Heuristic& heuristic, RouteResult& result) const {
+    const CompiledRoadGraph& compiled = graph.compile();
+    int source = compiled.idOf(query.source);
+    int target = compiled.idOf(query.target);
+
+    switch (algorithm) {
+    case BatchAlgorithm::A_STAR:
+        result.cost = a_star(compiled, source, target, heuristic, worker.forward, worker.path);
+        break;
+    case BatchAlgorithm::BIDIRECTIONAL_A_STAR:
+        result.cost = bidirectional_a_star(compiled, source, target, heuristic,
+                                           worker.forward, worker.backward, worker.path);
+        break;
+    case BatchAlgorithm::PERIPHERY_SWEEP:
+        result.cost = periphery_sweep(compiled, source, target, heuristic,
+                                      worker.forward, worker.frontier, worker.path);
+        break;
+    case BatchAlgorithm::IDA_STAR:
+        result.cost = ida_star(compiled, source, target, heuristic, worker.depthFirst,
+                               worker.path);
+        break;
+    case BatchAlgorithm::CONTRACTION_HIERARCHY:
+        result.cost = worker.hierarchyQuery->run(source, target);
+        worker.hierarchyQuery->unpackPath(worker.path);
+        break;
+    }
+
+    result.path.clear();
+    result.path.ensureCapacity(static_cast<int>(worker.path.size()));
+    for (int id : worker.path) {
+        result.path.add(compiled.nodeAt(id));
+    }
+}
@@ -0,0 +1,110 @@
+/**
+ * @brief This file declares the batch query engine, which answers many point-to-point
+ * queries on one map in parallel.
+ * @class BatchQueryEngine.cpp
+ * @version 2026/10/16
+ */
+
+#ifndef _batchqueryengine_h
+#define _batchqueryengine_h
+
+#include "pathfinder.h"
+#include "ContractionHierarchy.h"
+#include <cmath>
+#include <memory>
+#include <vector>
+
+/* The searches a batch can be answered with. */
+enum class BatchAlgorithm {
+    A_STAR,
+    BIDIRECTIONAL_A_STAR,
+    PERIPHERY_SWEEP,
+    IDA_STAR,
+    CONTRACTION_HIERARCHY
+};
+
+/* One point-to-point query of a batch. */
+struct RouteQuery {
+    RoadNode* source;
+    RoadNode* target;
+};
+
+/* The answer to one query: the cheapest path and its cost (INFINITY and an empty
+ * path if the target cannot be reached).
+ */
+struct RouteResult {
+    Path path;
+    double cost = INFINITY;
+};
+
+/*
+ * Fans a batch of queries out over a fixed number of worker threads that all
+ * search the same read-only compiled graph.
+ *
+ * Each worker owns its search workspaces and keeps them from one query, and one
+ * batch, to the next. Workers claim queries in small chunks from a shared atomic
+ * counter and write each answer straight into its slot of the result vector, so
+ * the only synchronization is that counter and the final join. The searches do
+ * not color nodes, which keeps the GUI observers out of the worker threads.
+ *
+ * The engine follows changes to the graph: when a batch starts and the graph's
+ * version (see RoadGraph::version) has moved on since the last one, the workers
+ * drop their hierarchy queries, which may refer to a hierarchy the graph has
+ * since replaced, and their workspaces too if the snapshot now has a different
+ * number of nodes. The graph must not change while a batch is running.
+ */
+class BatchQueryEngine {
+public:
+    /*
+     * Prepares an engine for the given graph. A thread count of 0 uses one
+     * worker per hardware thread. Each worker's IDA* transposition table is
+     * capped at idaTableBytes bytes.
+     */
+    explicit BatchQueryEngine(const RoadGraph& graph, int threadCount = 0,
+                              size_t idaTableBytes = DepthFirstWorkspace::DEFAULT_TABLE_BYTES);
+    ~BatchQueryEngine();
+
+    /* Returns the number of worker threads a batch is spread over. */
+    int threadCount() const { return static_cast<int>(workers.size()); }
+
+    /*
+     * Answers every query with the given algorithm and returns the answers in
+     * the order of the queries. The informed searches are guided by the given
+     * heuristic, or by the crow-fly bound if it is nullptr; the heuristic must be
+     * safe to call from several threads at once, which the read-only heuristics
+     * in Heuristic.h and LandmarkHeuristic.h are.
+     *
+     * Throws an ErrorException if a query names a node that is not in the graph.
+     */
+    std::vector<RouteResult> run(const std::vector<RouteQuery>& queries,
+                                 BatchAlgorithm algorithm,
+                                 const Heuristic* heuristic = nullptr);
+
+private:
+    /* The search state one worker thread reuses between queries. */
+    struct Worker {
+        Worker(int nodeCount, size_t idaTableBytes);
+
+        SearchWorkspace forward;
+        SearchWorkspace backward;
+        SweepFrontier frontier;
+        DepthFirstWorkspace depthFirst;
+        std::unique_ptr<ContractionHierarchyQuery> hierarchyQuery;
+        std::vector<int> path;
+    };
+
+    const RoadGraph& graph;
+    size_t idaTableBytes;
+    std::vector<std::unique_ptr<Worker>> workers;
+    int workerNodeCount;     // the number of nodes the workspaces are sized for
+    unsigned builtVersion;   // the graph version the workers are up to date with
+
+    /* Brings the workers up to date with the graph, if it has changed. */
+    void refresh();
+
+    /* Answers a single query on the given worker. */
+    void answer(Worker& worker, const RouteQuery& query, BatchAlgorithm algorithm,
+                const Heuristic& heuristic, RouteResult& result) const;
+};
+
+#endif // _batchqueryengine_h
@@ -0,0 +1,171 @@
+/**
+ * @brief This file implements the compiled road graph snapshot.
+ * @headerfile CompiledRoadGraph.h
+ * @version 2026/10/16
+ */
+
+#include "CompiledRoadGraph.h"
+#include "RoadGraph.h"
+#include "RoadMapBinary.h"
+#include "error.h"
+#include <cmath>
+
+/*
+ * Assigns dense IDs in node order, then lays out each node's outgoing arcs
+ * one after another. The arcs of a node are visited in the order the Graph
+ * stores them, which is by destination name.
+ */
+CompiledRoadGraph::CompiledRoadGraph(const Graph<RoadNode, RoadEdge>& data) {
+    numNodes = data.size();
+    numArcs = 0;
+
+    nodes.reserve(numNodes);
+    ids.reserve(numNodes);
+    xStorage.reserve(numNodes);
+    yStorage.reserve(numNodes);
+    for (RoadNode* node : data) {
+        ids[node] = static_cast<int>(nodes.size());
+        nodes.push_back(node);
+        Point p = node->location();
+        xStorage.push_back(p.getX());
+        yStorage.push_back(p.getY());
+        numArcs += data.getArcSet(node).size();   // the graph's own arc set may be rebuilt
+    }
+
+    arcOffsetStorage.reserve(numNodes + 1);
+    arcTargetStorage.reserve(numArcs);
+    arcCostStorage.reserve(numArcs);
+    arcEdges.reserve(numArcs);
+    arcOffsetStorage.push_back(0);
+    for (RoadNode* node : nodes) {
+        for (RoadEdge* edge : data.getArcSet(node)) {
+            arcTargetStorage.push_back(ids[edge->to()]);
+            arcCostStorage.push_back(edge->cost());
+            arcEdges.push_back(edge);
+        }
+        arcOffsetStorage.push_back(static_cast<int>(arcTargetStorage.size()));
+    }
+    for (RoadEdge* edge : arcEdges) {
+        if (edge->travelTimeProfile() != -1) {
+            arcProfiles.reserve(numArcs);
+            for (RoadEdge* profiled : arcEdges) {
+                arcProfiles.push_back(profiled->travelTimeProfile());
+            }
+            break;
+        }
+    }
+    bool metric2 = numArcs > 0;
+    for (RoadEdge* edge : arcEdges) {
+        metric2 = metric2 && edge->secondMetric() >= 0;
+    }
+    if (metric2) {
+        arcMetric2Storage.reserve(numArcs);
+        for (RoadEdge* edge : arcEdges) {
+            arcMetric2Storage.push_back(edge->secondMetric());
+        }
+        inArcMetric2Storage.resize(numArcs);
+    }
+
+    /* Bucket the same arcs by their destination to get the reverse adjacency. */
+    inArcOffsetStorage.assign(numNodes + 1, 0);
+    for (int target : arcTargetStorage) {
+        inArcOffsetStorage[target + 1]++;
+    }
+    for (int id = 0; id < numNodes; id++) {
+        inArcOffsetStorage[id + 1] += inArcOffsetStorage[id];
+    }
+    inArcSourceStorage.resize(arcTargetStorage.size());
+    inArcCostStorage.resize(arcTargetStorage.size());
+    inArcForwardStorage.resize(arcTargetStorage.size());
+    std::vector<int> next(inArcOffsetStorage.begin(), inArcOffsetStorage.end() - 1);
+    for (int id = 0; id < numNodes; id++) {
+        for (int arc = arcOffsetStorage[id]; arc < arcOffsetStorage[id + 1]; arc++) {
+            int slot = next[arcTargetStorage[arc]]++;
+            inArcSourceStorage[slot] = id;
+            inArcCostStorage[slot] = arcCostStorage[arc];
+            inArcForwardStorage[slot] = arc;
+            if (metric2) {
+                inArcMetric2Storage[slot] = arcMetric2Storage[arc];
+            }
+        }
+    }
+
+    arcOffsets = arcOffsetStorage.data();
+    arcTargets = arcTargetStorage.data();
+    arcCosts = arcCostStorage.data();
+    inArcOffsets = inArcOffsetStorage.data();
+    inArcSources = inArcSourceStorage.data();
+    inArcCosts = inArcCostStorage.data();
+    inArcForwards = inArcForwardStorage.data();
+    if (metric2) {
+        arcMetric2 = arcMetric2Storage.data();
+        inArcMetric2 = inArcMetric2Storage.data();
+    }
+    xs = xStorage.data();
+    ys = yStorage.data();
+}
+
+CompiledRoadGraph::CompiledRoadGraph(const MappedRoadMap& map) {
+    if (!map.isOpen()) {
+        error("CompiledRoadGraph::CompiledRoadGraph: the binary map is not open");
+    }
+    numNodes = map.nodeCount();
+    numArcs = map.arcCount();
+    arcOffsets = map.arrays.arcOffsets;
+    arcTargets = map.arrays.arcTargets;
+    arcCosts = map.arrays.arcCosts;
+    inArcOffsets = map.arrays.inArcOffsets;
+    inArcSources = map.arrays.inArcSources;
+    inArcCosts = map.arrays.inArcCosts;
+    inArcForwards = map.arrays.inArcForwards;
+    arcMetric2 = map.arrays.arcMetric2;
+    inArcMetric2 = map.arrays.inArcMetric2;
+    xs = map.arrays.xs;
+    ys = map.arrays.ys;
+}
+
+int CompiledRoadGraph::idOf(RoadNode* node) const {
+    auto found = ids.find(node);
+    return found == ids.end() ? -1 : found->second;
+}
+
+int CompiledRoadGraph::arcOf(RoadEdge* edge) const {
+    int from = idOf(edge->from());
+    if (from == -1) {
+        return -1;
+    }
+    for (int arc = firstArc(from); arc < endArc(from); arc++) {
+        if (arcEdges[arc] == edge) {
+            return arc;
+        }
+    }
+    return -1;
+}
+
+std::vector<double> CompiledRoadGraph::secondMetric() const {
+    return hasSecondMetric() ? std::vector<double>(arcMetric2, arcMetric2 + numArcs)
+                             : std::vector<double>();
+}
+
+/* The reverse copy of the arc is found among the arcs entering its target. */
+void CompiledRoadGraph::setArcCost(int arc, double cost) {
+    if (arcCostStorage.empty()) {
+        error("CompiledRoadGraph::setArcCost: a mapped snapshot is read-only");
+    }
+    arcCostStorage[arc] = cost;
+    int target = arcTargets[arc];
+    for (int inArc = firstInArc(target); inArc < endInArc(target); inArc++) {
+        if (inArcForwards[inArc] == arc) {
+            inArcCostStorage[inArc] = cost;
+            return;
+        }
+    }
+}
+
+double CompiledRoadGraph::crowFlyDistanceBetween(int start, int end) const {
+    double dx = xs[start] - xs[end];
+    double dy = ys[start] - ys[end];
+
+    /* The -1 matches pointDistance in RoadGraph.cpp. */
+    return fmax(sqrt(dx * dx + dy * dy), 0) - 1;
+}
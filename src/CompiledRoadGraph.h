@@ -0,0 +1,168 @@
+/**
+ * @brief This file declares a compiled, read-only snapshot of a road graph that
+ * the search algorithms use for adjacency.
+ * @class CompiledRoadGraph.cpp
+ * @version 2026/10/16
+ */
+
+#ifndef _compiledroadgraph_h
+#define _compiledroadgraph_h
+
+#include "graph.h"
+#include <unordered_map>
+#include <vector>
+
+class MappedRoadMap;
+class RoadNode;
+class RoadEdge;
+
+/*
+ * A compressed-sparse-row (CSR) snapshot of a Graph<RoadNode, RoadEdge>.
+ *
+ * Every node is given a dense integer ID in [0, nodeCount()), in the same
+ * name order that the Graph iterates its nodes. The arcs leaving node v occupy
+ * the contiguous index range [firstArc(v), endArc(v)), and the target, cost and
+ * original edge of each arc are stored in parallel arrays. Node coordinates are
+ * stored the same way, so a search can expand a node and evaluate its heuristic
+ * without allocating or chasing pointers.
+ *
+ * The reverse adjacency is stored the same way: the arcs entering node v occupy
+ * [firstInArc(v), endInArc(v)), which lets a backward search walk a directed
+ * graph against the direction of its arcs.
+ *
+ * The snapshot does not track later changes to the graph it was built from,
+ * except for arc costs changed through RoadGraph::setEdgeCost, which keep the
+ * layout and update the snapshot in place.
+ *
+ * A snapshot can also view the arrays of a memory-mapped binary map in place
+ * (see RoadMapBinary.h). Such a snapshot has no RoadNode or RoadEdge objects
+ * behind it: nodeAt and arcEdge return nullptr and idOf returns -1, and callers
+ * work with node IDs and the names stored in the map instead.
+ */
+class CompiledRoadGraph {
+public:
+    /* Builds a snapshot of the given graph. */
+    explicit CompiledRoadGraph(const Graph<RoadNode, RoadEdge>& data);
+
+    /*
+     * Views the arrays of a mapped binary map without copying them. The map must
+     * stay open for as long as the snapshot is used.
+     */
+    explicit CompiledRoadGraph(const MappedRoadMap& map);
+
+    /* The accessors point into the snapshot's own storage, so it cannot be copied. */
+    CompiledRoadGraph(const CompiledRoadGraph&) = delete;
+    CompiledRoadGraph& operator =(const CompiledRoadGraph&) = delete;
+
+    /* Returns the number of nodes / arcs in the snapshot. */
+    int nodeCount() const { return numNodes; }
+    int arcCount() const { return numArcs; }
+
+    /* Returns the dense ID of the given node, or -1 if it is not in the snapshot. */
+    int idOf(RoadNode* node) const;
+
+    /* Returns the node with the given dense ID, or nullptr for a mapped snapshot. */
+    RoadNode* nodeAt(int id) const { return nodes.empty() ? nullptr : nodes[id]; }
+
+    /* Returns the index range [firstArc(id), endArc(id)) of the arcs leaving a node. */
+    int firstArc(int id) const { return arcOffsets[id]; }
+    int endArc(int id) const { return arcOffsets[id + 1]; }
+
+    /* Returns the node ID an arc points to, the cost of the arc, and the edge it
+     * was compiled from.
+     */
+    int arcTarget(int arc) const { return arcTargets[arc]; }
+    double arcCost(int arc) const { return arcCosts[arc]; }
+    RoadEdge* arcEdge(int arc) const { return arcEdges.empty() ? nullptr : arcEdges[arc]; }
+
+    /* Returns the index of the arc compiled from the given edge, or -1 if there is none. */
+    int arcOf(RoadEdge* edge) const;
+
+    /*
+     * Changes the cost of an arc in the forward and reverse arrays alike. Only a
+     * snapshot built from a Graph can change; RoadGraph::setEdgeCost calls this
+     * so that the edge and its arc agree.
+     */
+    void setArcCost(int arc, double cost);
+
+    /*
+     * Returns the travel time profile of an arc's edge (see TravelTimeProfiles.h),
+     * or -1 if its cost is fixed. Mapped snapshots have no profiles.
+     */
+    int arcProfile(int arc) const { return arcProfiles.empty() ? -1 : arcProfiles[arc]; }
+
+    /* Returns whether any arc has a travel time profile. */
+    bool hasTravelTimeProfiles() const { return !arcProfiles.empty(); }
+
+    /*
+     * Returns whether the arcs have a second metric (see RoadEdge::secondMetric),
+     * and the second metric of an arc and of an entering arc. A graph has one if
+     * every edge has, and then the snapshot keeps it as it was when compiled; a
+     * view of a binary map has one if the map stores it.
+     */
+    bool hasSecondMetric() const { return arcMetric2 != nullptr; }
+    double arcSecondMetric(int arc) const { return arcMetric2[arc]; }
+    double inArcSecondMetric(int inArc) const { return inArcMetric2[inArc]; }
+
+    /*
+     * Returns the second metric of every arc, indexed like the arcs, as
+     * CustomizableHierarchy::customize takes it, or an empty vector if the arcs
+     * have none.
+     */
+    std::vector<double> secondMetric() const;
+
+    /* Returns the index range [firstInArc(id), endInArc(id)) of the arcs entering a node. */
+    int firstInArc(int id) const { return inArcOffsets[id]; }
+    int endInArc(int id) const { return inArcOffsets[id + 1]; }
+
+    /* Returns the node ID an entering arc comes from, its cost, and its index
+     * in the forward arc arrays.
+     */
+    int inArcSource(int inArc) const { return inArcSources[inArc]; }
+    double inArcCost(int inArc) const { return inArcCosts[inArc]; }
+    int inArcForward(int inArc) const { return inArcForwards[inArc]; }
+
+    /* Returns the on-screen coordinates of a node. */
+    double x(int id) const { return xs[id]; }
+    double y(int id) const { return ys[id]; }
+
+    /*
+     * The geodesic distance between the two nodes, computed exactly as
+     * RoadGraph::crowFlyDistanceBetween does but from the coordinate arrays.
+     */
+    double crowFlyDistanceBetween(int start, int end) const;
+
+private:
+    /* The arrays the accessors read, in this snapshot's storage or in a mapped file. */
+    int numNodes = 0;
+    int numArcs = 0;
+    const int* arcOffsets = nullptr;        // nodeCount() + 1 offsets into the arc arrays
+    const int* arcTargets = nullptr;
+    const double* arcCosts = nullptr;
+    const int* inArcOffsets = nullptr;      // nodeCount() + 1 offsets into the in-arc arrays
+    const int* inArcSources = nullptr;
+    const double* inArcCosts = nullptr;
+    const int* inArcForwards = nullptr;
+    const double* arcMetric2 = nullptr;     // nullptr if the arcs have no second metric
+    const double* inArcMetric2 = nullptr;
+    const double* xs = nullptr;
+    const double* ys = nullptr;
+
+    /* The storage of a snapshot built from a Graph; empty for a mapped snapshot. */
+    std::vector<RoadNode*> nodes;           // node for each ID
+    std::unordered_map<RoadNode*, int> ids; // ID for each node
+    std::vector<RoadEdge*> arcEdges;
+    std::vector<int> arcProfiles;           // empty if no arc has a profile
+    std::vector<int> arcOffsetStorage;
+    std::vector<int> arcTargetStorage;
+    std::vector<double> arcCostStorage;
+    std::vector<int> inArcOffsetStorage;
+    std::vector<int> inArcSourceStorage;
+    std::vector<double> inArcCostStorage;
+    std::vector<int> inArcForwardStorage;
+    std::vector<double> arcMetric2Storage;  // empty if the arcs have no second metric
+    std::vector<double> inArcMetric2Storage;
+    std::vector<double> xStorage, yStorage;
+};
+
+#endif // _compiledroadgraph_h
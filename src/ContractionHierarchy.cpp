@@ -0,0 +1,394 @@
+/**
+ * @brief This file implements the Contraction Hierarchies preprocessing and query
+ * engine.
+ * @headerfile ContractionHierarchy.h
+ * @version 2026/10/16
+ */
+
+#include "ContractionHierarchy.h"
+#include <cmath>
+
+/* Private helper types and functions only needed in this file. */
+namespace {
+    /*
+     * The most nodes a witness search may settle before giving up. Giving up
+     * early only ever adds a shortcut that was not strictly needed, so this
+     * trades a slightly larger hierarchy for faster preprocessing.
+     */
+    const int WITNESS_SETTLE_LIMIT = 500;
+
+    /* An arc of the graph that remains while nodes are being contracted. */
+    struct Edge {
+        int other;
+        double cost;
+        int middle;
+    };
+
+    /*
+     * The working state of the contraction: the remaining graph, stored as an
+     * out-list and an in-list per node, plus the scratch space for witness
+     * searches.
+     */
+    class Contractor {
+    public:
+        explicit Contractor(const CompiledRoadGraph& graph)
+            : out(graph.nodeCount()),
+              in(graph.nodeCount()),
+              contractedNeighbors(graph.nodeCount(), 0),
+              witnessDistance(graph.nodeCount(), INFINITY),
+              witnessHeap(graph.nodeCount()) {
+            for (int v = 0; v < graph.nodeCount(); v++) {
+                for (int arc = graph.firstArc(v); arc < graph.endArc(v); arc++) {
+                    int w = graph.arcTarget(arc);
+                    if (w != v) {
+                        addEdge(v, w, graph.arcCost(arc), -1);
+                    }
+                }
+            }
+        }
+
+        /* Returns the edge difference based priority of contracting v now. */
+        int priority(int v) {
+            int added = contract(v, /* apply */ false);
+            int removed = static_cast<int>(in[v].size() + out[v].size());
+            return added - removed + contractedNeighbors[v];
+        }
+
+        /*
+         * Adds the shortcuts needed to remove v and returns how many there are.
+         * If apply is true, v is also removed from the remaining graph.
+         */
+        int contract(int v, bool apply) {
+            int needed = 0;
+            for (const Edge& incoming : in[v]) {
+                double limit = 0;
+                for (const Edge& outgoing : out[v]) {
+                    limit = fmax(limit, incoming.cost + outgoing.cost);
+                }
+                witnessSearch(incoming.other, v, limit);
+                for (const Edge& outgoing : out[v]) {
+                    if (outgoing.other == incoming.other) {
+                        continue;
+                    }
+                    double viaCost = incoming.cost + outgoing.cost;
+                    if (witnessDistance[outgoing.other] > viaCost) {
+                        needed++;
+                        if (apply) {
+                            addEdge(incoming.other, outgoing.other, viaCost, v);
+                        }
+                    }
+                }
+                clearWitnessSearch();
+            }
+            if (apply) {
+                for (const Edge& incoming : in[v]) {
+                    removeEdge(out[incoming.other], v);
+                    contractedNeighbors[incoming.other]++;
+                }
+                for (const Edge& outgoing : out[v]) {
+                    removeEdge(in[outgoing.other], v);
+                    contractedNeighbors[outgoing.other]++;
+                }
+            }
+            return needed;
+        }
+
+        std::vector<std::vector<Edge>> out, in;
+
+    private:
+        std::vector<int> contractedNeighbors;
+        std::vector<double> witnessDistance;
+        std::vector<int> witnessTouched;
+        IndexedHeap witnessHeap;
+
+        /* Adds the arc from -> to, or lowers the cost of the one already there. */
+        void addEdge(int from, int to, double cost, int middle) {
+            for (Edge& edge : out[from]) {
+                if (edge.other == to) {
+                    if (cost < edge.cost) {
+                        edge.cost = cost;
+                        edge.middle = middle;
+                        for (Edge& reverse : in[to]) {
+                            if (reverse.other == from) {
+                                reverse.cost = cost;
+                                reverse.middle = middle;
+                            }
+                        }
+                    }
+                    return;
+                }
+            }
+            out[from].push_back({to, cost, middle});
+            in[to].push_back({from, cost, middle});
+        }
+
+        static void removeEdge(std::vector<Edge>& edges, int other) {
+            for (size_t i = 0; i < edges.size(); i++) {
+                if (edges[i].other == other) {
+                    edges[i] = edges.back();
+                    edges.pop_back();
+                    return;
+                }
+            }
+        }
+
+        /*
+         * Runs a Dijkstra search from start over the remaining graph without
+         * passing through skip, stopping past the given cost or settle limit.
+         */
+        void witnessSearch(int start, int skip, double limit) {
+            witnessDistance[start] = 0;
+            witnessTouched.push_back(start);
+            witnessHeap.pushOrDecrease(start, 0);
+            int settledCount = 0;
+            while (!witnessHeap.isEmpty() && settledCount < WITNESS_SETTLE_LIMIT) {
+                if (witnessHeap.peekPriority() > limit) {
+                    break;
+                }
+                int v = witnessHeap.pop();
+                settledCount++;
+                for (const Edge& edge : out[v]) {
+                    if (edge.other == skip) {
+                        continue;
+                    }
+                    double dist = witnessDistance[v] + edge.cost;
+                    if (dist < witnessDistance[edge.other]) {
+                        if (std::isinf(witnessDistance[edge.other])) {
+                            witnessTouched.push_back(edge.other);
+                        }
+                        witnessDistance[edge.other] = dist;
+                        witnessHeap.pushOrDecrease(edge.other, dist);
+                    }
+                }
+            }
+        }
+
+        void clearWitnessSearch() {
+            for (int v : witnessTouched) {
+                witnessDistance[v] = INFINITY;
+            }
+            witnessTouched.clear();
+            witnessHeap.clear();
+        }
+    };
+}
+
+/*
+ * Contracts nodes in lazily updated edge-difference order: the node on top of
+ * the queue has its priority recomputed, and is only contracted if it is still
+ * no worse than the next candidate. After each contraction the priorities of
+ * its neighbors are refreshed, since they are the ones that changed.
+ */
+ContractionHierarchy::ContractionHierarchy(const CompiledRoadGraph& graph)
+    : rank(graph.nodeCount(), -1) {
+    int n = graph.nodeCount();
+    Contractor contractor(graph);
+    IndexedHeap queue(n);
+    for (int v = 0; v < n; v++) {
+        queue.pushOrDecrease(v, contractor.priority(v));
+    }
+
+    std::vector<std::vector<Arc>> up(n), down(n);
+    std::vector<int> neighbors;
+    int nextRank = 0;
+    while (!queue.isEmpty()) {
+        int v = queue.pop();
+        int current = contractor.priority(v);
+        if (!queue.isEmpty() && current > queue.peekPriority()) {
+            queue.pushOrDecrease(v, current);
+            continue;
+        }
+
+        /* Everything still attached to v is ranked higher than v. */
+        for (const Edge& edge : contractor.out[v]) {
+            up[v].push_back({edge.other, edge.cost, edge.middle});
+        }
+        for (const Edge& edge : contractor.in[v]) {
+            down[v].push_back({edge.other, edge.cost, edge.middle});
+        }
+        neighbors.clear();
+        for (const Edge& edge : contractor.out[v]) {
+            neighbors.push_back(edge.other);
+        }
+        for (const Edge& edge : contractor.in[v]) {
+            neighbors.push_back(edge.other);
+        }
+
+        shortcuts += contractor.contract(v, /* apply */ true);
+        rank[v] = nextRank++;
+
+        for (int neighbor : neighbors) {
+            if (queue.contains(neighbor)) {
+                queue.update(neighbor, contractor.priority(neighbor));
+            }
+        }
+    }
+
+    upOffsets.assign(n + 1, 0);
+    downOffsets.assign(n + 1, 0);
+    for (int v = 0; v < n; v++) {
+        for (const Arc& arc : up[v]) {
+            arcs.push_back(arc);
+        }
+        upOffsets[v + 1] = static_cast<int>(arcs.size());
+    }
+    downOffsets[0] = static_cast<int>(arcs.size());
+    for (int v = 0; v < n; v++) {
+        for (const Arc& arc : down[v]) {
+            arcs.push_back(arc);
+        }
+        downOffsets[v + 1] = static_cast<int>(arcs.size());
+    }
+}
+
+int ContractionHierarchy::findArc(int from, int to) const {
+    int best = -1;
+    if (rank[from] < rank[to]) {
+        for (int arc = firstUpArc(from); arc < endUpArc(from); arc++) {
+            if (arcs[arc].other == to && (best == -1 || arcs[arc].cost < arcs[best].cost)) {
+                best = arc;
+            }
+        }
+    } else {
+        for (int arc = firstDownArc(to); arc < endDownArc(to); arc++) {
+            if (arcs[arc].other == from && (best == -1 || arcs[arc].cost < arcs[best].cost)) {
+                best = arc;
+            }
+        }
+    }
+    return best;
+}
+
+void ContractionHierarchy::unpackArc(int from, int to, std::vector<int>& path) const {
+    int middle = arcs[findArc(from, to)].middle;
+    if (middle == -1) {
+        path.push_back(to);
+    } else {
+        unpackArc(from, middle, path);
+        unpackArc(middle, to, path);
+    }
+}
+
+ContractionHierarchyQuery::ContractionHierarchyQuery(const ContractionHierarchy& hierarchy)
+    : hierarchy(hierarchy) {
+    int n = hierarchy.nodeCount();
+    for (int side = 0; side < 2; side++) {
+        distance[side].assign(n, INFINITY);
+        parent[side].assign(n, -1);
+        stamp[side].assign(n, 0);
+        open[side].reset(n);
+    }
+}
+
+double ContractionHierarchyQuery::distanceOf(int side, int id) const {
+    return stamp[side][id] == currentStamp ? distance[side][id] : INFINITY;
+}
+
+void ContractionHierarchyQuery::relax(int side, int id, double dist, int from) {
+    if (dist < distanceOf(side, id)) {
+        distance[side][id] = dist;
+        parent[side][id] = from;
+        stamp[side][id] = currentStamp;
+        open[side].pushOrDecrease(id, dist);
+    }
+}
+
+/*
+ * A node is stalled if some higher-ranked node already reached by this side of
+ * the search has an arc down to it that is cheaper than its own distance, since
+ * then no shortest up-down path can pass through it.
+ */
+bool ContractionHierarchyQuery::stalled(int side, int id) const {
+    double dist = distanceOf(side, id);
+    if (side == 0) {
+        for (int arc = hierarchy.firstDownArc(id); arc < hierarchy.endDownArc(id); arc++) {
+            if (distanceOf(0, hierarchy.arcOther(arc)) + hierarchy.arcCost(arc) < dist) {
+                return true;
+            }
+        }
+    } else {
+        for (int arc = hierarchy.firstUpArc(id); arc < hierarchy.endUpArc(id); arc++) {
+            if (distanceOf(1, hierarchy.arcOther(arc)) + hierarchy.arcCost(arc) < dist) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/*
+ * Each side only relaxes arcs toward higher-ranked nodes and stops once its
+ * smallest open distance reaches the best meeting cost mu found so far.
+ */
+double ContractionHierarchyQuery::run(int source, int target) {
+    if (++currentStamp == 0) {
+        for (int side = 0; side < 2; side++) {
+            stamp[side].assign(stamp[side].size(), 0);
+        }
+        currentStamp = 1;
+    }
+    this->source = source;
+    settled.clear();
+    meeting = -1;
+    for (int side = 0; side < 2; side++) {
+        open[side].clear();
+    }
+    relax(0, source, 0, -1);
+    relax(1, target, 0, -1);
+
+    double mu = INFINITY;
+    while (!open[0].isEmpty() || !open[1].isEmpty()) {
+        int side = (!open[0].isEmpty()
+                    && (open[1].isEmpty() || open[0].peekPriority() <= open[1].peekPriority()))
+                ? 0 : 1;
+        if (open[side].peekPriority() >= mu) {
+            open[side].clear();
+            continue;
+        }
+        int v = open[side].pop();
+        double dist = distanceOf(side, v);
+        double through = dist + distanceOf(1 - side, v);
+        if (through < mu) {
+            mu = through;
+            meeting = v;
+        }
+        if (stalled(side, v)) {
+            continue;
+        }
+        settled.push_back(v);
+
+        if (side == 0) {
+            for (int arc = hierarchy.firstUpArc(v); arc < hierarchy.endUpArc(v); arc++) {
+                relax(0, hierarchy.arcOther(arc), dist + hierarchy.arcCost(arc), v);
+            }
+        } else {
+            for (int arc = hierarchy.firstDownArc(v); arc < hierarchy.endDownArc(v); arc++) {
+                relax(1, hierarchy.arcOther(arc), dist + hierarchy.arcCost(arc), v);
+            }
+        }
+    }
+    return mu;
+}
+
+/*
+ * Walks the forward parents from the meeting node down to the source and the
+ * backward parents from the meeting node to the target, unpacking every
+ * hierarchy arc on the way.
+ */
+void ContractionHierarchyQuery::unpackPath(std::vector<int>& path) const {
+    path.clear();
+    if (meeting == -1) {
+        return;
+    }
+    std::vector<int> upward;
+    for (int v = meeting; v != -1; v = parent[0][v]) {
+        upward.push_back(v);
+    }
+    path.push_back(source);
+    for (int i = static_cast<int>(upward.size()) - 1; i > 0; i--) {
+        hierarchy.unpackArc(upward[i], upward[i - 1], path);
+    }
+    for (int v = meeting; parent[1][v] != -1; v = parent[1][v]) {
+        hierarchy.unpackArc(v, parent[1][v], path);
+    }
+}
@@ -0,0 +1,140 @@
+/**
+ * @brief This file declares the Contraction Hierarchies preprocessing and query
+ * engine used for fast repeated point-to-point queries on a static map.
+ * @class ContractionHierarchy.cpp
+ * @version 2026/10/16
+ */
+
+#ifndef _contractionhierarchy_h
+#define _contractionhierarchy_h
+
+#include "CompiledRoadGraph.h"
+#include "IndexedHeap.h"
+#include <vector>
+
+/*
+ * A contraction hierarchy over a CompiledRoadGraph.
+ *
+ * Preprocessing removes ("contracts") the nodes one at a time, least important
+ * first, where importance is the edge difference: the number of shortcuts that
+ * contracting a node would add minus the number of arcs it would remove, plus
+ * the number of its neighbors that are already contracted. When a node v is
+ * contracted, a shortcut u -> w is added for every pair of remaining neighbors
+ * u -> v -> w unless a bounded witness search finds a path from u to w at most
+ * as cheap that avoids v.
+ *
+ * The result is stored as two CSR arrays keyed by node ID: the upward arcs that
+ * leave each node toward higher-ranked nodes, and the downward arcs that enter
+ * each node from higher-ranked nodes. A query runs a Dijkstra search upward from
+ * both endpoints (see ContractionHierarchyQuery), and every shortcut remembers
+ * the node it bypasses so that paths can be unpacked into original arcs.
+ *
+ * A hierarchy is read-only once built and may be shared by several queries.
+ * CustomizableHierarchy (see CustomizableHierarchy.h) fills in the same layout
+ * from an order that does not depend on the costs, so the queries below run on
+ * either kind.
+ */
+class ContractionHierarchy {
+public:
+    /* Builds the hierarchy for the given graph. */
+    explicit ContractionHierarchy(const CompiledRoadGraph& graph);
+
+    /* Returns the number of nodes in the hierarchy. */
+    int nodeCount() const { return static_cast<int>(rank.size()); }
+
+    /* Returns the contraction rank of a node; higher ranks are more important. */
+    int rankOf(int id) const { return rank[id]; }
+
+    /* Returns the number of shortcuts added during preprocessing. */
+    int shortcutCount() const { return shortcuts; }
+
+    /* Returns the index range of the upward arcs leaving a node. */
+    int firstUpArc(int id) const { return upOffsets[id]; }
+    int endUpArc(int id) const { return upOffsets[id + 1]; }
+
+    /* Returns the index range of the downward arcs entering a node; the
+     * "other" end of such an arc is the higher-ranked node it comes from.
+     */
+    int firstDownArc(int id) const { return downOffsets[id]; }
+    int endDownArc(int id) const { return downOffsets[id + 1]; }
+
+    /* Returns the node at the far end of a hierarchy arc, its cost, and the
+     * node a shortcut bypasses (-1 for an original arc).
+     */
+    int arcOther(int arc) const { return arcs[arc].other; }
+    double arcCost(int arc) const { return arcs[arc].cost; }
+    int arcMiddle(int arc) const { return arcs[arc].middle; }
+
+    /*
+     * Appends to path the original nodes strictly after from on the cheapest
+     * hierarchy arc from -> to, ending with to.
+     */
+    void unpackArc(int from, int to, std::vector<int>& path) const;
+
+private:
+    friend class CustomizableHierarchy;
+
+    struct Arc {
+        int other;      // node at the far end
+        double cost;
+        int middle;     // node bypassed by a shortcut, or -1
+    };
+
+    std::vector<int> rank;
+    std::vector<int> upOffsets;     // nodeCount() + 1 offsets into arcs
+    std::vector<int> downOffsets;   // nodeCount() + 1 offsets into arcs, after the up arcs
+    std::vector<Arc> arcs;
+    int shortcuts = 0;
+
+    /* Creates an empty hierarchy for CustomizableHierarchy to fill in. */
+    ContractionHierarchy() = default;
+
+    /* Returns the index of the cheapest up arc from -> to, or of the cheapest
+     * down arc entering to from from, whichever runs between the two nodes.
+     */
+    int findArc(int from, int to) const;
+};
+
+/*
+ * The per-query state for searching a ContractionHierarchy. Keeping it separate
+ * from the hierarchy means each thread can own a query object and reuse its
+ * arrays, while the hierarchy itself is shared.
+ */
+class ContractionHierarchyQuery {
+public:
+    /* Prepares a query workspace for the given hierarchy. */
+    explicit ContractionHierarchyQuery(const ContractionHierarchy& hierarchy);
+
+    /*
+     * Runs a bidirectional upward search from source to target and returns the
+     * cost of the cheapest path, or INFINITY if there is none. Stall-on-demand
+     * skips nodes that the search already reaches more cheaply from above.
+     */
+    double run(int source, int target);
+
+    /*
+     * Fills path with the original node IDs of the path found by the last
+     * successful run, from source to target.
+     */
+    void unpackPath(std::vector<int>& path) const;
+
+    /* Returns the nodes settled by the last run, in the order they were settled. */
+    const std::vector<int>& settledNodes() const { return settled; }
+
+private:
+    const ContractionHierarchy& hierarchy;
+    std::vector<double> distance[2];    // forward / backward tentative distances
+    std::vector<int> parent[2];         // node the distance was reached from
+    std::vector<unsigned> stamp[2];     // query in which the entries were written
+    IndexedHeap open[2];
+    std::vector<int> settled;
+    unsigned currentStamp = 0;
+    int meeting = -1;
+    int source = -1;
+
+    double distanceOf(int side, int id) const;
+    void relax(int side, int id, double dist, int from);
+    bool stalled(int side, int id) const;
+};
+
+#endif // _contractionhierarchy_h
@@ -0,0 +1,369 @@
+/**
+ * @brief This file implements the customizable hierarchy.
+ * @headerfile CustomizableHierarchy.h
+ * @version 2026/10/16
+ */
+
+#include "CustomizableHierarchy.h"
+#include "error.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iterator>
+#include <thread>
+
+/* Private helper types and constants only needed in this file. */
+namespace {
+    /* Parts of the map this small are not cut any further. */
+    const int LEAF_SIZE = 8;
+
+    /* The directions tried for each cut: across, down, and the two diagonals. */
+    const int CUT_DIRECTIONS = 4;
+    const double CUT_DX[CUT_DIRECTIONS] = { 1, 0, 1, 1 };
+    const double CUT_DY[CUT_DIRECTIONS] = { 0, 1, 1, -1 };
+
+    /*
+     * The fewest nodes a level needs before its customization is spread over
+     * the workers; the top levels hold only a few nodes each, and starting
+     * threads for them would cost more than the work.
+     */
+    const int PARALLEL_LEVEL_SIZE = 512;
+
+    /* The number of nodes a worker claims at a time within a level. */
+    const int NODES_PER_CLAIM = 64;
+
+    /*
+     * Orders the nodes of a graph by nested dissection of their locations, from
+     * least to most important.
+     */
+    class Dissector {
+    public:
+        explicit Dissector(const CompiledRoadGraph& graph)
+            : graph(graph),
+              side(graph.nodeCount(), 0) {
+            // empty
+        }
+
+        /* Appends the given nodes to order: both halves first, then the cut. */
+        void dissect(std::vector<int>& nodes, std::vector<int>& order) {
+            if (static_cast<int>(nodes.size()) <= LEAF_SIZE) {
+                order.insert(order.end(), nodes.begin(), nodes.end());
+                return;
+            }
+
+            /*
+             * Try a cut at the median along each of a few directions and keep
+             * the one with the fewest nodes in it.
+             */
+            std::vector<int> best;
+            std::vector<int> bestHalves[2];
+            for (int direction = 0; direction < CUT_DIRECTIONS; direction++) {
+                double dx = CUT_DX[direction];
+                double dy = CUT_DY[direction];
+                auto before = [&](int a, int b) {
+                    double ca = dx * graph.x(a) + dy * graph.y(a);
+                    double cb = dx * graph.x(b) + dy * graph.y(b);
+                    return ca < cb || (ca == cb && a < b);
+                };
+                auto middle = nodes.begin() + nodes.size() / 2;
+                std::nth_element(nodes.begin(), middle, nodes.end(), before);
+                for (auto it = nodes.begin(); it != nodes.end(); ++it) {
+                    side[*it] = it < middle ? 1 : 2;
+                }
+
+                /* The cut is the smaller of the two sets of nodes with roads across. */
+                std::vector<int> boundary[2];
+                for (int v : nodes) {
+                    if (crosses(v)) {
+                        boundary[side[v] - 1].push_back(v);
+                    }
+                }
+                int cutSide = boundary[0].size() <= boundary[1].size() ? 1 : 2;
+                if (direction == 0 || boundary[cutSide - 1].size() < best.size()) {
+                    best.swap(boundary[cutSide - 1]);
+                    for (int half = 0; half < 2; half++) {
+                        bestHalves[half].clear();
+                    }
+                    for (int v : nodes) {
+                        if (side[v] != cutSide || !crosses(v)) {
+                            bestHalves[side[v] - 1].push_back(v);
+                        }
+                    }
+                }
+            }
+            for (int v : nodes) {
+                side[v] = 0;
+            }
+            nodes.clear();
+            nodes.shrink_to_fit();
+
+            dissect(bestHalves[0], order);
+            dissect(bestHalves[1], order);
+            order.insert(order.end(), best.begin(), best.end());
+        }
+
+    private:
+        const CompiledRoadGraph& graph;
+        std::vector<int> side;   // 1 or 2 for nodes of the part being cut, else 0
+
+        /* Returns whether v has an arc to or from the other half of the cut. */
+        bool crosses(int v) const {
+            int other = 3 - side[v];
+            for (int arc = graph.firstArc(v); arc < graph.endArc(v); arc++) {
+                if (side[graph.arcTarget(arc)] == other) {
+                    return true;
+                }
+            }
+            for (int inArc = graph.firstInArc(v); inArc < graph.endInArc(v); inArc++) {
+                if (side[graph.inArcSource(inArc)] == other) {
+                    return true;
+                }
+            }
+            return false;
+        }
+    };
+}
+
+/*
+ * Contracting a node joins all of its higher neighbors to each other. It is
+ * enough to pass them on to the lowest of them, which will join the rest when
+ * its own turn comes, so each node's set of higher neighbors is merged into
+ * that of a single node. The levels follow from the lower neighbors: a node is
+ * one level above the highest level among them.
+ */
+CustomizableHierarchy::CustomizableHierarchy(const CompiledRoadGraph& graph, int threadCount)
+    : graph(graph),
+      threads(threadCount) {
+    if (threads <= 0) {
+        threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    int n = graph.nodeCount();
+    std::vector<int> nodes(n);
+    for (int v = 0; v < n; v++) {
+        nodes[v] = v;
+    }
+    order.reserve(n);
+    Dissector(graph).dissect(nodes, order);
+    std::vector<int>& rank = metric.rank;
+    rank.assign(n, -1);
+    for (int r = 0; r < n; r++) {
+        rank[order[r]] = r;
+    }
+
+    /* The higher neighbors of every rank, as sorted ranks. */
+    std::vector<std::vector<int>> upper(n);
+    for (int v = 0; v < n; v++) {
+        for (int arc = graph.firstArc(v); arc < graph.endArc(v); arc++) {
+            int w = graph.arcTarget(arc);
+            int low = std::min(rank[v], rank[w]);
+            int high = std::max(rank[v], rank[w]);
+            if (low != high) {
+                upper[low].push_back(high);
+            }
+        }
+    }
+    std::vector<int> merged;
+    for (int r = 0; r < n; r++) {
+        std::sort(upper[r].begin(), upper[r].end());
+        upper[r].erase(std::unique(upper[r].begin(), upper[r].end()), upper[r].end());
+        if (upper[r].size() > 1) {
+            std::vector<int>& next = upper[upper[r][0]];
+            merged.clear();
+            std::set_union(next.begin(), next.end(), upper[r].begin() + 1, upper[r].end(),
+                           std::back_inserter(merged));
+            next.swap(merged);
+        }
+    }
+
+    /* Lay the arcs out as the hierarchy expects: all up arcs, then all down arcs. */
+    metric.upOffsets.assign(n + 1, 0);
+    metric.downOffsets.assign(n + 1, 0);
+    for (int v = 0; v < n; v++) {
+        metric.upOffsets[v + 1] = metric.upOffsets[v] + static_cast<int>(upper[rank[v]].size());
+    }
+    int edges = metric.upOffsets[n];
+    for (int v = 0; v <= n; v++) {
+        metric.downOffsets[v] = edges + metric.upOffsets[v];
+    }
+    metric.arcs.resize(2 * static_cast<size_t>(edges));
+    for (int v = 0; v < n; v++) {
+        int edge = metric.upOffsets[v];
+        for (int high : upper[rank[v]]) {
+            ContractionHierarchy::Arc arc = { order[high], INFINITY, -1 };
+            metric.arcs[edge] = arc;
+            metric.arcs[edges + edge] = arc;
+            edge++;
+        }
+    }
+
+    /* The lower neighbors of every rank, with the arcs that reach it from them. */
+    lowerOffsets.assign(n + 1, 0);
+    for (int r = 0; r < n; r++) {
+        for (int high : upper[r]) {
+            lowerOffsets[high + 1]++;
+        }
+    }
+    for (int r = 0; r < n; r++) {
+        lowerOffsets[r + 1] += lowerOffsets[r];
+    }
+    lowerRanks.resize(edges);
+    lowerEdges.resize(edges);
+    std::vector<int> fill(lowerOffsets.begin(), lowerOffsets.end() - 1);
+    std::vector<int> level(n, 0);
+    int levels = n > 0 ? 1 : 0;
+    for (int r = 0; r < n; r++) {
+        int edge = metric.upOffsets[order[r]];
+        for (int high : upper[r]) {
+            lowerRanks[fill[high]] = r;
+            lowerEdges[fill[high]] = edge++;
+            fill[high]++;
+            level[high] = std::max(level[high], level[r] + 1);
+            levels = std::max(levels, level[high] + 1);
+        }
+    }
+    levelOffsets.assign(levels + 1, 0);
+    for (int r = 0; r < n; r++) {
+        levelOffsets[level[r] + 1]++;
+    }
+    for (int l = 0; l < levels; l++) {
+        levelOffsets[l + 1] += levelOffsets[l];
+    }
+    levelRanks.resize(n);
+    fill.assign(levelOffsets.begin(), levelOffsets.end() - 1);
+    for (int r = 0; r < n; r++) {
+        levelRanks[fill[level[r]]++] = r;
+    }
+
+    /* Find the hierarchy arc that stands for each arc of the graph. */
+    arcSlots.assign(graph.arcCount(), -1);
+    std::vector<bool> original(edges, false);
+    for (int v = 0; v < n; v++) {
+        for (int arc = graph.firstArc(v); arc < graph.endArc(v); arc++) {
+            int w = graph.arcTarget(arc);
+            int low = std::min(rank[v], rank[w]);
+            int high = std::max(rank[v], rank[w]);
+            if (low == high) {
+                continue;
+            }
+            const std::vector<int>& higher = upper[low];
+            int edge = metric.upOffsets[order[low]]
+                    + static_cast<int>(std::lower_bound(higher.begin(), higher.end(), high)
+                                       - higher.begin());
+            original[edge] = true;
+            arcSlots[arc] = rank[v] == low ? edge : edges + edge;
+        }
+    }
+    metric.shortcuts = static_cast<int>(std::count(original.begin(), original.end(), false));
+
+    customize();
+}
+
+void CustomizableHierarchy::customize() {
+    std::vector<double> arcCosts(graph.arcCount());
+    for (int arc = 0; arc < graph.arcCount(); arc++) {
+        arcCosts[arc] = graph.arcCost(arc);
+    }
+    customize(arcCosts);
+}
+
+/*
+ * The costs of the graph's arcs go into the hierarchy arcs that stand for them
+ * first; then the levels are processed from the bottom up. The nodes of a level
+ * only write their own arcs and only read arcs of lower levels, so a level can
+ * be split among the workers freely, and the workers meet after each level.
+ */
+void CustomizableHierarchy::customize(const std::vector<double>& arcCosts) {
+    if (static_cast<int>(arcCosts.size()) != graph.arcCount()) {
+        error("CustomizableHierarchy::customize: need one cost per arc");
+    }
+    for (ContractionHierarchy::Arc& arc : metric.arcs) {
+        arc.cost = INFINITY;
+        arc.middle = -1;
+    }
+    for (int arc = 0; arc < graph.arcCount(); arc++) {
+        double cost = arcCosts[arc];
+        if (!(cost >= 0)) {
+            error("CustomizableHierarchy::customize: arc costs must not be negative");
+        }
+        int slot = arcSlots[arc];
+        if (slot != -1 && cost < metric.arcs[slot].cost) {
+            metric.arcs[slot].cost = cost;
+        }
+    }
+
+    for (int l = 0; l < levelCount(); l++) {
+        int first = levelOffsets[l];
+        int count = levelOffsets[l + 1] - first;
+        if (threads == 1 || count < PARALLEL_LEVEL_SIZE) {
+            for (int i = first; i < first + count; i++) {
+                customizeNode(levelRanks[i]);
+            }
+            continue;
+        }
+
+        std::atomic<int> next(0);
+        auto loop = [&]() {
+            while (true) {
+                int claimed = next.fetch_add(NODES_PER_CLAIM, std::memory_order_relaxed);
+                if (claimed >= count) {
+                    return;
+                }
+                int last = std::min(claimed + NODES_PER_CLAIM, count);
+                for (int i = claimed; i < last; i++) {
+                    customizeNode(levelRanks[first + i]);
+                }
+            }
+        };
+        int chunks = (count + NODES_PER_CLAIM - 1) / NODES_PER_CLAIM;
+        int helpers = std::min(threads, chunks) - 1;
+        std::vector<std::thread> workers;
+        for (int i = 0; i < helpers; i++) {
+            workers.emplace_back(loop);
+        }
+        loop();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+}
+
+/*
+ * For the arc between x and each higher neighbor y, the lower triangles are the
+ * nodes in both lower neighbor lists; walking the two sorted lists together
+ * finds them. Going x -> v -> y uses the down arc into v from x and the up arc
+ * from v to y, and the other direction the reverse pair.
+ */
+void CustomizableHierarchy::customizeNode(int rank) {
+    std::vector<ContractionHierarchy::Arc>& arcs = metric.arcs;
+    int edges = metric.upOffsets.back();
+    int x = order[rank];
+    for (int edge = metric.firstUpArc(x); edge < metric.endUpArc(x); edge++) {
+        ContractionHierarchy::Arc& up = arcs[edge];
+        ContractionHierarchy::Arc& down = arcs[edges + edge];
+        int y = metric.rank[up.other];
+        int i = lowerOffsets[rank];
+        int k = lowerOffsets[y];
+        while (i < lowerOffsets[rank + 1] && k < lowerOffsets[y + 1]) {
+            if (lowerRanks[i] < lowerRanks[k]) {
+                i++;
+            } else if (lowerRanks[k] < lowerRanks[i]) {
+                k++;
+            } else {
+                int toX = lowerEdges[i];
+                int toY = lowerEdges[k];
+                double forward = arcs[edges + toX].cost + arcs[toY].cost;
+                if (forward < up.cost) {
+                    up.cost = forward;
+                    up.middle = order[lowerRanks[i]];
+                }
+                double backward = arcs[edges + toY].cost + arcs[toX].cost;
+                if (backward < down.cost) {
+                    down.cost = backward;
+                    down.middle = order[lowerRanks[i]];
+                }
+                i++;
+                k++;
+            }
+        }
+    }
+}
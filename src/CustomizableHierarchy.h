@@ -0,0 +1,88 @@
+/**
+ * @brief This file declares the customizable hierarchy, a contraction hierarchy
+ * whose structure is built once per map and whose costs can be replaced quickly.
+ * @class CustomizableHierarchy.cpp
+ * @version 2026/10/16
+ */
+
+#ifndef _customizablehierarchy_h
+#define _customizablehierarchy_h
+
+#include "CompiledRoadGraph.h"
+#include "ContractionHierarchy.h"
+#include <vector>
+
+/*
+ * A contraction hierarchy split into a preprocessing step that only looks at
+ * the shape of the map and a customization step that applies a cost per arc.
+ *
+ * Preprocessing orders the nodes by nested dissection of the map: a straight
+ * cut through the middle of the node locations divides the map in two, the
+ * nodes on one side of the cut that have roads across it are ranked above both
+ * halves, and each half is ordered the same way. Contracting the nodes in this
+ * order, with every pair of higher neighbors of a node joined by a shortcut and
+ * no witness searches, gives a hierarchy that is valid for any costs at all.
+ * This runs once per map.
+ *
+ * Customization then fills in the cost of every hierarchy arc for a given cost
+ * vector. An arc u - w is relaxed through every lower node v joined to both of
+ * them (the "lower triangles" of the arc), and since the arcs of a node only
+ * depend on arcs of lower nodes, the nodes are processed level by level, with
+ * the nodes of one level spread over worker threads. This is one pass over flat
+ * arrays, far cheaper than contracting the map again, so switching metrics or
+ * applying a traffic snapshot keeps the hierarchy usable within the same
+ * session.
+ *
+ * The result is an ordinary ContractionHierarchy, searched with
+ * ContractionHierarchyQuery. Its queries settle somewhat more nodes than on a
+ * hierarchy contracted for one metric, since no shortcut is ever left out.
+ */
+class CustomizableHierarchy {
+public:
+    /*
+     * Builds the structure of the hierarchy for the given graph, and customizes
+     * it with the graph's current arc costs. A thread count of 0 uses one worker
+     * per hardware thread. The graph must outlive the hierarchy.
+     */
+    explicit CustomizableHierarchy(const CompiledRoadGraph& graph, int threadCount = 0);
+
+    /* Returns the number of worker threads customization is spread over. */
+    int threadCount() const { return threads; }
+
+    /* Returns the number of levels the nodes are processed in. */
+    int levelCount() const { return static_cast<int>(levelOffsets.size()) - 1; }
+
+    /*
+     * Replaces the cost of every arc of the graph, indexed like the graph's arcs,
+     * and recomputes the costs of the hierarchy. INFINITY closes an arc. Queries
+     * must not run on the hierarchy while it is being customized.
+     *
+     * Throws an ErrorException if there is not one cost per arc or a cost is
+     * negative.
+     */
+    void customize(const std::vector<double>& arcCosts);
+
+    /* Customizes the hierarchy with the graph's current arc costs. */
+    void customize();
+
+    /* Returns the hierarchy with the costs of the last customization. */
+    const ContractionHierarchy& hierarchy() const { return metric; }
+
+private:
+    const CompiledRoadGraph& graph;
+    int threads;
+    ContractionHierarchy metric;     // the structure, with the current costs
+
+    std::vector<int> order;          // node ID of each rank
+    std::vector<int> arcSlots;       // hierarchy arc of each graph arc, or -1
+    std::vector<int> lowerOffsets;   // by rank, offsets into the lower arrays
+    std::vector<int> lowerRanks;     // lower neighbors of each rank, ascending
+    std::vector<int> lowerEdges;     // the up arc from that neighbor to the rank
+    std::vector<int> levelOffsets;   // offsets into levelRanks for each level
+    std::vector<int> levelRanks;     // ranks grouped by level
+
+    /* Recomputes the costs of the up and down arcs of the node of the given rank. */
+    void customizeNode(int rank);
+};
+
+#endif // _customizablehierarchy_h
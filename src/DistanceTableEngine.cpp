@@ -0,0 +1,272 @@
+/**
+ * @brief This file implements the distance table engine.
+ * @headerfile DistanceTableEngine.h
+ * @version 2026/10/16
+ */
+
+#include "DistanceTableEngine.h"
+#include "error.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+/* Private constants and helper classes only needed in this file. */
+namespace {
+    /*
+     * The number of searches a worker claims at a time; each one is short, so a
+     * worker takes a few at once to keep contention on the shared counter low.
+     */
+    const int SEARCHES_PER_CLAIM = 16;
+
+    /*
+     * A Dijkstra search that only climbs the hierarchy: forward along the upward
+     * arcs, or backward along the downward arcs, and without a target, so it
+     * settles the root's whole upward search space. Stall-on-demand skips nodes
+     * that are reached more cheaply through a higher-ranked node the search has
+     * already reached.
+     */
+    class UpwardSearch {
+    public:
+        explicit UpwardSearch(const ContractionHierarchy& hierarchy)
+            : hierarchy(hierarchy),
+              distance(hierarchy.nodeCount(), INFINITY),
+              stamp(hierarchy.nodeCount(), 0),
+              open(hierarchy.nodeCount()) {
+            // empty
+        }
+
+        /* Searches from root, forward if forward is true and backward otherwise. */
+        void run(int root, bool forward) {
+            if (++currentStamp == 0) {
+                stamp.assign(stamp.size(), 0);
+                currentStamp = 1;
+            }
+            open.clear();
+            settled.clear();
+            relax(root, 0);
+            while (!open.isEmpty()) {
+                int v = open.pop();
+                if (stalled(v, forward)) {
+                    continue;
+                }
+                settled.push_back(v);
+                double dist = distance[v];
+                int first = forward ? hierarchy.firstUpArc(v) : hierarchy.firstDownArc(v);
+                int end = forward ? hierarchy.endUpArc(v) : hierarchy.endDownArc(v);
+                for (int arc = first; arc < end; arc++) {
+                    relax(hierarchy.arcOther(arc), dist + hierarchy.arcCost(arc));
+                }
+            }
+        }
+
+        /* Returns the nodes the last run settled, and the distance of a settled node. */
+        const std::vector<int>& settledNodes() const { return settled; }
+        double distanceOf(int id) const {
+            return stamp[id] == currentStamp ? distance[id] : INFINITY;
+        }
+
+    private:
+        const ContractionHierarchy& hierarchy;
+        std::vector<double> distance;
+        std::vector<unsigned> stamp;   // run in which each distance was written
+        unsigned currentStamp = 0;
+        IndexedHeap open;
+        std::vector<int> settled;
+
+        void relax(int id, double dist) {
+            if (dist < distanceOf(id)) {
+                distance[id] = dist;
+                stamp[id] = currentStamp;
+                open.pushOrDecrease(id, dist);
+            }
+        }
+
+        /* The arcs that lead into id from above are the ones the opposite search follows. */
+        bool stalled(int id, bool forward) const {
+            double dist = distance[id];
+            int first = forward ? hierarchy.firstDownArc(id) : hierarchy.firstUpArc(id);
+            int end = forward ? hierarchy.endDownArc(id) : hierarchy.endUpArc(id);
+            for (int arc = first; arc < end; arc++) {
+                if (distanceOf(hierarchy.arcOther(arc)) + hierarchy.arcCost(arc) < dist) {
+                    return true;
+                }
+            }
+            return false;
+        }
+    };
+
+    /* Returns the node ID of every node, or throws if one is not in the graph. */
+    std::vector<int> idsOf(const CompiledRoadGraph& compiled,
+                           const std::vector<RoadNode*>& nodes) {
+        std::vector<int> ids;
+        ids.reserve(nodes.size());
+        for (RoadNode* node : nodes) {
+            int id = compiled.idOf(node);
+            if (id == -1) {
+                error("DistanceTableEngine::run: node is not in the graph");
+            }
+            ids.push_back(id);
+        }
+        return ids;
+    }
+}
+
+/* The search state and bucket entries one worker thread reuses between tables. */
+struct DistanceTableEngine::Worker {
+    explicit Worker(const ContractionHierarchy& hierarchy) : search(hierarchy) {}
+
+    UpwardSearch search;
+    std::vector<int> entryNodes;      // bucket entries found by this worker's
+    std::vector<int> entryColumns;    // backward searches, before they are
+    std::vector<double> entryCosts;   // sorted into the shared buckets
+};
+
+DistanceTableEngine::DistanceTableEngine(const RoadGraph& graph, int threadCount)
+    : graph(graph),
+      threads(threadCount > 0
+              ? threadCount
+              : std::max(1, static_cast<int>(std::thread::hardware_concurrency()))) {
+    rebuild();
+}
+
+DistanceTableEngine::~DistanceTableEngine() {
+    // empty; the workers are released by their unique_ptrs
+}
+
+/*
+ * The hierarchy may be a different object after a change, and the searches hold
+ * references to it, so everything built on it is thrown away.
+ */
+void DistanceTableEngine::rebuild() {
+    hierarchy = &graph.hierarchy();
+    builtVersion = graph.version();
+    workers.clear();
+    for (int i = 0; i < threads; i++) {
+        workers.emplace_back(new Worker(*hierarchy));
+    }
+    pathQuery.reset();
+}
+
+/*
+ * The calling thread works as the first worker, and helper threads are only
+ * started when there are enough searches to give each of them a chunk.
+ */
+template <typename Work>
+void DistanceTableEngine::forEach(int count, Work work) {
+    std::atomic<int> next(0);
+    auto loop = [&](Worker& worker) {
+        while (true) {
+            int first = next.fetch_add(SEARCHES_PER_CLAIM, std::memory_order_relaxed);
+            if (first >= count) {
+                return;
+            }
+            int last = std::min(first + SEARCHES_PER_CLAIM, count);
+            for (int i = first; i < last; i++) {
+                work(worker, i);
+            }
+        }
+    };
+
+    int chunks = (count + SEARCHES_PER_CLAIM - 1) / SEARCHES_PER_CLAIM;
+    int helpers = std::min(threadCount(), chunks) - 1;
+    std::vector<std::thread> threads;
+    for (int i = 1; i <= helpers; i++) {
+        threads.emplace_back(loop, std::ref(*workers[i]));
+    }
+    loop(*workers[0]);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+DistanceTable DistanceTableEngine::run(const std::vector<RoadNode*>& sources,
+                                       const std::vector<RoadNode*>& targets) {
+    if (graph.version() != builtVersion) {
+        rebuild();
+    }
+    const CompiledRoadGraph& compiled = graph.compile();
+    DistanceTable table;
+    table.version = builtVersion;
+    table.sources = idsOf(compiled, sources);
+    table.targets = idsOf(compiled, targets);
+    table.costs.assign(table.sources.size() * table.targets.size(), INFINITY);
+
+    fillBuckets(table.targets);
+
+    int columns = table.columnCount();
+    forEach(table.rowCount(), [&](Worker& worker, int row) {
+        worker.search.run(table.sources[row], /* forward */ true);
+        double* costs = table.costs.data() + static_cast<size_t>(row) * columns;
+        for (int v : worker.search.settledNodes()) {
+            double up = worker.search.distanceOf(v);
+            for (int entry = bucketOffsets[v]; entry < bucketOffsets[v + 1]; entry++) {
+                double through = up + bucketCosts[entry];
+                int column = bucketColumns[entry];
+                if (through < costs[column]) {
+                    costs[column] = through;
+                }
+            }
+        }
+    });
+    return table;
+}
+
+/*
+ * Each worker collects the entries of its own backward searches, and the entries
+ * are then sorted by node with a counting sort, so that a bucket is one
+ * contiguous run of the shared arrays.
+ */
+void DistanceTableEngine::fillBuckets(const std::vector<int>& targets) {
+    for (auto& worker : workers) {
+        worker->entryNodes.clear();
+        worker->entryColumns.clear();
+        worker->entryCosts.clear();
+    }
+    forEach(static_cast<int>(targets.size()), [&](Worker& worker, int column) {
+        worker.search.run(targets[column], /* forward */ false);
+        for (int v : worker.search.settledNodes()) {
+            worker.entryNodes.push_back(v);
+            worker.entryColumns.push_back(column);
+            worker.entryCosts.push_back(worker.search.distanceOf(v));
+        }
+    });
+
+    int nodeCount = hierarchy->nodeCount();
+    bucketOffsets.assign(nodeCount + 1, 0);
+    for (auto& worker : workers) {
+        for (int v : worker->entryNodes) {
+            bucketOffsets[v + 1]++;
+        }
+    }
+    for (int v = 0; v < nodeCount; v++) {
+        bucketOffsets[v + 1] += bucketOffsets[v];
+    }
+    bucketColumns.resize(bucketOffsets[nodeCount]);
+    bucketCosts.resize(bucketOffsets[nodeCount]);
+    std::vector<int> next(bucketOffsets.begin(), bucketOffsets.end() - 1);
+    for (auto& worker : workers) {
+        for (size_t i = 0; i < worker->entryNodes.size(); i++) {
+            int slot = next[worker->entryNodes[i]]++;
+            bucketColumns[slot] = worker->entryColumns[i];
+            bucketCosts[slot] = worker->entryCosts[i];
+        }
+    }
+}
+
+void DistanceTableEngine::unpackPath(const DistanceTable& table, int row, int column,
+                                     std::vector<int>& path) {
+    path.clear();
+    if (table.version != graph.version()) {
+        error("DistanceTableEngine::unpackPath: the graph has changed since the table was"
+              " computed");
+    }
+    if (table.cost(row, column) == INFINITY) {
+        return;
+    }
+    if (!pathQuery) {
+        pathQuery.reset(new ContractionHierarchyQuery(*hierarchy));
+    }
+    pathQuery->run(table.sources[row], table.targets[column]);
+    pathQuery->unpackPath(path);
+}
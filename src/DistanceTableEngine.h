@@ -0,0 +1,117 @@
+/**
+ * @brief This file declares the distance table engine, which computes the costs
+ * between every source and every target of two node sets on one map.
+ * @class DistanceTableEngine.cpp
+ * @version 2026/10/16
+ */
+
+#ifndef _distancetableengine_h
+#define _distancetableengine_h
+
+#include "ContractionHierarchy.h"
+#include "RoadGraph.h"
+#include <memory>
+#include <vector>
+
+/*
+ * A sources-by-targets table of travel costs. The costs are stored row-major:
+ * row i holds the costs from source i to every target, in the order of the
+ * targets. A cost is INFINITY if the target cannot be reached.
+ */
+struct DistanceTable {
+    std::vector<int> sources;   // node IDs of the rows
+    std::vector<int> targets;   // node IDs of the columns
+    std::vector<double> costs;
+    unsigned version = 0;       // RoadGraph::version() of the graph the costs are for
+
+    /* Returns the number of rows (sources) and columns (targets). */
+    int rowCount() const { return static_cast<int>(sources.size()); }
+    int columnCount() const { return static_cast<int>(targets.size()); }
+
+    /* Returns the cost from the source of the given row to the target of the given column. */
+    double cost(int row, int column) const {
+        return costs[static_cast<size_t>(row) * targets.size() + column];
+    }
+};
+
+/*
+ * Computes many-to-many distance tables on the graph's contraction hierarchy
+ * with the bucket method.
+ *
+ * Every target first runs a Dijkstra search backward and upward through the
+ * hierarchy and leaves an entry (column, distance) in a bucket at every node it
+ * settles. Every source then runs one search forward and upward and, at every
+ * node it settles, scans the bucket there: an entry offers the cost of going up
+ * to the node and down again to the entry's target. Since every shortest path in
+ * the hierarchy climbs to its highest node and then descends, the cheapest offer
+ * for each target is its cost. With S sources and T targets this takes S + T
+ * small searches instead of S * T point-to-point queries.
+ *
+ * Both phases are spread over a fixed number of worker threads in the same way
+ * as BatchQueryEngine: the workers keep their search arrays from one table to
+ * the next, claim searches in small chunks from a shared counter and write into
+ * disjoint parts of the result.
+ *
+ * The engine follows changes to the graph: when the graph's version (see
+ * RoadGraph::version) has moved on, the next table is computed on the graph's
+ * current hierarchy, and the workers rebuild their searches for it. The graph
+ * must not change while a table is being computed.
+ */
+class DistanceTableEngine {
+public:
+    /*
+     * Prepares an engine for the given graph, building its contraction hierarchy
+     * if it does not exist yet. A thread count of 0 uses one worker per hardware
+     * thread.
+     */
+    explicit DistanceTableEngine(const RoadGraph& graph, int threadCount = 0);
+    ~DistanceTableEngine();
+
+    /* Returns the number of worker threads a table is spread over. */
+    int threadCount() const { return threads; }
+
+    /*
+     * Returns the table of costs from every source to every target.
+     *
+     * Throws an ErrorException if a node is not in the graph.
+     */
+    DistanceTable run(const std::vector<RoadNode*>& sources,
+                      const std::vector<RoadNode*>& targets);
+
+    /*
+     * Fills path with the node IDs of a cheapest path for one cell of a table
+     * computed by this engine, or leaves it empty if the cost is INFINITY. This
+     * runs a point-to-point hierarchy query, so reconstructing only the paths
+     * that are needed is much cheaper than keeping all of them. It must not be
+     * called while run() is in progress.
+     *
+     * Throws an ErrorException if the graph has changed since the table was
+     * computed.
+     */
+    void unpackPath(const DistanceTable& table, int row, int column, std::vector<int>& path);
+
+private:
+    struct Worker;
+
+    const RoadGraph& graph;
+    const ContractionHierarchy* hierarchy;   // the graph's hierarchy at builtVersion
+    unsigned builtVersion;
+    int threads;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::unique_ptr<ContractionHierarchyQuery> pathQuery;
+
+    std::vector<int> bucketOffsets;   // nodeCount() + 1 offsets into the bucket arrays
+    std::vector<int> bucketColumns;   // target column of each bucket entry
+    std::vector<double> bucketCosts;  // cost from the bucket's node down to that target
+
+    /* Runs work(worker, index) for every index in [0, count) on all workers. */
+    template <typename Work>
+    void forEach(int count, Work work);
+
+    void fillBuckets(const std::vector<int>& targets);
+
+    /* Builds the workers' searches for the graph's current hierarchy. */
+    void rebuild();
+};
+
+#endif // _distancetableengine_h
@@ -0,0 +1,114 @@
+/**
+ * @brief This file declares and implements a bounded lock-free queue that
+ * passes events from one thread to another.
+ * @class EventRing.h
+ * @version 2026/10/16
+ */
+
+#ifndef _eventring_h
+#define _eventring_h
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+/*
+ * A fixed-size ring buffer of events with exactly one producer thread and one
+ * consumer thread (SPSC). Neither side ever waits for the other or takes a
+ * lock: push fails when the ring is full and pop fails when it is empty, and
+ * the caller decides what to do about it.
+ *
+ * The producer owns the tail index and the consumer owns the head index, and
+ * each publishes its index to the other with a release store. Each side also
+ * keeps its own copy of the other's index and only rereads the shared one when
+ * that copy says the ring is full (or empty), so in the common case a push or a
+ * pop touches no cache line the other thread is writing. The indices only ever
+ * grow; the capacity is a power of two, so a slot is found with a mask.
+ */
+template <typename T>
+class EventRing {
+public:
+    /* Creates a ring that holds at least the given number of events. */
+    explicit EventRing(int minimumCapacity) {
+        size_t capacity = 2;
+        while (capacity < static_cast<size_t>(minimumCapacity)) {
+            capacity *= 2;
+        }
+        slots.resize(capacity);
+        mask = capacity - 1;
+    }
+
+    EventRing(const EventRing&) = delete;
+    EventRing& operator =(const EventRing&) = delete;
+
+    /* Returns the number of events the ring holds when full. */
+    int capacity() const { return static_cast<int>(slots.size()); }
+
+    /*
+     * Appends an event, or returns false if the ring is full. Only the producer
+     * thread may call this.
+     */
+    bool push(const T& event) {
+        size_t tail = producer.index.load(std::memory_order_relaxed);
+        if (tail - producer.otherIndex == slots.size()) {
+            producer.otherIndex = consumer.index.load(std::memory_order_acquire);
+            if (tail - producer.otherIndex == slots.size()) {
+                return false;
+            }
+        }
+        slots[tail & mask] = event;
+        producer.index.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /*
+     * Removes the oldest event into the given variable, or returns false if the
+     * ring is empty. Only the consumer thread may call this.
+     */
+    bool pop(T& event) {
+        size_t head = consumer.index.load(std::memory_order_relaxed);
+        if (head == consumer.otherIndex) {
+            consumer.otherIndex = producer.index.load(std::memory_order_acquire);
+            if (head == consumer.otherIndex) {
+                return false;
+            }
+        }
+        event = slots[head & mask];
+        consumer.index.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /*
+     * Removes every event pushed so far, oldest first, handing each to the
+     * given function, and returns how many there were. This frees their slots
+     * with a single store. Only the consumer thread may call this.
+     */
+    template <typename Function>
+    int drain(Function handle) {
+        size_t head = consumer.index.load(std::memory_order_relaxed);
+        size_t tail = producer.index.load(std::memory_order_acquire);
+        consumer.otherIndex = tail;
+        for (size_t i = head; i != tail; i++) {
+            handle(slots[i & mask]);
+        }
+        consumer.index.store(tail, std::memory_order_release);
+        return static_cast<int>(tail - head);
+    }
+
+private:
+    enum { CACHE_LINE = 64 };
+
+    /* The index one side writes, and its copy of the index the other side writes. */
+    struct Side {
+        std::atomic<size_t> index{0};
+        size_t otherIndex = 0;
+        char padding[CACHE_LINE];   // keeps the two sides on different cache lines
+    };
+
+    std::vector<T> slots;
+    size_t mask;
+    Side producer;   // index: where the next event goes
+    Side consumer;   // index: the oldest event not yet removed
+};
+
+#endif // _eventring_h
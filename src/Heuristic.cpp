@@ -0,0 +1,43 @@
+/**
+ * @brief This file implements the lower-bound heuristics that guide the informed
+ * searches in pathfinder.cpp.
+ * @headerfile Heuristic.h
+ * @version 2026/10/16
+ */
+
+#include "Heuristic.h"
+#include "RoadGraph.h"
+#include <algorithm>
+#include <cmath>
+
+CrowFlyHeuristic::CrowFlyHeuristic(const RoadGraph& graph)
+    : compiled(graph.compile()),
+      maxSpeed(graph.maxRoadSpeed()) {
+    // empty
+}
+
+CrowFlyHeuristic::CrowFlyHeuristic(const CompiledRoadGraph& compiled, double maxSpeed)
+    : compiled(compiled),
+      maxSpeed(maxSpeed) {
+    // empty
+}
+
+/* Arcs between nodes at the same spot say nothing about speed and are skipped. */
+StraightLineHeuristic::StraightLineHeuristic(const CompiledRoadGraph& compiled)
+    : compiled(compiled),
+      costPerDistance(INFINITY) {
+    for (int from = 0; from < compiled.nodeCount(); from++) {
+        for (int arc = compiled.firstArc(from); arc < compiled.endArc(from); arc++) {
+            int to = compiled.arcTarget(arc);
+            double dx = compiled.x(from) - compiled.x(to);
+            double dy = compiled.y(from) - compiled.y(to);
+            double length = sqrt(dx * dx + dy * dy);
+            if (length > 0) {
+                costPerDistance = std::min(costPerDistance, compiled.arcCost(arc) / length);
+            }
+        }
+    }
+    if (costPerDistance == INFINITY) {
+        costPerDistance = 0;
+    }
+}
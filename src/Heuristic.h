@@ -0,0 +1,76 @@
+/**
+ * @brief This file declares the lower-bound heuristics that guide the informed
+ * searches in pathfinder.cpp.
+ * @class Heuristic.cpp
+ * @version 2026/10/16
+ */
+
+#ifndef _heuristic_h
+#define _heuristic_h
+
+#include "CompiledRoadGraph.h"
+#include <cmath>
+
+class RoadGraph;
+
+/*
+ * A lower bound on the cost of travelling between two nodes of a compiled road
+ * graph, identified by their dense IDs.
+ */
+class Heuristic {
+public:
+    virtual ~Heuristic() = default;
+
+    /* Returns a lower bound on the cost of the cheapest path from -> to. */
+    virtual double estimate(int from, int to) const = 0;
+};
+
+/*
+ * The original heuristic: the crow-fly distance between the two nodes divided by
+ * the fastest travel rate of any road in the graph.
+ */
+class CrowFlyHeuristic : public Heuristic {
+public:
+    /* Creates the crow-fly bound for the given road graph. */
+    explicit CrowFlyHeuristic(const RoadGraph& graph);
+
+    /*
+     * Creates the crow-fly bound for a compiled graph whose fastest road speed is
+     * known, such as one viewing a binary map (see MappedRoadMap::maxRoadSpeed).
+     */
+    CrowFlyHeuristic(const CompiledRoadGraph& compiled, double maxSpeed);
+
+    double estimate(int from, int to) const override {
+        return compiled.crowFlyDistanceBetween(from, to) / maxSpeed;
+    }
+
+private:
+    const CompiledRoadGraph& compiled;
+    double maxSpeed;
+};
+
+/*
+ * The straight-line distance between the two nodes divided by the fastest speed
+ * of any arc, without the pixel adjustments of the crow-fly bound. Those make
+ * the crow-fly bound overestimate a little along the fastest roads, which the
+ * searches above tolerate but an incremental planner does not. This bound is
+ * consistent: no arc costs less than the drop in the bound across it, and that
+ * stays true when costs rise.
+ */
+class StraightLineHeuristic : public Heuristic {
+public:
+    /* Creates the bound for the current arc costs of the given compiled graph. */
+    explicit StraightLineHeuristic(const CompiledRoadGraph& compiled);
+
+    double estimate(int from, int to) const override {
+        double dx = compiled.x(from) - compiled.x(to);
+        double dy = compiled.y(from) - compiled.y(to);
+        return sqrt(dx * dx + dy * dy) * costPerDistance;
+    }
+
+private:
+    const CompiledRoadGraph& compiled;
+    double costPerDistance;   // the smallest cost of any arc per unit of its length
+};
+
+#endif // _heuristic_h
@@ -0,0 +1,192 @@
+/**
+ * @brief This file implements the incremental planner.
+ * @headerfile IncrementalPlanner.h
+ * @version 2026/10/16
+ */
+
+#include "IncrementalPlanner.h"
+#include "error.h"
+#include <algorithm>
+#include <cmath>
+
+IncrementalPlanner::IncrementalPlanner(RoadGraph& graph, const Heuristic& heuristic,
+                                       int start, int goal)
+    : graph(graph),
+      compiled(graph.compile()),
+      heuristic(heuristic),
+      startNode(start),
+      goalNode(goal),
+      lastStart(start),
+      g(compiled.nodeCount(), INFINITY),
+      rhs(compiled.nodeCount(), INFINITY),
+      open(compiled.nodeCount()) {
+    if (start < 0 || start >= compiled.nodeCount() || goal < 0 || goal >= compiled.nodeCount()) {
+        error("IncrementalPlanner::IncrementalPlanner: node is not in the graph");
+    }
+    rhs[goalNode] = 0;
+    open.pushOrDecrease(goalNode, keyOf(goalNode));
+    graph.addObserver(this);
+}
+
+IncrementalPlanner::~IncrementalPlanner() {
+    graph.removeObserver(this);
+}
+
+void IncrementalPlanner::setStart(int start) {
+    if (start < 0 || start >= compiled.nodeCount()) {
+        error("IncrementalPlanner::setStart: node is not in the graph");
+    }
+    startNode = start;
+}
+
+/*
+ * Changes are only queued here; plan() applies them all at once, so a burst of
+ * updates between two queries costs one repair.
+ */
+void IncrementalPlanner::update(Observable<EdgeCostChange>*, const EdgeCostChange& change) {
+    if (change.arc == -1) {
+        invalidated = true;
+    } else {
+        changedArcs.push_back(change.arc);
+    }
+}
+
+/*
+ * The keys in the open set were computed from an earlier start. Rather than
+ * recomputing them all when the start moves, every later key is raised by the
+ * estimate of the move, which keeps the old keys lower bounds on the new ones;
+ * a node whose key turns out to be stale is put back with its new key when it
+ * comes up.
+ */
+double IncrementalPlanner::plan(std::vector<int>& path) {
+    if (invalidated) {
+        error("IncrementalPlanner::plan: the graph was invalidated");
+    }
+    path.clear();
+    expanded = 0;
+    if (startNode != lastStart) {
+        keyModifier += estimate(lastStart, startNode);
+        lastStart = startNode;
+    }
+    for (int arc : changedArcs) {
+        int target = compiled.arcTarget(arc);
+        for (int inArc = compiled.firstInArc(target); inArc < compiled.endInArc(target); inArc++) {
+            if (compiled.inArcForward(inArc) == arc) {
+                int source = compiled.inArcSource(inArc);
+                recomputeRhs(source);
+                updateNode(source);
+                break;
+            }
+        }
+    }
+    changedArcs.clear();
+    computeShortestPath();
+
+    if (rhs[startNode] == INFINITY) {
+        return INFINITY;
+    }
+
+    /* Follow the cheapest successors down the tree to the goal. */
+    double cost = 0;
+    int current = startNode;
+    path.push_back(current);
+    while (current != goalNode) {
+        int bestArc = -1;
+        double best = INFINITY;
+        for (int arc = compiled.firstArc(current); arc < compiled.endArc(current); arc++) {
+            double through = compiled.arcCost(arc) + g[compiled.arcTarget(arc)];
+            if (through < best) {
+                best = through;
+                bestArc = arc;
+            }
+        }
+        if (bestArc == -1 || static_cast<int>(path.size()) > compiled.nodeCount()) {
+            path.clear();
+            return INFINITY;
+        }
+        cost += compiled.arcCost(bestArc);
+        current = compiled.arcTarget(bestArc);
+        path.push_back(current);
+    }
+    return cost;
+}
+
+double IncrementalPlanner::estimate(int from, int to) const {
+    return std::max(0.0, heuristic.estimate(from, to));
+}
+
+IncrementalPlanner::Key IncrementalPlanner::keyOf(int id) const {
+    double distance = std::min(g[id], rhs[id]);
+    Key key = { distance + estimate(startNode, id) + keyModifier, distance };
+    return key;
+}
+
+void IncrementalPlanner::recomputeRhs(int id) {
+    if (id == goalNode) {
+        return;
+    }
+    double best = INFINITY;
+    for (int arc = compiled.firstArc(id); arc < compiled.endArc(id); arc++) {
+        best = std::min(best, compiled.arcCost(arc) + g[compiled.arcTarget(arc)]);
+    }
+    rhs[id] = best;
+}
+
+/* Keeps a node in the open set exactly while its g and rhs disagree. */
+void IncrementalPlanner::updateNode(int id) {
+    if (g[id] != rhs[id]) {
+        if (open.contains(id)) {
+            open.update(id, keyOf(id));
+        } else {
+            open.pushOrDecrease(id, keyOf(id));
+        }
+    } else if (open.contains(id)) {
+        open.remove(id);
+    }
+}
+
+/*
+ * A node whose rhs is below its g has found a cheaper way to the goal; settling
+ * it can only lower the rhs of its predecessors. A node whose rhs is above its
+ * g has lost its way; its g is forgotten, and the predecessors that went
+ * through it look for the best way again.
+ */
+void IncrementalPlanner::computeShortestPath() {
+    while (!open.isEmpty()
+           && (open.peekPriority() < keyOf(startNode) || rhs[startNode] != g[startNode])) {
+        int current = open.peek();
+        Key oldKey = open.peekPriority();
+        Key newKey = keyOf(current);
+        if (oldKey < newKey) {
+            open.update(current, newKey);
+            continue;
+        }
+        expanded++;
+        if (g[current] > rhs[current]) {
+            g[current] = rhs[current];
+            open.remove(current);
+            for (int inArc = compiled.firstInArc(current);
+                 inArc < compiled.endInArc(current); inArc++) {
+                int predecessor = compiled.inArcSource(inArc);
+                if (predecessor != goalNode) {
+                    rhs[predecessor] = std::min(rhs[predecessor],
+                                                compiled.inArcCost(inArc) + g[current]);
+                }
+                updateNode(predecessor);
+            }
+        } else {
+            double oldG = g[current];
+            g[current] = INFINITY;
+            for (int inArc = compiled.firstInArc(current);
+                 inArc < compiled.endInArc(current); inArc++) {
+                int predecessor = compiled.inArcSource(inArc);
+                if (rhs[predecessor] == compiled.inArcCost(inArc) + oldG) {
+                    recomputeRhs(predecessor);
+                }
+                updateNode(predecessor);
+            }
+            recomputeRhs(current);
+            updateNode(current);
+        }
+    }
+}
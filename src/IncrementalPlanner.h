@@ -0,0 +1,102 @@
+/**
+ * @brief This file declares the incremental planner, which keeps its search
+ * between queries and repairs it when edge costs change.
+ * @class IncrementalPlanner.cpp
+ * @version 2026/10/16
+ */
+
+#ifndef _incrementalplanner_h
+#define _incrementalplanner_h
+
+#include "CompiledRoadGraph.h"
+#include "Heuristic.h"
+#include "IndexedHeap.h"
+#include "RoadGraph.h"
+#include "observable.h"
+#include <vector>
+
+/*
+ * D* Lite: a planner for one goal whose cheapest path is asked for again and
+ * again while edge costs change, such as the route of a vehicle under traffic
+ * updates and closures.
+ *
+ * The planner searches backward from the goal, over the compiled graph of a
+ * RoadGraph, and keeps the resulting tree of distances to the goal between
+ * queries. It watches the graph for cost changes made with
+ * RoadGraph::setEdgeCost or closeEdge, and at the next query repairs only the
+ * part of the tree whose distances the changes affect; a change far from the
+ * route costs next to nothing. The start may also move, as the vehicle
+ * advances, without starting over.
+ *
+ * The heuristic must be consistent, and stay so as the costs change: between
+ * any two nodes joined by an arc, the estimates may differ by no more than the
+ * cost of the arc. A StraightLineHeuristic built before the changes is, as long
+ * as costs only rise, as they do under congestion and closures. The crow-fly
+ * heuristic is not quite consistent and can leave the planner with a stale
+ * route.
+ *
+ * Both the graph and the heuristic must outlive the planner. After
+ * RoadGraph::invalidate() the planner's snapshot is gone, and plan() throws.
+ */
+class IncrementalPlanner : private Observer<EdgeCostChange> {
+public:
+    /* Prepares a planner between two node IDs of graph.compile(). */
+    IncrementalPlanner(RoadGraph& graph, const Heuristic& heuristic, int start, int goal);
+    ~IncrementalPlanner();
+
+    /* The planner is registered with its graph under its own address. */
+    IncrementalPlanner(const IncrementalPlanner&) = delete;
+    IncrementalPlanner& operator =(const IncrementalPlanner&) = delete;
+
+    /* Moves the start, for example to where the vehicle now is. */
+    void setStart(int start);
+
+    /* Returns the start and the goal. */
+    int start() const { return startNode; }
+    int goal() const { return goalNode; }
+
+    /*
+     * Brings the search up to date with the cost changes made since the last
+     * call, then fills path with the node IDs of the cheapest path from the
+     * start to the goal and returns its cost. Returns INFINITY and leaves path
+     * empty if the goal cannot be reached.
+     */
+    double plan(std::vector<int>& path);
+
+    /* Returns the number of nodes the last call to plan() expanded. */
+    int expandedNodes() const { return expanded; }
+
+private:
+    /* The priority of a node: its lower bound first, then its distance to the goal. */
+    struct Key {
+        double bound;
+        double distance;
+
+        bool operator <(const Key& other) const {
+            return bound < other.bound || (bound == other.bound && distance < other.distance);
+        }
+    };
+
+    RoadGraph& graph;
+    const CompiledRoadGraph& compiled;
+    const Heuristic& heuristic;
+    int startNode;
+    int goalNode;
+    int lastStart;                // the start when the keys were last adjusted
+    double keyModifier = 0;       // what the keys have fallen behind by since then
+    std::vector<double> g;        // distance to the goal as last expanded
+    std::vector<double> rhs;      // distance to the goal through the best successor
+    BasicIndexedHeap<Key> open;   // nodes whose g and rhs disagree
+    std::vector<int> changedArcs; // arcs whose cost changed since the last plan()
+    bool invalidated = false;
+    int expanded = 0;
+
+    void update(Observable<EdgeCostChange>* observed, const EdgeCostChange& change) override;
+    double estimate(int from, int to) const;
+    Key keyOf(int id) const;
+    void recomputeRhs(int id);
+    void updateNode(int id);
+    void computeShortestPath();
+};
+
+#endif // _incrementalplanner_h
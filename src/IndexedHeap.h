@@ -0,0 +1,195 @@
+/**
+ * @brief This file declares and implements an indexed priority queue over dense
+ * node IDs, used by the search algorithms for their open sets.
+ * @class IndexedHeap.h
+ * @version 2026/10/16
+ */
+
+#ifndef _indexedheap_h
+#define _indexedheap_h
+
+#include <vector>
+
+/*
+ * A 4-ary min-heap of node IDs in [0, capacity) keyed by a priority of type Key,
+ * which only needs a < operator. The searches key their open sets by a double
+ * and use the IndexedHeap name below.
+ *
+ * Unlike PriorityQueue, every ID appears in the heap at most once, and the heap
+ * remembers where each ID lives so that its priority can be lowered in place
+ * (decrease-key) instead of enqueueing a duplicate. A 4-ary layout keeps the
+ * heap shallower than a binary one, and the four children of a slot sit next to
+ * each other in memory.
+ */
+template <typename Key>
+class BasicIndexedHeap {
+public:
+    /* Creates an empty heap that can hold IDs in [0, capacity). */
+    explicit BasicIndexedHeap(int capacity = 0) {
+        reset(capacity);
+    }
+
+    /* Empties the heap and makes it able to hold IDs in [0, capacity). */
+    void reset(int capacity) {
+        ids.clear();
+        keys.clear();
+        position.assign(capacity, NOT_IN_HEAP);
+    }
+
+    /* Empties the heap in time proportional to its current size. */
+    void clear() {
+        for (int id : ids) {
+            position[id] = NOT_IN_HEAP;
+        }
+        ids.clear();
+        keys.clear();
+    }
+
+    /* Returns whether the heap is empty, and how many IDs it holds. */
+    bool isEmpty() const { return ids.empty(); }
+    int size() const { return static_cast<int>(ids.size()); }
+
+    /* Returns whether the given ID is currently in the heap. */
+    bool contains(int id) const { return position[id] != NOT_IN_HEAP; }
+
+    /* Returns the ID with the smallest priority, and that priority. */
+    int peek() const { return ids[0]; }
+    const Key& peekPriority() const { return keys[0]; }
+
+    /* Returns the current priority of an ID that is in the heap. */
+    const Key& priorityOf(int id) const { return keys[position[id]]; }
+
+    /*
+     * Inserts the ID with the given priority, or, if it is already in the heap
+     * with a larger priority, lowers its priority to the given one.
+     */
+    void pushOrDecrease(int id, const Key& priority) {
+        int slot = position[id];
+        if (slot == NOT_IN_HEAP) {
+            slot = size();
+            ids.push_back(id);
+            keys.push_back(priority);
+            position[id] = slot;
+        } else if (priority < keys[slot]) {
+            keys[slot] = priority;
+        } else {
+            return;
+        }
+        siftUp(slot);
+    }
+
+    /* Changes the priority of an ID that is in the heap, in either direction. */
+    void update(int id, const Key& priority) {
+        int slot = position[id];
+        Key old = keys[slot];
+        keys[slot] = priority;
+        if (priority < old) {
+            siftUp(slot);
+        } else {
+            siftDown(slot);
+        }
+    }
+
+    /* Removes and returns the ID with the smallest priority. */
+    int pop() {
+        int top = ids[0];
+        position[top] = NOT_IN_HEAP;
+        int last = size() - 1;
+        if (last > 0) {
+            ids[0] = ids[last];
+            keys[0] = keys[last];
+            position[ids[0]] = 0;
+        }
+        ids.pop_back();
+        keys.pop_back();
+        if (last > 1) {
+            siftDown(0);
+        }
+        return top;
+    }
+
+    /* Removes an ID that is in the heap, wherever it is. */
+    void remove(int id) {
+        int slot = position[id];
+        position[id] = NOT_IN_HEAP;
+        int last = size() - 1;
+        if (slot == last) {
+            ids.pop_back();
+            keys.pop_back();
+            return;
+        }
+        Key old = keys[slot];
+        moveTo(last, slot);
+        ids.pop_back();
+        keys.pop_back();
+        if (keys[slot] < old) {
+            siftUp(slot);
+        } else {
+            siftDown(slot);
+        }
+    }
+
+private:
+    enum { NOT_IN_HEAP = -1, ARITY = 4 };
+
+    std::vector<int> ids;       // heap-ordered IDs
+    std::vector<Key> keys;      // priority of the ID in the same slot
+    std::vector<int> position;  // slot of each ID, or NOT_IN_HEAP
+
+    void siftUp(int slot) {
+        int id = ids[slot];
+        Key key = keys[slot];
+        while (slot > 0) {
+            int parent = (slot - 1) / ARITY;
+            if (!(key < keys[parent])) {
+                break;
+            }
+            moveTo(parent, slot);
+            slot = parent;
+        }
+        place(id, key, slot);
+    }
+
+    void siftDown(int slot) {
+        int id = ids[slot];
+        Key key = keys[slot];
+        int count = size();
+        while (true) {
+            int first = slot * ARITY + 1;
+            if (first >= count) {
+                break;
+            }
+            int last = first + ARITY < count ? first + ARITY : count;
+            int best = first;
+            for (int child = first + 1; child < last; child++) {
+                if (keys[child] < keys[best]) {
+                    best = child;
+                }
+            }
+            if (!(keys[best] < key)) {
+                break;
+            }
+            moveTo(best, slot);
+            slot = best;
+        }
+        place(id, key, slot);
+    }
+
+    /* Moves the entry in slot from into slot to. */
+    void moveTo(int from, int to) {
+        ids[to] = ids[from];
+        keys[to] = keys[from];
+        position[ids[to]] = to;
+    }
+
+    void place(int id, const Key& key, int slot) {
+        ids[slot] = id;
+        keys[slot] = key;
+        position[id] = slot;
+    }
+};
+
+/* The heap of the searches, keyed by a double priority. */
+typedef BasicIndexedHeap<double> IndexedHeap;
+
+#endif // _indexedheap_h
@@ -0,0 +1,331 @@
+/**
+ * @brief This file implements the landmark (ALT) heuristic, a lower bound built from
+ * precomputed distances to and from a handful of landmark nodes.
+ * @headerfile LandmarkHeuristic.h
+ * @version 2026/10/16
+ */
+
+#include "LandmarkHeuristic.h"
+#include "IndexedHeap.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <random>
+
+const int LandmarkHeuristic::DEFAULT_LANDMARK_COUNT = 8;
+
+namespace {
+
+/* The first bytes of a landmark file, and the version of its layout. */
+const char MAGIC[8] = { 'P', 'F', 'L', 'A', 'N', 'D', 'M', 'K' };
+const uint32_t FORMAT_VERSION = 1;
+
+/* The arcs a distance search follows. */
+enum Direction { FORWARD = 1, BACKWARD = 2, BOTH = FORWARD | BACKWARD };
+
+/*
+ * Fills dist with the cost of the cheapest path from the given sources to every
+ * node. The search follows the leaving arcs, the entering arcs (so that dist[v]
+ * becomes the cost from v to the sources), or both, in which case the graph is
+ * treated as undirected. If order is given, it receives the nodes in the order
+ * they were settled and parent receives the node each was reached from.
+ */
+void dijkstra(const CompiledRoadGraph& graph, const std::vector<int>& sources, int direction,
+              std::vector<double>& dist, std::vector<int>* order = nullptr,
+              std::vector<int>* parent = nullptr) {
+    int n = graph.nodeCount();
+    dist.assign(n, INFINITY);
+    if (parent) {
+        parent->assign(n, -1);
+    }
+    if (order) {
+        order->clear();
+    }
+    IndexedHeap open(n);
+    for (int source : sources) {
+        dist[source] = 0;
+        open.pushOrDecrease(source, 0);
+    }
+    auto relax = [&](int from, int to, double cost) {
+        double d = dist[from] + cost;
+        if (d < dist[to]) {
+            dist[to] = d;
+            if (parent) {
+                (*parent)[to] = from;
+            }
+            open.pushOrDecrease(to, d);
+        }
+    };
+    while (!open.isEmpty()) {
+        int current = open.pop();
+        if (order) {
+            order->push_back(current);
+        }
+        if (direction & FORWARD) {
+            for (int arc = graph.firstArc(current); arc < graph.endArc(current); arc++) {
+                relax(current, graph.arcTarget(arc), graph.arcCost(arc));
+            }
+        }
+        if (direction & BACKWARD) {
+            for (int in = graph.firstInArc(current); in < graph.endInArc(current); in++) {
+                relax(current, graph.inArcSource(in), graph.inArcCost(in));
+            }
+        }
+    }
+}
+
+/* An FNV-1a hash of the graph's shape and costs, so that stale tables are rejected. */
+uint64_t checksum(const CompiledRoadGraph& graph) {
+    uint64_t hash = 1469598103934665603ULL;
+    auto mix = [&](const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; i++) {
+            hash = (hash ^ bytes[i]) * 1099511628211ULL;
+        }
+    };
+    for (int id = 0; id < graph.nodeCount(); id++) {
+        int32_t degree = graph.endArc(id) - graph.firstArc(id);
+        mix(&degree, sizeof(degree));
+        for (int arc = graph.firstArc(id); arc < graph.endArc(id); arc++) {
+            int32_t target = graph.arcTarget(arc);
+            double cost = graph.arcCost(arc);
+            mix(&target, sizeof(target));
+            mix(&cost, sizeof(cost));
+        }
+    }
+    return hash;
+}
+
+template <typename T>
+void writeValue(std::ostream& output, const T& value) {
+    output.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readValue(std::istream& input, T& value) {
+    return static_cast<bool>(input.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+} // namespace
+
+LandmarkHeuristic::LandmarkHeuristic(const CompiledRoadGraph& graph, int count,
+                                     Selection selection)
+    : graph(graph) {
+    int wanted = std::min(count, graph.nodeCount());
+    landmarks.reserve(wanted);
+    while (this->count < wanted) {
+        int before = this->count;
+        if (selection == Selection::AVOID && this->count > 0) {
+            selectAvoid();
+        } else {
+            selectFarthest();
+        }
+        if (this->count == before) {
+            break;   // every node is already a landmark
+        }
+    }
+}
+
+LandmarkHeuristic::LandmarkHeuristic(const CompiledRoadGraph& graph, bool /* empty */)
+    : graph(graph) {
+    // empty
+}
+
+/*
+ * The largest triangle-inequality bound over all landmarks. A landmark that one
+ * of the nodes cannot reach (or be reached from) says nothing about the pair, so
+ * its infinite terms are skipped rather than allowed to produce NaN or -INFINITY.
+ */
+double LandmarkHeuristic::estimate(int from, int to) const {
+    const double* fromV = fromLandmark.data() + static_cast<size_t>(from) * count;
+    const double* toV = toLandmark.data() + static_cast<size_t>(from) * count;
+    const double* fromT = fromLandmark.data() + static_cast<size_t>(to) * count;
+    const double* toT = toLandmark.data() + static_cast<size_t>(to) * count;
+    double best = 0;
+    for (int i = 0; i < count; i++) {
+        if (toV[i] != INFINITY && toT[i] != INFINITY) {
+            best = std::max(best, toV[i] - toT[i]);
+        }
+        if (fromT[i] != INFINITY && fromV[i] != INFINITY) {
+            best = std::max(best, fromT[i] - fromV[i]);
+        }
+    }
+    return best;
+}
+
+/*
+ * Farthest selection: the first landmark is the node farthest from node 0, and
+ * every later one is the node farthest from all landmarks picked so far, with the
+ * graph treated as undirected. A node that no landmark reaches at all is picked
+ * first, since otherwise its component would get no bound.
+ */
+void LandmarkHeuristic::selectFarthest() {
+    std::vector<int> sources = landmarks;
+    if (sources.empty()) {
+        sources.push_back(0);
+    }
+    std::vector<double> dist;
+    dijkstra(graph, sources, BOTH, dist);
+    int farthest = -1;
+    for (int id = 0; id < graph.nodeCount(); id++) {
+        if (farthest == -1 || dist[id] > dist[farthest]) {
+            farthest = id;
+        }
+    }
+    if (farthest != -1 && (dist[farthest] > 0 || landmarks.empty())) {
+        addLandmark(farthest);
+    }
+}
+
+/*
+ * Avoid selection (Goldberg and Werneck): grow a shortest path tree from a random
+ * root and weigh every node by how badly the current landmarks bound its distance
+ * from the root, d(root, v) - estimate(root, v). A subtree that already contains a
+ * landmark weighs nothing. Starting at the root, repeatedly step to the heaviest
+ * child; the leaf this reaches lies behind the region the landmarks cover worst.
+ */
+void LandmarkHeuristic::selectAvoid() {
+    std::mt19937 random(static_cast<unsigned>(count) * 2654435761U + 1);
+    int root = std::uniform_int_distribution<int>(0, graph.nodeCount() - 1)(random);
+
+    std::vector<double> dist;
+    std::vector<int> order, parent;
+    dijkstra(graph, std::vector<int>(1, root), FORWARD, dist, &order, &parent);
+
+    int n = graph.nodeCount();
+    std::vector<double> size(n, 0);
+    std::vector<char> covered(n, 0);
+    std::vector<int> heaviest(n, -1);
+    for (int landmark : landmarks) {
+        covered[landmark] = 1;
+    }
+    // children are settled after their parents, so walking the settle order
+    // backwards finishes every subtree before its parent is visited
+    for (int i = static_cast<int>(order.size()) - 1; i >= 0; i--) {
+        int v = order[i];
+        size[v] += dist[v] - estimate(root, v);
+        if (covered[v]) {
+            size[v] = 0;
+        }
+        int p = parent[v];
+        if (p != -1) {
+            size[p] += size[v];
+            covered[p] |= covered[v];
+            if (heaviest[p] == -1 || size[v] > size[heaviest[p]]) {
+                heaviest[p] = v;
+            }
+        }
+    }
+
+    int leaf = root;
+    while (heaviest[leaf] != -1 && size[heaviest[leaf]] > 0) {
+        leaf = heaviest[leaf];
+    }
+    if (leaf == root || covered[leaf]) {
+        selectFarthest();   // the tree from this root is already well covered
+    } else {
+        addLandmark(leaf);
+    }
+}
+
+/* Computes the distance tables of a new landmark and interleaves them by node. */
+void LandmarkHeuristic::addLandmark(int id) {
+    std::vector<double> from, to;
+    dijkstra(graph, std::vector<int>(1, id), FORWARD, from);
+    dijkstra(graph, std::vector<int>(1, id), BACKWARD, to);
+
+    int n = graph.nodeCount();
+    int k = count + 1;
+    std::vector<double> newFrom(static_cast<size_t>(n) * k);
+    std::vector<double> newTo(static_cast<size_t>(n) * k);
+    for (int v = 0; v < n; v++) {
+        for (int i = 0; i < count; i++) {
+            newFrom[static_cast<size_t>(v) * k + i] = fromLandmark[static_cast<size_t>(v) * count + i];
+            newTo[static_cast<size_t>(v) * k + i] = toLandmark[static_cast<size_t>(v) * count + i];
+        }
+        newFrom[static_cast<size_t>(v) * k + count] = from[v];
+        newTo[static_cast<size_t>(v) * k + count] = to[v];
+    }
+    fromLandmark.swap(newFrom);
+    toLandmark.swap(newTo);
+    landmarks.push_back(id);
+    count = k;
+}
+
+/*
+ * The file holds a fixed header (magic, format version, node and arc counts, a
+ * checksum of the graph, and the landmark count), the landmark IDs, and then the
+ * two tables exactly as they are laid out in memory.
+ */
+bool LandmarkHeuristic::save(const std::string& filename) const {
+    std::ofstream output(filename.c_str(), std::ios::binary | std::ios::trunc);
+    if (!output) {
+        return false;
+    }
+    output.write(MAGIC, sizeof(MAGIC));
+    writeValue(output, FORMAT_VERSION);
+    writeValue(output, static_cast<int32_t>(graph.nodeCount()));
+    writeValue(output, static_cast<int32_t>(graph.arcCount()));
+    writeValue(output, checksum(graph));
+    writeValue(output, static_cast<int32_t>(count));
+    for (int landmark : landmarks) {
+        writeValue(output, static_cast<int32_t>(landmark));
+    }
+    output.write(reinterpret_cast<const char*>(fromLandmark.data()),
+                 fromLandmark.size() * sizeof(double));
+    output.write(reinterpret_cast<const char*>(toLandmark.data()),
+                 toLandmark.size() * sizeof(double));
+    return static_cast<bool>(output.flush());
+}
+
+bool LandmarkHeuristic::load(const std::string& filename) {
+    std::ifstream input(filename.c_str(), std::ios::binary);
+    if (!input) {
+        return false;
+    }
+    char magic[sizeof(MAGIC)];
+    uint32_t version;
+    int32_t nodes, arcs, k;
+    uint64_t sum;
+    if (!input.read(magic, sizeof(magic)) || memcmp(magic, MAGIC, sizeof(MAGIC)) != 0
+            || !readValue(input, version) || version != FORMAT_VERSION
+            || !readValue(input, nodes) || nodes != graph.nodeCount()
+            || !readValue(input, arcs) || arcs != graph.arcCount()
+            || !readValue(input, sum) || sum != checksum(graph)
+            || !readValue(input, k) || k < 0 || k > nodes) {
+        return false;
+    }
+    std::vector<int> ids(k);
+    for (int i = 0; i < k; i++) {
+        int32_t id;
+        if (!readValue(input, id) || id < 0 || id >= nodes) {
+            return false;
+        }
+        ids[i] = id;
+    }
+    size_t entries = static_cast<size_t>(nodes) * k;
+    std::vector<double> from(entries), to(entries);
+    if (!input.read(reinterpret_cast<char*>(from.data()), entries * sizeof(double))
+            || !input.read(reinterpret_cast<char*>(to.data()), entries * sizeof(double))) {
+        return false;
+    }
+    landmarks.swap(ids);
+    fromLandmark.swap(from);
+    toLandmark.swap(to);
+    count = k;
+    return true;
+}
+
+LandmarkHeuristic* LandmarkHeuristic::loadOrBuild(const CompiledRoadGraph& graph,
+                                                  const std::string& filename, int count) {
+    LandmarkHeuristic* stored = new LandmarkHeuristic(graph, true);
+    if (stored->load(filename) && stored->count == std::min(count, graph.nodeCount())) {
+        return stored;
+    }
+    delete stored;
+    LandmarkHeuristic* built = new LandmarkHeuristic(graph, count);
+    built->save(filename);
+    return built;
+}
@@ -0,0 +1,85 @@
+/**
+ * @brief This file declares the landmark (ALT) heuristic, a lower bound built from
+ * precomputed distances to and from a handful of landmark nodes.
+ * @class LandmarkHeuristic.cpp
+ * @version 2026/10/16
+ */
+
+#ifndef _landmarkheuristic_h
+#define _landmarkheuristic_h
+
+#include "Heuristic.h"
+#include <string>
+#include <vector>
+
+/*
+ * The ALT ("A*, landmarks, triangle inequality") heuristic.
+ *
+ * For every landmark L the table holds the cost d(L, v) from L to each node and
+ * the cost d(v, L) from each node back to L. By the triangle inequality,
+ *
+ *     d(v, t) >= d(v, L) - d(t, L)    and    d(v, t) >= d(L, t) - d(L, v)
+ *
+ * and the estimate is the largest of these bounds over all landmarks. Unlike the
+ * crow-fly bound it does not depend on the single fastest road in the map, and
+ * it is exact whenever a landmark lies behind the target.
+ */
+class LandmarkHeuristic : public Heuristic {
+public:
+    /* The ways the landmarks can be picked. */
+    enum class Selection {
+        FARTHEST,   // each landmark is the node farthest from those picked so far
+        AVOID       // each landmark is the leaf of the worst-covered shortest path subtree
+    };
+
+    /* The number of landmarks used when the caller does not ask for a count. */
+    static const int DEFAULT_LANDMARK_COUNT;
+
+    /* Picks count landmarks in the graph and computes their distance tables. */
+    LandmarkHeuristic(const CompiledRoadGraph& graph, int count = DEFAULT_LANDMARK_COUNT,
+                      Selection selection = Selection::AVOID);
+
+    double estimate(int from, int to) const override;
+
+    /* Returns the number of landmarks, and the node ID of each. */
+    int landmarkCount() const { return count; }
+    int landmark(int i) const { return landmarks[i]; }
+
+    /*
+     * Writes the tables to the given file. Returns false if the file could not
+     * be written.
+     */
+    bool save(const std::string& filename) const;
+
+    /*
+     * Replaces the tables with the ones stored in the given file. Returns false,
+     * and leaves the tables alone, if the file is missing, corrupt, or was built
+     * for a different graph.
+     */
+    bool load(const std::string& filename);
+
+    /*
+     * Returns the tables stored in filename if they match the graph; otherwise
+     * builds them and stores them there for the next run. The caller owns the
+     * returned heuristic.
+     */
+    static LandmarkHeuristic* loadOrBuild(const CompiledRoadGraph& graph,
+                                          const std::string& filename,
+                                          int count = DEFAULT_LANDMARK_COUNT);
+
+private:
+    /* Creates an empty table for the graph, to be filled by load. */
+    explicit LandmarkHeuristic(const CompiledRoadGraph& graph, bool /* empty */);
+
+    const CompiledRoadGraph& graph;
+    int count = 0;
+    std::vector<int> landmarks;
+    std::vector<double> fromLandmark;   // d(L, v) at [v * count + i]
+    std::vector<double> toLandmark;     // d(v, L) at [v * count + i]
+
+    void selectFarthest();
+    void selectAvoid();
+    void addLandmark(int id);
+};
+
+#endif // _landmarkheuristic_h
@@ -0,0 +1,76 @@
+/**
+ * @brief This file implements the one-to-all search.
+ * @headerfile OneToAllSearch.h
+ * @version 2026/10/16
+ */
+
+#include "OneToAllSearch.h"
+#include "error.h"
+#include <algorithm>
+
+OneToAllSearch::OneToAllSearch(const CompiledRoadGraph& compiled)
+    : compiled(compiled),
+      distances(compiled.nodeCount(), INFINITY),
+      predecessors(compiled.nodeCount(), -1),
+      open(compiled.nodeCount()) {
+    // empty
+}
+
+void OneToAllSearch::run(int source, double budget) {
+    run(std::vector<int>(1, source), budget);
+}
+
+/*
+ * Successors beyond the budget never enter the open set, so the search ends when
+ * the open set runs dry, and every node it touched is settled by then. That keeps
+ * the list of settled nodes a complete record of what reset() has to undo.
+ */
+void OneToAllSearch::run(const std::vector<int>& sources, double budget) {
+    for (int source : sources) {
+        if (source < 0 || source >= compiled.nodeCount()) {
+            error("OneToAllSearch::run: source node is not in the graph");
+        }
+    }
+    reset();
+    for (int source : sources) {
+        if (budget >= 0 && distances[source] != 0) {
+            distances[source] = 0;
+            open.pushOrDecrease(source, 0);
+        }
+    }
+
+    while (!open.isEmpty()) {
+        int current = open.pop();
+        settled.push_back(current);
+        double current_distance = distances[current];
+        for (int arc = compiled.firstArc(current); arc < compiled.endArc(current); arc++) {
+            int successor = compiled.arcTarget(arc);
+            double successor_distance = current_distance + compiled.arcCost(arc);
+            if (successor_distance < distances[successor] && successor_distance <= budget) {
+                distances[successor] = successor_distance;
+                predecessors[successor] = current;
+                open.pushOrDecrease(successor, successor_distance);
+            }
+        }
+    }
+}
+
+void OneToAllSearch::pathTo(int id, std::vector<int>& path) const {
+    path.clear();
+    if (distances[id] == INFINITY) {
+        return;
+    }
+    for (int v = id; v != -1; v = predecessors[v]) {
+        path.push_back(v);
+    }
+    std::reverse(path.begin(), path.end());
+}
+
+void OneToAllSearch::reset() {
+    for (int id : settled) {
+        distances[id] = INFINITY;
+        predecessors[id] = -1;
+    }
+    settled.clear();
+    open.clear();
+}
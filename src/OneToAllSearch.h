@@ -0,0 +1,76 @@
+/**
+ * @brief This file declares the one-to-all search, which finds the cheapest path
+ * from one or more sources to every node within a cost budget.
+ * @class OneToAllSearch.cpp
+ * @version 2026/10/16
+ */
+
+#ifndef _onetoallsearch_h
+#define _onetoallsearch_h
+
+#include "CompiledRoadGraph.h"
+#include "IndexedHeap.h"
+#include <cmath>
+#include <vector>
+
+/*
+ * Dijkstra's algorithm from a set of sources to every node whose distance is
+ * within a budget (an isochrone), over a compiled graph.
+ *
+ * A run leaves behind a dense distance array, INFINITY for the nodes outside the
+ * budget, and a predecessor tree whose roots are the sources. The arrays belong
+ * to the search and are reused from one run to the next: a run only resets the
+ * entries the previous run wrote, so a worker that keeps one OneToAllSearch pays
+ * for the allocation once and for each run in proportion to the area it covers.
+ *
+ * The search only reads the graph, so several searches, one per thread, may run
+ * on the same graph at once.
+ */
+class OneToAllSearch {
+public:
+    /* Prepares a search over the given graph. */
+    explicit OneToAllSearch(const CompiledRoadGraph& compiled);
+
+    /*
+     * Finds the distance from source to every node that is at most budget away.
+     * Nodes further away are left unreached and the search stops as soon as none
+     * are left within the budget.
+     */
+    void run(int source, double budget = INFINITY);
+
+    /*
+     * Same as above, but from several sources at once: each node gets its distance
+     * to the nearest source, and its predecessor chain leads back to that source.
+     */
+    void run(const std::vector<int>& sources, double budget = INFINITY);
+
+    /* Returns the distance of a node from the last run's sources, or INFINITY. */
+    double distance(int id) const { return distances[id]; }
+
+    /* Returns the node a node was reached from, or -1 for sources and unreached nodes. */
+    int predecessor(int id) const { return predecessors[id]; }
+
+    /* Returns the distances and predecessors of all nodes, indexed by node ID. */
+    const std::vector<double>& distanceArray() const { return distances; }
+    const std::vector<int>& predecessorArray() const { return predecessors; }
+
+    /* Returns the nodes within the budget, in the order of their distance. */
+    const std::vector<int>& reachedNodes() const { return settled; }
+
+    /*
+     * Fills path with the node IDs of the cheapest path from the nearest source to
+     * the given node, or leaves it empty if the node was not reached.
+     */
+    void pathTo(int id, std::vector<int>& path) const;
+
+private:
+    const CompiledRoadGraph& compiled;
+    std::vector<double> distances;
+    std::vector<int> predecessors;
+    std::vector<int> settled;   // nodes the last run wrote, in settling order
+    IndexedHeap open;
+
+    void reset();
+};
+
+#endif // _onetoallsearch_h
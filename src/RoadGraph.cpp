@@ -2,13 +2,21 @@
  * @brief This file implements the graph type used in Project Pathfinder.
  * @headerfile RoadGraph.h
  * @author Richik Vivek Sen
+ * @version 2026/10/17
+ * - added the compiled snapshot, the contraction hierarchy, the customizable
+ *   hierarchies for the costs and the second metric, and the spatial index,
+ *   built when first asked for
+ * - added graph versions, invalidate() and edge cost updates
+ * - nodes know their dense index; edges carry a travel time profile and a
+ *   second metric
  * @version 2019/04/08
- * @attention Do not modify this file.
  */
 
 
 #include "RoadGraph.h"
 #include "point.h"
+#include "error.h"
+#include <atomic>
 #include <math.h>
 #include <sstream>
 
@@ -25,6 +33,15 @@ namespace {
          */
         return fmax(sqrt(dx * dx + dy * dy), 0) - 1;
     }
+
+    /*
+     * Hands out graph versions; shared by all graphs so that a new graph never
+     * reuses the version of one that came before it.
+     */
+    unsigned nextGraphVersion() {
+        static std::atomic<unsigned> lastVersion(0);
+        return ++lastVersion;
+    }
 }
 
 /* Constructs a new road node with the given name. */
@@ -63,8 +80,9 @@ std::string RoadNode::toString() const {
 }
 
 /* Constructs a new edge. */
-RoadEdge::RoadEdge(RoadNode* start, RoadNode* finish, double edgeCost)
-    : start(start), finish(finish), edgeCost(edgeCost) {
+RoadEdge::RoadEdge(RoadNode* start, RoadNode* finish, double edgeCost, int profile,
+                   double metric2)
+    : start(start), finish(finish), edgeCost(edgeCost), profile(profile), metric2(metric2) {
     // Everything else handled by default
 }
 
@@ -73,6 +91,16 @@ double RoadEdge::cost() const {
     return edgeCost;
 }
 
+/* Returns the travel time profile of the edge. */
+int RoadEdge::travelTimeProfile() const {
+    return profile;
+}
+
+/* Returns the second metric of the edge. */
+double RoadEdge::secondMetric() const {
+    return metric2;
+}
+
 /* Returns which node the edge leaves from. */
 RoadNode* RoadEdge::from() const {
     return start;
@@ -96,6 +124,7 @@ std::string RoadEdge::toString() const {
  */
 RoadGraph::RoadGraph(Graph<RoadNode, RoadEdge>* data) {
     this->data = data;
+    myVersion = nextGraphVersion();
 }
 
 /*
@@ -129,32 +158,173 @@ double RoadGraph::crowFlyDistanceBetween(RoadNode* start, RoadNode* end) const {
 double RoadGraph::maxRoadSpeed() const {
     if(maxRateCached) return maxRate;
 
-    /* Look at every edge in the network and find the one that has the highest travel rate. */
-    for(RoadEdge* edge: data->getArcSet()) {
-        /* Travel time is equal to the edge cost. */
-        double time = edge->cost();
+    /* Look at every edge in the network and find the one that has the highest travel rate.
+     * The edges are visited node by node, which spares a hashed Graph from building its
+     * ordered set of all edges.
+     */
+    for(RoadNode* node: *data) {
+        for(RoadEdge* edge: data->getArcSet(node)) {
+            /* Travel time is equal to the edge cost. */
+            double time = edge->cost();
 
-        /* Compute the distance between the two points. */
-        Point a = edge->from()->location();
-        Point b = edge->to()->location();
+            /* Compute the distance between the two points. */
+            Point a = edge->from()->location();
+            Point b = edge->to()->location();
 
-        /*
-         * FIXME: This subtracts 1 twice: once in pointDistance and once here.
-         *        Is this intentional?
-         * FIXME: Is this necessary?
-         */
-        double dist = pointDistance(a, b) - 1;
+            /*
+             * FIXME: This subtracts 1 twice: once in pointDistance and once here.
+             *        Is this intentional?
+             * FIXME: Is this necessary?
+             */
+            double dist = pointDistance(a, b) - 1;
 
-        /*
-         * FIXME: Is this necessary?
-         */
-        if (dist <= 3) continue;
+            /*
+             * FIXME: Is this necessary?
+             */
+            if (dist <= 3) continue;
 
-        double rate = dist / time;
-        if(rate > maxRate) {
-            maxRate = rate;
+            double rate = dist / time;
+            if(rate > maxRate) {
+                maxRate = rate;
+            }
         }
     }
     maxRateCached = true;
     return maxRate;
 }
+
+/*
+ * Builds the CSR snapshot of the graph on first use.
+ */
+const CompiledRoadGraph& RoadGraph::compile() const {
+    if (!compiled) {
+        compiled.reset(new CompiledRoadGraph(*data));
+    }
+    return *compiled;
+}
+
+/*
+ * Builds the contraction hierarchy on first use, or the customizable one once
+ * costs have changed, and brings the latter up to date with the costs.
+ */
+const ContractionHierarchy& RoadGraph::hierarchy() const {
+    if (!costsChanged) {
+        if (!contracted) {
+            contracted.reset(new ContractionHierarchy(compile()));
+        }
+        return *contracted;
+    }
+    if (!customizable) {
+        customizable.reset(new CustomizableHierarchy(compile()));
+    } else if (customizedVersion != myVersion) {
+        customizable->customize();
+    }
+    customizedVersion = myVersion;
+    return customizable->hierarchy();
+}
+
+/*
+ * Builds the customizable hierarchy for the second metric on first use. The
+ * constructor customizes it with the costs, which the second metric replaces.
+ */
+const ContractionHierarchy& RoadGraph::secondMetricHierarchy() const {
+    if (!secondCustomizable) {
+        const CompiledRoadGraph& graph = compile();
+        if (!graph.hasSecondMetric()) {
+            error("RoadGraph::secondMetricHierarchy: the map has no second metric");
+        }
+        secondCustomizable.reset(new CustomizableHierarchy(graph));
+        secondCustomizable->customize(graph.secondMetric());
+    }
+    return secondCustomizable->hierarchy();
+}
+
+/*
+ * Builds the spatial index on first use.
+ */
+const SpatialIndex& RoadGraph::spatialIndex() const {
+    if (!located) {
+        located.reset(new SpatialIndex(compile()));
+    }
+    return *located;
+}
+
+/*
+ * Looks the point up in the spatial index.
+ */
+RoadNode* RoadGraph::snapToNearestNode(double x, double y) const {
+    int id = spatialIndex().nearest(x, y);
+    return id == -1 ? nullptr : compile().nodeAt(id);
+}
+
+/*
+ * Returns the version of the graph's contents.
+ */
+unsigned RoadGraph::version() const {
+    return myVersion;
+}
+
+/*
+ * Drops everything derived from the underlying graph and moves to a new version.
+ */
+void RoadGraph::invalidate() {
+    located.reset();
+    contracted.reset();
+    customizable.reset();
+    secondCustomizable.reset();
+    costsChanged = false;
+    compiled.reset();
+    maxRateCached = false;
+    maxRate = 0.0;
+    myVersion = nextGraphVersion();
+    notifyObservers(EdgeCostChange());
+}
+
+/*
+ * Changes the cost of an edge and of its arc in the snapshot, if there is one yet.
+ * Everything is checked before anything changes, so a failed call leaves the
+ * edge, the snapshot and the version as they were.
+ */
+void RoadGraph::setEdgeCost(RoadEdge* edge, double cost) {
+    if (!edge || !data->containsArc(edge)) {
+        error("RoadGraph::setEdgeCost: edge is not in the graph");
+    }
+    if (!(cost >= 0)) {
+        error("RoadGraph::setEdgeCost: cost must be non-negative");
+    }
+    EdgeCostChange change;
+    if (compiled) {
+        change.arc = compiled->arcOf(edge);
+        if (change.arc == -1) {
+            error("RoadGraph::setEdgeCost: edge was added after the graph was compiled");
+        }
+    }
+    edge->edgeCost = cost;
+    contracted.reset();
+    costsChanged = true;
+    maxRateCached = false;
+    maxRate = 0.0;
+    myVersion = nextGraphVersion();
+    if (compiled) {
+        compiled->setArcCost(change.arc, cost);
+        notifyObservers(change);
+    }
+}
+
+/*
+ * Closes an edge and the edge back, if there is one, checking both before
+ * closing either.
+ */
+void RoadGraph::closeEdge(RoadEdge* edge) {
+    if (!edge || !data->containsArc(edge)) {
+        error("RoadGraph::closeEdge: edge is not in the graph");
+    }
+    RoadEdge* back = data->getArc(edge->to(), edge->from());
+    if (compiled && (compiled->arcOf(edge) == -1 || (back && compiled->arcOf(back) == -1))) {
+        error("RoadGraph::closeEdge: edge was added after the graph was compiled");
+    }
+    setEdgeCost(edge, INFINITY);
+    if (back) {
+        setEdgeCost(back, INFINITY);
+    }
+}
@@ -2,8 +2,15 @@
  * @brief This file declares the graph type used in Project Pathfinder.
  * @class RoadGraph.cpp
  * @author Richik Vivek Sen
+ * @version 2026/10/17
+ * - added the compiled snapshot, the contraction hierarchy, the customizable
+ *   hierarchies for the costs and the second metric, and the spatial index,
+ *   built when first asked for
+ * - added graph versions, invalidate() and edge cost updates
+ * - nodes know their dense index; edges carry a travel time profile and a
+ *   second metric
+ * - road graphs use the hashed indexing and arena storage of Graph
  * @version 2019/04/08
- * @attention Do not modify this file.
  */
 
 #pragma once
@@ -13,6 +20,11 @@
 #include "point.h"
 #include "observable.h"
 #include "Color.h"
+#include "CompiledRoadGraph.h"
+#include "ContractionHierarchy.h"
+#include "CustomizableHierarchy.h"
+#include "SpatialIndex.h"
+#include <memory>
 #include <string>
 
 /* Forward declarations of the relevant types so that RoadNode can reference RoadEdge
@@ -61,14 +73,17 @@ private:
     std::string name;
     Point myLocation;
     Set<RoadEdge*> arcs;
+    int index = -1;   // dense ID in the graph that holds this node
 };
 
 class RoadEdge {
 public:
     /* Constructs a new edge from the start node to the destination node that has the
-     * given cost.
+     * given cost and, optionally, travel time profile (see TravelTimeProfiles.h) and
+     * second metric.
      */
-    RoadEdge(RoadNode* start, RoadNode* finish, double edgeCost);
+    RoadEdge(RoadNode* start, RoadNode* finish, double edgeCost, int profile = -1,
+             double metric2 = -1);
 
     /* Returns the node at which this edge begins. */
     RoadNode* from() const;
@@ -79,6 +94,15 @@ public:
     /* Returns the cost of this edge. */
     double cost() const;
 
+    /* Returns the ID of this edge's travel time profile, or -1 if its cost is fixed. */
+    int travelTimeProfile() const;
+
+    /* Returns the second metric of this edge, a cost it has besides its cost() (such
+     * as a length where the cost is a travel time), or -1 if it has none. Setting the
+     * edge's cost does not change it.
+     */
+    double secondMetric() const;
+
     /* Returns a human-readable representation of this edge. */
     std::string toString() const;
 
@@ -95,9 +119,33 @@ private:
     RoadNode* start = nullptr;
     RoadNode* finish = nullptr;
     double edgeCost;
+    int profile = -1;
+    double metric2 = -1;
+};
+
+/* Road graphs are built from large maps, so they use the hashed Graph indexing and keep
+ * their nodes and edges in an arena.
+ */
+template <>
+struct GraphIndexing<RoadNode> {
+    enum { HASHED = 1 };
+};
+
+template <>
+struct GraphStorage<RoadNode> {
+    enum { ARENA = 1 };
+};
+
+/*
+ * What a RoadGraph tells its observers when its costs change: the arc of the
+ * compiled snapshot whose cost changed, or -1 when the snapshot itself has been
+ * thrown away by invalidate().
+ */
+struct EdgeCostChange {
+    int arc = -1;
 };
 
-class RoadGraph {
+class RoadGraph: public Observable<EdgeCostChange> {
 public:
     /*
      * Makes a new RoadGraph based on BasicGraph data
@@ -128,11 +176,115 @@ public:
      */
     double crowFlyDistanceBetween(RoadNode* start, RoadNode* end) const;
 
+    /*
+     * Freezes the underlying graph into a compressed-sparse-row snapshot
+     * that the search algorithms expand nodes from. The snapshot is built
+     * the first time this is called and reused afterwards, so changes made
+     * to the underlying graph after that point are not reflected in it.
+     */
+    const CompiledRoadGraph& compile() const;
+
+    /*
+     * Returns the contraction hierarchy of the compiled graph, running the
+     * preprocessing the first time it is asked for.
+     *
+     * Once an edge cost has been changed with setEdgeCost, this returns a
+     * customizable hierarchy instead (see CustomizableHierarchy.h): its structure
+     * is built once, and the next call after each later change only re-weights it
+     * with the new costs, which is far cheaper than contracting the graph again.
+     * Re-weighting keeps the same object, but the switch to it and invalidate()
+     * do not, so holders of the reference should check version().
+     */
+    const ContractionHierarchy& hierarchy() const;
+
+    /*
+     * Returns a customizable hierarchy customized with the second metric of the
+     * arcs (see CompiledRoadGraph::secondMetric) rather than their costs, building
+     * it the first time it is asked for. It is kept apart from hierarchy(), so that
+     * searches can use either metric of the map without re-weighting the other.
+     * Changing edge costs does not affect it; invalidate() throws it away.
+     *
+     * Throws an ErrorException if the map has no second metric.
+     */
+    const ContractionHierarchy& secondMetricHierarchy() const;
+
+    /*
+     * Returns the grid over the node locations of the compiled graph (see
+     * SpatialIndex.h), building it the first time it is asked for. Its IDs
+     * are those of compile().
+     */
+    const SpatialIndex& spatialIndex() const;
+
+    /*
+     * Returns the node closest to the given point on the screen, or nullptr if
+     * the graph has no nodes. This needs no display, so headless callers can
+     * turn coordinates into nodes with it.
+     */
+    RoadNode* snapToNearestNode(double x, double y) const;
+
+    /*
+     * Returns a number that identifies the current contents of the graph, for
+     * tagging results computed on it (see RouteCache). Versions only ever grow:
+     * every RoadGraph starts with a version no earlier graph has had, and
+     * invalidate() moves it to a new one.
+     */
+    unsigned version() const;
+
+    /*
+     * Tells the graph that its underlying data has been edited. This throws away
+     * the snapshot, the hierarchy, the spatial index and the cached maximum speed,
+     * so the next call to compile(), hierarchy() or spatialIndex() rebuilds them,
+     * and bumps the version. References to the old snapshot, hierarchy or index
+     * must not be used afterwards.
+     */
+    void invalidate();
+
+    /*
+     * Changes the cost of an edge, for instance to follow traffic. Unlike other
+     * edits, this keeps the compiled snapshot, whose arc is updated in place, and
+     * tells the observers which arc changed, so that incremental planners (see
+     * IncrementalPlanner.h) can repair their searches. The hierarchy is re-weighted
+     * on its next use (see hierarchy()), the cached maximum speed is thrown away,
+     * and the version moves on, as in invalidate(). Heuristics built before the
+     * change are not updated: one that depends on the costs may overestimate once
+     * a cost has been lowered.
+     */
+    void setEdgeCost(RoadEdge* edge, double cost);
+
+    /*
+     * Closes the road an edge belongs to by making the cost of the edge, and of
+     * the edge back between the same two nodes if there is one, infinite, so that
+     * no search uses the road in either direction. Each direction is one change,
+     * as if set with setEdgeCost, and setting a finite cost opens that one again.
+     */
+    void closeEdge(RoadEdge* edge);
+
 private:
     // underlying data
     Graph<RoadNode, RoadEdge>* data;
 
+    // the saved CSR snapshot of the graph
+    mutable std::unique_ptr<CompiledRoadGraph> compiled;
+
+    // the saved contraction hierarchy of the snapshot
+    mutable std::unique_ptr<ContractionHierarchy> contracted;
+
+    // the saved customizable hierarchy, used instead once costs have changed,
+    // and the version whose costs it was last customized with
+    mutable std::unique_ptr<CustomizableHierarchy> customizable;
+    mutable unsigned customizedVersion = 0;
+    bool costsChanged = false;
+
+    // the saved customizable hierarchy for the second metric of the arcs
+    mutable std::unique_ptr<CustomizableHierarchy> secondCustomizable;
+
+    // the saved grid over the node locations of the snapshot
+    mutable std::unique_ptr<SpatialIndex> located;
+
     // the saved max rate of the graph
     mutable bool maxRateCached = false;
     mutable double maxRate = 0.0;
+
+    // the version of the graph's contents
+    unsigned myVersion;
 };
@@ -0,0 +1,407 @@
+/**
+ * @brief This file implements the binary map writer and the memory-mapped reader.
+ * @headerfile RoadMapBinary.h
+ * @version 2026/10/16
+ */
+
+#include "RoadMapBinary.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+#  include <windows.h>
+#else // _WIN32
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif // _WIN32
+
+static_assert(sizeof(int) == sizeof(int32_t), "binary maps store node IDs as 32-bit ints");
+
+/* The sections of a binary map, in file order. */
+namespace {
+    enum Section {
+        STRINGS,           // NUL-terminated interned strings
+        NAME_OFFSETS,      // uint32 per node: offset of its name in STRINGS
+        NAME_INDEX,        // int32 per node: node IDs sorted by name
+        XS,                // double per node
+        YS,                // double per node
+        ARC_OFFSETS,       // int32 per node, plus one
+        ARC_TARGETS,       // int32 per arc
+        ARC_COSTS,         // double per arc
+        IN_ARC_OFFSETS,    // int32 per node, plus one
+        IN_ARC_SOURCES,    // int32 per arc
+        IN_ARC_COSTS,      // double per arc
+        IN_ARC_FORWARDS,   // int32 per arc
+        ARC_METRIC2,       // double per arc, or empty
+        IN_ARC_METRIC2,    // double per arc, or empty
+        SECTION_COUNT
+    };
+}
+
+struct RoadMapFileHeader {
+    char magic[8];
+    uint32_t formatVersion;
+    uint32_t byteOrder;        // BYTE_ORDER_MARK in the writer's byte order
+    uint32_t flags;            // FLAG_* bits
+    int32_t width;
+    int32_t height;
+    int32_t nodeCount;
+    int32_t arcCount;
+    uint32_t imageFile;        // offset of the image file name in STRINGS
+    double maxRoadSpeed;
+    uint64_t sectionOffsets[SECTION_COUNT];
+    uint64_t sectionSizes[SECTION_COUNT];
+};
+
+/* Constants and helper functions only needed in this file. */
+namespace {
+    const char MAGIC[8] = { 'P', 'F', 'M', 'A', 'P', '\r', '\n', '\x1a' };
+    const uint32_t FORMAT_VERSION = 2;
+    const uint32_t BYTE_ORDER_MARK = 0x01020304;
+    const uint32_t FLAG_LARGE_MAP_DISPLAY = 1;
+    const uint32_t FLAG_SECOND_METRIC = 2;
+    const uint64_t SECTION_ALIGNMENT = 8;
+
+    uint64_t align(uint64_t offset) {
+        return (offset + SECTION_ALIGNMENT - 1) / SECTION_ALIGNMENT * SECTION_ALIGNMENT;
+    }
+
+    /* Collects strings, storing each distinct one once. */
+    class StringTable {
+    public:
+        uint32_t intern(const std::string& text) {
+            auto found = offsets.find(text);
+            if (found != offsets.end()) {
+                return found->second;
+            }
+            uint32_t offset = static_cast<uint32_t>(bytes.size());
+            bytes.insert(bytes.end(), text.begin(), text.end());
+            bytes.push_back('\0');
+            offsets[text] = offset;
+            return offset;
+        }
+
+        const std::vector<char>& contents() const { return bytes; }
+
+    private:
+        std::vector<char> bytes;
+        std::unordered_map<std::string, uint32_t> offsets;
+    };
+
+    /* Points a section at the bytes of a vector. */
+    template <typename T>
+    void describe(const std::vector<T>& data, const void*& start, uint64_t& size) {
+        start = data.empty() ? nullptr : data.data();
+        size = data.size() * sizeof(T);
+    }
+}
+
+bool writeRoadMapBinary(std::ostream& output, const RoadMapHeader& header,
+                        const RoadGraph& graph, const RoadMapBinaryOptions& options) {
+    const CompiledRoadGraph& compiled = graph.compile();
+    int nodeCount = compiled.nodeCount();
+    int arcCount = compiled.arcCount();
+
+    StringTable strings;
+    uint32_t imageFile = strings.intern(header.imageFile);
+    std::vector<uint32_t> nameOffsets;
+    std::vector<std::string> names;
+    std::vector<double> xs, ys;
+    std::vector<int32_t> arcOffsets, inArcOffsets;
+    for (int id = 0; id < nodeCount; id++) {
+        names.push_back(compiled.nodeAt(id)->nodeName());
+        nameOffsets.push_back(strings.intern(names.back()));
+        xs.push_back(compiled.x(id));
+        ys.push_back(compiled.y(id));
+        arcOffsets.push_back(compiled.firstArc(id));
+        inArcOffsets.push_back(compiled.firstInArc(id));
+    }
+    arcOffsets.push_back(arcCount);
+    inArcOffsets.push_back(arcCount);
+
+    std::vector<int32_t> nameIndex(nodeCount);
+    for (int id = 0; id < nodeCount; id++) {
+        nameIndex[id] = id;
+    }
+    std::sort(nameIndex.begin(), nameIndex.end(), [&](int32_t a, int32_t b) {
+        return names[a] < names[b];
+    });
+
+    std::vector<int32_t> arcTargets, inArcSources, inArcForwards;
+    std::vector<double> arcCosts, inArcCosts, arcMetric2, inArcMetric2;
+    bool secondMetric = options.secondMetric && compiled.hasSecondMetric();
+    for (int arc = 0; arc < arcCount; arc++) {
+        arcTargets.push_back(compiled.arcTarget(arc));
+        arcCosts.push_back(compiled.arcCost(arc));
+        inArcSources.push_back(compiled.inArcSource(arc));
+        inArcCosts.push_back(compiled.inArcCost(arc));
+        inArcForwards.push_back(compiled.inArcForward(arc));
+        if (secondMetric) {
+            arcMetric2.push_back(compiled.arcSecondMetric(arc));
+            inArcMetric2.push_back(compiled.inArcSecondMetric(arc));
+        }
+    }
+
+    RoadMapFileHeader fileHeader;
+    std::memset(&fileHeader, 0, sizeof(fileHeader));
+    std::memcpy(fileHeader.magic, MAGIC, sizeof(MAGIC));
+    fileHeader.formatVersion = FORMAT_VERSION;
+    fileHeader.byteOrder = BYTE_ORDER_MARK;
+    fileHeader.flags = (header.largeMapDisplay ? FLAG_LARGE_MAP_DISPLAY : 0)
+            | (secondMetric ? FLAG_SECOND_METRIC : 0);
+    fileHeader.width = header.width;
+    fileHeader.height = header.height;
+    fileHeader.nodeCount = nodeCount;
+    fileHeader.arcCount = arcCount;
+    fileHeader.imageFile = imageFile;
+    fileHeader.maxRoadSpeed = graph.maxRoadSpeed();
+
+    const void* data[SECTION_COUNT];
+    describe(strings.contents(), data[STRINGS], fileHeader.sectionSizes[STRINGS]);
+    describe(nameOffsets, data[NAME_OFFSETS], fileHeader.sectionSizes[NAME_OFFSETS]);
+    describe(nameIndex, data[NAME_INDEX], fileHeader.sectionSizes[NAME_INDEX]);
+    describe(xs, data[XS], fileHeader.sectionSizes[XS]);
+    describe(ys, data[YS], fileHeader.sectionSizes[YS]);
+    describe(arcOffsets, data[ARC_OFFSETS], fileHeader.sectionSizes[ARC_OFFSETS]);
+    describe(arcTargets, data[ARC_TARGETS], fileHeader.sectionSizes[ARC_TARGETS]);
+    describe(arcCosts, data[ARC_COSTS], fileHeader.sectionSizes[ARC_COSTS]);
+    describe(inArcOffsets, data[IN_ARC_OFFSETS], fileHeader.sectionSizes[IN_ARC_OFFSETS]);
+    describe(inArcSources, data[IN_ARC_SOURCES], fileHeader.sectionSizes[IN_ARC_SOURCES]);
+    describe(inArcCosts, data[IN_ARC_COSTS], fileHeader.sectionSizes[IN_ARC_COSTS]);
+    describe(inArcForwards, data[IN_ARC_FORWARDS], fileHeader.sectionSizes[IN_ARC_FORWARDS]);
+    describe(arcMetric2, data[ARC_METRIC2], fileHeader.sectionSizes[ARC_METRIC2]);
+    describe(inArcMetric2, data[IN_ARC_METRIC2], fileHeader.sectionSizes[IN_ARC_METRIC2]);
+
+    uint64_t offset = align(sizeof(fileHeader));
+    for (int i = 0; i < SECTION_COUNT; i++) {
+        fileHeader.sectionOffsets[i] = offset;
+        offset = align(offset + fileHeader.sectionSizes[i]);
+    }
+
+    const char padding[SECTION_ALIGNMENT] = {};
+    uint64_t written = sizeof(fileHeader);
+    output.write(reinterpret_cast<const char*>(&fileHeader), sizeof(fileHeader));
+    for (int i = 0; i < SECTION_COUNT; i++) {
+        output.write(padding, fileHeader.sectionOffsets[i] - written);
+        output.write(static_cast<const char*>(data[i]), fileHeader.sectionSizes[i]);
+        written = fileHeader.sectionOffsets[i] + fileHeader.sectionSizes[i];
+    }
+    output.flush();
+    if (!output) {
+        std::cerr << "Cannot write binary map; output failed" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+MappedRoadMap::~MappedRoadMap() {
+    close();
+}
+
+/*
+ * Checks everything a reader relies on without touching the sections themselves,
+ * so that opening a map only faults in the page holding the header.
+ */
+bool MappedRoadMap::open(const std::string& fileName) {
+    close();
+    if (!mapFile(fileName)) {
+        return false;
+    }
+
+    std::string problem;
+    const RoadMapFileHeader& fileHeader = this->fileHeader();
+    if (length < sizeof(RoadMapFileHeader)
+            || std::memcmp(fileHeader.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        problem = "not a binary map";
+    } else if (fileHeader.byteOrder != BYTE_ORDER_MARK) {
+        problem = "written on a machine with the other byte order";
+    } else if (fileHeader.formatVersion != FORMAT_VERSION) {
+        problem = "unsupported format version " + std::to_string(fileHeader.formatVersion);
+    } else if (fileHeader.nodeCount < 0 || fileHeader.arcCount < 0) {
+        problem = "negative node or arc count";
+    } else {
+        uint64_t nodes = fileHeader.nodeCount;
+        uint64_t arcs = fileHeader.arcCount;
+        bool metric2 = (fileHeader.flags & FLAG_SECOND_METRIC) != 0;
+        uint64_t expected[SECTION_COUNT] = {
+            fileHeader.sectionSizes[STRINGS],
+            nodes * sizeof(uint32_t), nodes * sizeof(int32_t),
+            nodes * sizeof(double), nodes * sizeof(double),
+            (nodes + 1) * sizeof(int32_t), arcs * sizeof(int32_t), arcs * sizeof(double),
+            (nodes + 1) * sizeof(int32_t), arcs * sizeof(int32_t), arcs * sizeof(double),
+            arcs * sizeof(int32_t),
+            metric2 ? arcs * sizeof(double) : 0, metric2 ? arcs * sizeof(double) : 0
+        };
+        for (int i = 0; i < SECTION_COUNT && problem.empty(); i++) {
+            uint64_t start = fileHeader.sectionOffsets[i];
+            uint64_t size = fileHeader.sectionSizes[i];
+            if (size != expected[i] || start % SECTION_ALIGNMENT != 0
+                    || start > length || size > length - start) {
+                problem = "section " + std::to_string(i) + " is damaged";
+            }
+        }
+        uint64_t stringBytes = fileHeader.sectionSizes[STRINGS];
+        if (problem.empty() && (stringBytes == 0 || fileHeader.imageFile >= stringBytes
+                || base[fileHeader.sectionOffsets[STRINGS] + stringBytes - 1] != '\0')) {
+            problem = "string table is damaged";
+        }
+    }
+    if (!problem.empty()) {
+        std::cerr << "Invalid binary map " << fileName << "; " << problem << std::endl;
+        close();
+        return false;
+    }
+
+    const uint64_t* offsets = fileHeader.sectionOffsets;
+    arrays.strings = base + offsets[STRINGS];
+    arrays.nameOffsets = reinterpret_cast<const uint32_t*>(base + offsets[NAME_OFFSETS]);
+    arrays.nameIndex = reinterpret_cast<const int32_t*>(base + offsets[NAME_INDEX]);
+    arrays.xs = reinterpret_cast<const double*>(base + offsets[XS]);
+    arrays.ys = reinterpret_cast<const double*>(base + offsets[YS]);
+    arrays.arcOffsets = reinterpret_cast<const int32_t*>(base + offsets[ARC_OFFSETS]);
+    arrays.arcTargets = reinterpret_cast<const int32_t*>(base + offsets[ARC_TARGETS]);
+    arrays.arcCosts = reinterpret_cast<const double*>(base + offsets[ARC_COSTS]);
+    arrays.inArcOffsets = reinterpret_cast<const int32_t*>(base + offsets[IN_ARC_OFFSETS]);
+    arrays.inArcSources = reinterpret_cast<const int32_t*>(base + offsets[IN_ARC_SOURCES]);
+    arrays.inArcCosts = reinterpret_cast<const double*>(base + offsets[IN_ARC_COSTS]);
+    arrays.inArcForwards = reinterpret_cast<const int32_t*>(base + offsets[IN_ARC_FORWARDS]);
+    if (fileHeader.flags & FLAG_SECOND_METRIC) {
+        arrays.arcMetric2 = reinterpret_cast<const double*>(base + offsets[ARC_METRIC2]);
+        arrays.inArcMetric2 = reinterpret_cast<const double*>(base + offsets[IN_ARC_METRIC2]);
+    }
+    return true;
+}
+
+RoadMapHeader MappedRoadMap::header() const {
+    RoadMapHeader result;
+    result.largeMapDisplay = (fileHeader().flags & FLAG_LARGE_MAP_DISPLAY) != 0;
+    result.imageFile = arrays.strings + fileHeader().imageFile;
+    result.width = fileHeader().width;
+    result.height = fileHeader().height;
+    return result;
+}
+
+int MappedRoadMap::nodeCount() const {
+    return fileHeader().nodeCount;
+}
+
+int MappedRoadMap::arcCount() const {
+    return fileHeader().arcCount;
+}
+
+double MappedRoadMap::maxRoadSpeed() const {
+    return fileHeader().maxRoadSpeed;
+}
+
+const char* MappedRoadMap::nodeName(int id) const {
+    return arrays.strings + arrays.nameOffsets[id];
+}
+
+int MappedRoadMap::idOfName(const std::string& name) const {
+    int low = 0;
+    int high = nodeCount();
+    while (low < high) {
+        int middle = low + (high - low) / 2;
+        int order = std::strcmp(nodeName(arrays.nameIndex[middle]), name.c_str());
+        if (order == 0) {
+            return arrays.nameIndex[middle];
+        } else if (order < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return -1;
+}
+
+bool MappedRoadMap::hasSecondMetric() const {
+    return arrays.arcMetric2 != nullptr;
+}
+
+const RoadMapFileHeader& MappedRoadMap::fileHeader() const {
+    return *reinterpret_cast<const RoadMapFileHeader*>(base);
+}
+
+#ifdef _WIN32
+
+bool MappedRoadMap::mapFile(const std::string& fileName) {
+    HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    LARGE_INTEGER size;
+    if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &size)
+            || size.QuadPart < static_cast<LONGLONG>(sizeof(RoadMapFileHeader))) {
+        std::cerr << "Cannot map binary map " << fileName << std::endl;
+        if (file != INVALID_HANDLE_VALUE) {
+            CloseHandle(file);
+        }
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        std::cerr << "Cannot map binary map " << fileName << std::endl;
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    mappingHandle = mapping;
+    base = static_cast<const char*>(view);
+    length = static_cast<size_t>(size.QuadPart);
+    return true;
+}
+
+void MappedRoadMap::close() {
+    if (base) {
+        UnmapViewOfFile(base);
+        CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+    }
+    base = nullptr;
+    length = 0;
+    fileHandle = nullptr;
+    mappingHandle = nullptr;
+    arrays = Arrays();
+}
+
+#else // _WIN32
+
+bool MappedRoadMap::mapFile(const std::string& fileName) {
+    int file = ::open(fileName.c_str(), O_RDONLY);
+    struct stat status;
+    if (file < 0 || fstat(file, &status) != 0
+            || status.st_size < static_cast<off_t>(sizeof(RoadMapFileHeader))) {
+        std::cerr << "Cannot map binary map " << fileName << std::endl;
+        if (file >= 0) {
+            ::close(file);
+        }
+        return false;
+    }
+    void* view = mmap(nullptr, status.st_size, PROT_READ, MAP_SHARED, file, 0);
+    ::close(file);   // the mapping keeps the file open
+    if (view == MAP_FAILED) {
+        std::cerr << "Cannot map binary map " << fileName << std::endl;
+        return false;
+    }
+    base = static_cast<const char*>(view);
+    length = static_cast<size_t>(status.st_size);
+    return true;
+}
+
+void MappedRoadMap::close() {
+    if (base) {
+        munmap(const_cast<char*>(base), length);
+    }
+    base = nullptr;
+    length = 0;
+    arrays = Arrays();
+}
+
+#endif // _WIN32
@@ -0,0 +1,147 @@
+/**
+ * @brief This file declares the binary map format: a writer that compiles a loaded
+ * map into it, and a reader that memory-maps such a file and serves its arrays
+ * in place.
+ * @class RoadMapBinary.cpp
+ * @version 2026/10/16
+ */
+
+#ifndef _roadmapbinary_h
+#define _roadmapbinary_h
+
+#include "RoadGraph.h"
+#include "RoadMapReader.h"
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+/*
+ * A binary map (".pfmap") holds everything the searches need as flat arrays,
+ * laid out so that it can be used straight from a read-only memory mapping:
+ *
+ *   - a fixed header: magic, format version, byte-order mark, display flags,
+ *     canvas size, node and arc counts, the fastest road speed, and a table of
+ *     the offset and size of every section;
+ *   - an interned string table (node names and the image file name, each
+ *     distinct string once, NUL-terminated), with each node's name offset and
+ *     the node IDs sorted by name for lookups;
+ *   - the node coordinates;
+ *   - the forward and reverse CSR adjacency with arc costs, exactly as
+ *     CompiledRoadGraph lays them out;
+ *   - if the map has a second metric (see RoadEdge::secondMetric), its value
+ *     for every arc, in the order of both the forward and the reverse arcs.
+ *
+ * Every section starts on an 8-byte boundary. Numbers are stored in the byte
+ * order of the machine that wrote the file, and a reader refuses files written
+ * with the other one.
+ */
+
+/* The fixed header at the start of a binary map, defined in RoadMapBinary.cpp. */
+struct RoadMapFileHeader;
+
+/* Options for writeRoadMapBinary. */
+struct RoadMapBinaryOptions {
+    bool secondMetric = true;   // store the map's second metric, if it has one
+};
+
+/*
+ * Writes the given map in the binary format. Returns false, after printing the
+ * reason to cerr, if the output cannot be written.
+ */
+bool writeRoadMapBinary(std::ostream& output, const RoadMapHeader& header,
+                        const RoadGraph& graph,
+                        const RoadMapBinaryOptions& options = RoadMapBinaryOptions());
+
+/*
+ * A binary map file mapped read-only into memory.
+ *
+ * Opening a file only maps it and checks its header and section table; the
+ * arrays are paged in by the operating system as the searches touch them, and
+ * processes that map the same file share one physical copy. The contents of
+ * the sections are trusted to be what writeRoadMapBinary produced.
+ *
+ * A CompiledRoadGraph can view the mapped arrays without copying them (see
+ * CompiledRoadGraph(const MappedRoadMap&)), which lets the ID-based searches in
+ * pathfinder.h run directly on the file.
+ */
+class MappedRoadMap {
+public:
+    MappedRoadMap() = default;
+    ~MappedRoadMap();
+
+    MappedRoadMap(const MappedRoadMap&) = delete;
+    MappedRoadMap& operator =(const MappedRoadMap&) = delete;
+
+    /*
+     * Maps the given file, unmapping any file mapped before. Returns false,
+     * after printing the reason to cerr, if it cannot be mapped or is not a
+     * binary map of the supported version.
+     */
+    bool open(const std::string& fileName);
+
+    /* Unmaps the file, if any. */
+    void close();
+
+    /* Returns whether a file is mapped. */
+    bool isOpen() const { return base != nullptr; }
+
+    /* Returns the display settings stored with the map. */
+    RoadMapHeader header() const;
+
+    /* Returns the number of nodes and arcs. */
+    int nodeCount() const;
+    int arcCount() const;
+
+    /* Returns the fastest road speed, as RoadGraph::maxRoadSpeed() computed it. */
+    double maxRoadSpeed() const;
+
+    /* Returns the name of a node. */
+    const char* nodeName(int id) const;
+
+    /* Returns the ID of the node with the given name, or -1 if there is none. */
+    int idOfName(const std::string& name) const;
+
+    /*
+     * Returns whether the map stores a second metric, which a CompiledRoadGraph
+     * viewing the map serves as its arcs' second metric.
+     */
+    bool hasSecondMetric() const;
+
+private:
+    friend class CompiledRoadGraph;
+
+    /* The sections of the mapped file, found when it is opened. */
+    struct Arrays {
+        const char* strings = nullptr;
+        const uint32_t* nameOffsets = nullptr;   // into strings, per node
+        const int32_t* nameIndex = nullptr;      // node IDs sorted by name
+        const double* xs = nullptr;
+        const double* ys = nullptr;
+        const int32_t* arcOffsets = nullptr;
+        const int32_t* arcTargets = nullptr;
+        const double* arcCosts = nullptr;
+        const int32_t* inArcOffsets = nullptr;
+        const int32_t* inArcSources = nullptr;
+        const double* inArcCosts = nullptr;
+        const int32_t* inArcForwards = nullptr;
+        const double* arcMetric2 = nullptr;      // nullptr if not stored
+        const double* inArcMetric2 = nullptr;    // nullptr if not stored
+    };
+
+    const char* base = nullptr;   // start of the mapping
+    size_t length = 0;            // length of the mapping
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif // _WIN32
+    Arrays arrays;
+
+    /* Returns the fixed header at the start of the mapping. */
+    const RoadMapFileHeader& fileHeader() const;
+
+    /* Maps the file; returns false after printing the reason to cerr. */
+    bool mapFile(const std::string& fileName);
+};
+
+#endif // _roadmapbinary_h
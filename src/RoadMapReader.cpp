@@ -0,0 +1,493 @@
+/**
+ * @brief This file implements the reader for the world text format.
+ * @headerfile RoadMapReader.h
+ * @version 2026/10/16
+ */
+
+#include "RoadMapReader.h"
+#include <cctype>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+#include "strlib.h"
+
+/* Private helper types and functions only needed in this file. */
+namespace {
+    /* Reads files from the stream until a non-empty, non-comment line is read. */
+    bool getMeaningfulLine(std::istream& input, std::string& line) {
+        std::string lineOut;
+        while (getline(input, lineOut)) {
+            trimInPlace(lineOut);
+            if (!lineOut.empty() && lineOut[0] != '#') {
+                line = lineOut;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /* A range of characters inside a line, used in place of a copied substring. */
+    struct Field {
+        const char* begin;
+        const char* end;
+
+        bool operator ==(const char* text) const {
+            size_t length = std::strlen(text);
+            return static_cast<size_t>(end - begin) == length
+                    && std::memcmp(begin, text, length) == 0;
+        }
+
+        std::string toString() const { return std::string(begin, end); }
+
+        /* Copies the field into the string, reusing its buffer. */
+        void assignTo(std::string& text) const { text.assign(begin, end); }
+    };
+
+    bool isSpace(char ch) {
+        return isspace(static_cast<unsigned char>(ch)) != 0;
+    }
+
+    /* Returns the field without leading and trailing whitespace, as trim does. */
+    Field trimmed(Field field) {
+        while (field.begin < field.end && isSpace(*field.begin)) {
+            field.begin++;
+        }
+        while (field.end > field.begin && isSpace(field.end[-1])) {
+            field.end--;
+        }
+        return field;
+    }
+
+    /*
+     * Like getMeaningfulLine, but reads into a reused line and returns its
+     * trimmed content as a field instead of copying it.
+     */
+    bool getMeaningfulLine(std::istream& input, std::string& line, Field& content) {
+        while (getline(input, line)) {
+            content = trimmed({ line.data(), line.data() + line.size() });
+            if (content.begin < content.end && *content.begin != '#') {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /*
+     * Splits the content at each ';', as stringSplit(content, ";") does: fields
+     * are not trimmed, and an empty last field is dropped.
+     */
+    void splitFields(Field content, std::vector<Field>& fields) {
+        fields.clear();
+        const char* begin = content.begin;
+        for (const char* p = begin; p < content.end; p++) {
+            if (*p == ';') {
+                fields.push_back({ begin, p });
+                begin = p + 1;
+            }
+        }
+        if (begin < content.end) {
+            fields.push_back({ begin, content.end });
+        }
+    }
+
+    /* Splits a "time:factor" breakpoint at its colon. */
+    bool splitBreakpoint(Field field, Field& time, Field& factor) {
+        const char* colon = static_cast<const char*>(
+                std::memchr(field.begin, ':', field.end - field.begin));
+        if (!colon) {
+            return false;
+        }
+        time = { field.begin, colon };
+        factor = { colon + 1, field.end };
+        return true;
+    }
+
+    /*
+     * Parses a decimal int, accepting exactly what stringIsInteger accepts:
+     * surrounding whitespace, an optional sign, and digits that fit in an int.
+     */
+    bool parseInteger(Field field, int& value) {
+        field = trimmed(field);
+        const char* p = field.begin;
+        bool negative = p < field.end && *p == '-';
+        if (p < field.end && (*p == '-' || *p == '+')) {
+            p++;
+        }
+        if (p == field.end) {
+            return false;
+        }
+        long long magnitude = 0;
+        for (; p < field.end; p++) {
+            if (*p < '0' || *p > '9') {
+                return false;
+            }
+            magnitude = magnitude * 10 + (*p - '0');
+            if (magnitude > static_cast<long long>(INT_MAX) + 1) {
+                return false;
+            }
+        }
+        if (!negative && magnitude > INT_MAX) {
+            return false;
+        }
+        value = static_cast<int>(negative ? -magnitude : magnitude);
+        return true;
+    }
+
+    /*
+     * Parses a decimal real number, accepting exactly what stringIsReal accepts:
+     * surrounding whitespace, an optional sign, digits with at most one decimal
+     * point, an optional exponent, and no overflow to infinity. The syntax is
+     * checked here and the digits are converted by strtod.
+     */
+    bool parseReal(Field field, double& value) {
+        field = trimmed(field);
+        const char* p = field.begin;
+        if (p < field.end && (*p == '-' || *p == '+')) {
+            p++;
+        }
+        bool digits = false;
+        for (; p < field.end && *p >= '0' && *p <= '9'; p++) {
+            digits = true;
+        }
+        if (p < field.end && *p == '.') {
+            for (p++; p < field.end && *p >= '0' && *p <= '9'; p++) {
+                digits = true;
+            }
+        }
+        if (!digits) {
+            return false;
+        }
+        if (p < field.end && (*p == 'e' || *p == 'E')) {
+            p++;
+            if (p < field.end && (*p == '-' || *p == '+')) {
+                p++;
+            }
+            const char* exponent = p;
+            for (; p < field.end && *p >= '0' && *p <= '9'; p++) {}
+            if (p == exponent) {
+                return false;
+            }
+        }
+        if (p != field.end) {
+            return false;
+        }
+
+        char buffer[64];
+        size_t length = field.end - field.begin;
+        std::string longText;
+        const char* text = buffer;
+        if (length < sizeof(buffer)) {
+            std::memcpy(buffer, field.begin, length);
+            buffer[length] = '\0';
+        } else {
+            longText = field.toString();
+            text = longText.c_str();
+        }
+        value = strtod(text, nullptr);
+        return std::fabs(value) != HUGE_VAL;
+    }
+}
+
+bool readRoadMapHeader(std::istream& input, RoadMapHeader& header, bool checkImage) {
+    header = RoadMapHeader();
+
+    std::string line;
+    if (!getMeaningfulLine(input, line)) {   // "FLAGS or IMAGE"
+        std::cerr << "Invalid input file; file is empty" << std::endl;
+        return false;
+    }
+    if(line == "FLAGS") {
+        std::string flagLine;
+        while (true) {
+            if(!getMeaningfulLine(input, flagLine)) {
+                std::cerr << "Invalid input file; missing \"IMAGE\" header" << std::endl;
+                return false;
+            }
+            if(flagLine == "IMAGE") break;
+            Vector<std::string> parts = stringSplit(flagLine, "=");
+            if(parts[0] == "largeMapDisplay") {
+                header.largeMapDisplay = parts[1] == "true";
+            }
+        }
+    }
+
+    if (!getMeaningfulLine(input, header.imageFile)) {
+        std::cerr << "Invalid input file; missing image file name" << std::endl;
+        return false;
+    }
+    if (checkImage && !std::ifstream(header.imageFile.c_str())) {
+        std::cerr << "Invalid input file; specified image file \""
+                  << header.imageFile << "\" does not exist" << std::endl;
+        return false;
+    }
+
+    if (!getMeaningfulLine(input, line)) {
+        std::cerr << "Invalid input file; missing width" << std::endl;
+        return false;
+    }
+    if (!stringIsInteger(line)) {
+        std::cerr << "Invalid input file; non-integer width \""
+                  << line << "\"" << std::endl;
+        return false;
+    }
+    header.width = stringToInteger(line);
+
+    if (!getMeaningfulLine(input, line)) {
+        std::cerr << "Invalid input file; missing height" << std::endl;
+        return false;
+    }
+    if (!stringIsInteger(line)) {
+        std::cerr << "Invalid input file; non-integer height \""
+                  << line << "\"" << std::endl;
+        return false;
+    }
+    header.height = stringToInteger(line);
+    return true;
+}
+
+/*
+ * The sections are parsed in one pass over each line: fields are split and
+ * trimmed as pointer ranges into the line, numbers are parsed straight from
+ * those ranges, node names are looked up through the hash index of the Graph,
+ * and the nodes and edges are made in the storage of the Graph. The checks and
+ * their messages are those of the original reader, which split each line into
+ * strings and looked names up in the Graph.
+ */
+bool readRoadMapGraph(std::istream& input, Graph<RoadNode, RoadEdge>& graph,
+                      TravelTimeProfiles* profiles,
+                      std::vector<TurnRestriction>* restrictions) {
+    std::string line;
+    std::vector<Field> fields;
+    Field content;
+    getline(input, line);  // VERTICES
+    bool profilesFollow = false;
+    while (getMeaningfulLine(input, line, content)) {
+        // "Hobbiton;147;86"
+        splitFields(content, fields);
+        if (fields.size() >= 1 && (fields[0] == "ARCS" || fields[0] == "EDGES")) {
+            break;
+        } else if (fields.size() >= 1 && fields[0] == "PROFILES") {
+            profilesFollow = true;
+            break;
+        } else if (fields.size() < 3) {
+            continue;
+        }
+
+        std::string name = trimmed(fields[0]).toString();
+        if (graph.getNode(name)) {
+            std::cerr << "Invalid input file; duplicate vertex \""
+                      << name << "\"" << std::endl;
+            return false;
+        }
+
+        int vertexX;
+        int vertexY;
+        if (!parseInteger(fields[1], vertexX) || !parseInteger(fields[2], vertexY)) {
+            std::cerr << "Invalid input file; non-integer coordinates for vertex \""
+                      << name << "\"" << std::endl;
+            return false;
+        }
+        if (vertexX < 0 || vertexY < 0) {
+            std::cerr << "Invalid input file; negative coordinates for vertex \""
+                      << name << "\"" << std::endl;
+            return false;
+        }
+
+        RoadNode* node = graph.createNode(name, Point(vertexX, vertexY));
+        graph.addNode(node);
+    }
+
+    /* Named travel time profiles may come between the vertices and the edges. */
+    TravelTimeProfiles unused;
+    TravelTimeProfiles& store = profiles ? *profiles : unused;
+    std::unordered_map<std::string, int> profileIds;
+    std::vector<TravelTimeProfiles::Breakpoint> breakpoints;
+    std::string profileName;
+    while (profilesFollow && getMeaningfulLine(input, line, content)) {
+        // "rush;25200:1;30600:2.5;36000:1"
+        splitFields(content, fields);
+        if (fields.size() >= 1 && (fields[0] == "ARCS" || fields[0] == "EDGES")) {
+            break;
+        }
+        trimmed(fields[0]).assignTo(profileName);
+        if (profileIds.count(profileName)) {
+            std::cerr << "Invalid input file; duplicate travel time profile \""
+                      << profileName << "\"" << std::endl;
+            return false;
+        }
+        if (fields.size() < 2) {
+            std::cerr << "Invalid input file; travel time profile \""
+                      << profileName << "\" has no breakpoints" << std::endl;
+            return false;
+        }
+        breakpoints.clear();
+        for (size_t i = 1; i < fields.size(); i++) {
+            Field time;
+            Field factor;
+            TravelTimeProfiles::Breakpoint point;
+            if (!splitBreakpoint(fields[i], time, factor)
+                    || !parseReal(time, point.time) || !parseReal(factor, point.factor)) {
+                std::cerr << "Invalid input file; malformed breakpoint \""
+                          << trimmed(fields[i]).toString() << "\" in travel time profile \""
+                          << profileName << "\"" << std::endl;
+                return false;
+            }
+            if (!breakpoints.empty() && point.time <= breakpoints.back().time) {
+                std::cerr << "Invalid input file; breakpoint times of travel time profile \""
+                          << profileName << "\" do not increase" << std::endl;
+                return false;
+            }
+            if (point.factor <= 0) {
+                std::cerr << "Invalid input file; non-positive factor in travel time profile \""
+                          << profileName << "\"" << std::endl;
+                return false;
+            }
+            breakpoints.push_back(point);
+        }
+        profileIds[profileName] = store.add(breakpoints);
+    }
+
+    std::string name1;
+    std::string name2;
+    bool restrictionsFollow = false;
+    int edgesWithMetric2 = 0;
+    int edgesWithoutMetric2 = 0;
+    while (getMeaningfulLine(input, line, content)) {
+        // "Hobbiton;Southfarthing;1"
+        splitFields(content, fields);
+        if (fields.size() < 3) {
+            restrictionsFollow = fields.size() >= 1 && fields[0] == "RESTRICTIONS";
+            break;
+        }
+        trimmed(fields[0]).assignTo(name1);
+        trimmed(fields[1]).assignTo(name2);
+
+        RoadNode* node1 = graph.getNode(name1);
+        if (!node1) {
+            std::cerr << "Invalid input file; when reading edge between \""
+                      << name1 << "\" and \"" << name2
+                      << "\", graph does not contain a vertex named \""
+                      << name1 << "\"" << std::endl;
+            return false;
+        }
+        RoadNode* node2 = graph.getNode(name2);
+        if (!node2) {
+            std::cerr << "Invalid input file; when reading edge between \""
+                      << name1 << "\" and \"" << name2
+                      << "\", graph does not contain a vertex named \""
+                      << name2 << "\"" << std::endl;
+            return false;
+        }
+
+        double weight;
+        if (!parseReal(fields[2], weight)) {
+            std::cerr << "Invalid input file; non-numeric weight for edge between \""
+                      << name1 << "\" and \"" << name2 << "\"" << std::endl;
+            return false;
+        }
+        if (weight < 0) {
+            std::cerr << "Invalid input file; negative weight for edge between \""
+                      << name1 << "\" and \"" << name2 << "\"" << std::endl;
+            return false;
+        }
+
+        // edges are undirected (both ways) by default; only an exact "true" or
+        // "false" in the fourth field counts as the flag, and a number there is
+        // the second metric of an undirected edge
+        bool directed = fields.size() >= 4 && fields[3] == "true";
+        double metric2 = -1;
+        if (fields.size() >= 4 && !directed && !(fields[3] == "false")
+                && parseReal(fields[3], metric2)) {
+            if (metric2 < 0) {
+                std::cerr << "Invalid input file; negative second metric for edge between \""
+                          << name1 << "\" and \"" << name2 << "\"" << std::endl;
+                return false;
+            }
+            edgesWithMetric2++;
+        } else {
+            metric2 = -1;
+            edgesWithoutMetric2++;
+        }
+        if (edgesWithMetric2 > 0 && edgesWithoutMetric2 > 0) {
+            std::cerr << "Invalid input file; edge between \"" << name1 << "\" and \""
+                      << name2 << "\" " << (metric2 < 0 ? "lacks" : "has")
+                      << " the second metric that earlier edges "
+                      << (metric2 < 0 ? "have" : "lack") << std::endl;
+            return false;
+        }
+
+        // in a map with profiles, the fifth field, if any, names the travel time
+        // profile of the edge; older maps may have anything there
+        int profile = -1;
+        Field profileField = profilesFollow && fields.size() >= 5
+                ? trimmed(fields[4]) : Field{ nullptr, nullptr };
+        if (profileField.begin < profileField.end) {
+            profileField.assignTo(profileName);
+            auto found = profileIds.find(profileName);
+            if (found == profileIds.end()) {
+                std::cerr << "Invalid input file; edge between \""
+                          << name1 << "\" and \"" << name2
+                          << "\" has unknown travel time profile \""
+                          << profileName << "\"" << std::endl;
+                return false;
+            }
+            if (weight * store.steepestFall(found->second) < -1) {
+                std::cerr << "Invalid input file; travel time profile \"" << profileName
+                          << "\" lets a later start on the edge between \""
+                          << name1 << "\" and \"" << name2 << "\" arrive earlier" << std::endl;
+                return false;
+            }
+            if (profiles) {
+                profile = found->second;
+            }
+        }
+
+        /* Add the forward edge. */
+        graph.addArc(graph.createArc(node1, node2, weight, profile, metric2));
+
+        /* The graph might be undirected, in which case we should add the reverse edge as
+         * well.
+         */
+        if (!directed) {
+            graph.addArc(graph.createArc(node2, node1, weight, profile, metric2));
+        }
+    }
+
+    /* Turn restrictions may follow the edges. */
+    std::string name3;
+    while (restrictionsFollow && getMeaningfulLine(input, line, content)) {
+        // "Hobbiton;Bywater;Bree" or "Hobbiton;Bywater;Bree;2.5"
+        splitFields(content, fields);
+        if (fields.size() < 3) {
+            break;
+        }
+        trimmed(fields[0]).assignTo(name1);
+        trimmed(fields[1]).assignTo(name2);
+        trimmed(fields[2]).assignTo(name3);
+
+        TurnRestriction restriction;
+        restriction.from = graph.getArc(name1, name2);
+        restriction.to = graph.getArc(name2, name3);
+        if (!restriction.from || !restriction.to) {
+            std::cerr << "Invalid input file; turn restriction \"" << name1 << ";"
+                      << name2 << ";" << name3 << "\" does not follow two edges"
+                      << std::endl;
+            return false;
+        }
+        if (fields.size() >= 4
+                && (!parseReal(fields[3], restriction.penalty) || restriction.penalty < 0)) {
+            std::cerr << "Invalid input file; turn restriction \"" << name1 << ";"
+                      << name2 << ";" << name3 << "\" has an invalid penalty" << std::endl;
+            return false;
+        }
+        if (restrictions) {
+            restrictions->push_back(restriction);
+        }
+    }
+    return true;
+}
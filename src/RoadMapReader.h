@@ -0,0 +1,69 @@
+/**
+ * @brief This file declares the reader for the world text format, which the GUI
+ * and the headless tools both load maps with.
+ * @class RoadMapReader.cpp
+ * @version 2026/10/16
+ */
+
+#ifndef _roadmapreader_h
+#define _roadmapreader_h
+
+#include "graph.h"
+#include "RoadGraph.h"
+#include "TravelTimeProfiles.h"
+#include "TurnCosts.h"
+#include <istream>
+#include <string>
+#include <vector>
+
+/*
+ * The part of a world file that describes how it is displayed: the FLAGS
+ * section, the background image, and the preferred canvas size.
+ */
+struct RoadMapHeader {
+    bool largeMapDisplay = false;
+    std::string imageFile;
+    int width = 0;
+    int height = 0;
+};
+
+/*
+ * Reads the FLAGS section (if any), the image file name, and the width and
+ * height lines from the input. Returns false, after printing the reason to
+ * cerr, if the header is malformed or, when checkImage is true, if the image
+ * file does not exist. Tools that never draw the map can skip that check.
+ */
+bool readRoadMapHeader(std::istream& input, RoadMapHeader& header, bool checkImage = true);
+
+/*
+ * Reads the VERTICES and EDGES sections that follow the header into the given
+ * empty graph. Edges are added in both directions unless their fourth field
+ * says they are directed. Returns false, after printing the reason to cerr, if
+ * the sections are malformed; the graph may then hold part of the map.
+ *
+ * A number in the fourth field instead is the second metric of the edge (see
+ * RoadEdge::secondMetric), as in "Hobbiton;Bree;4;36", and the edge goes both
+ * ways. Either every edge of a map has a second metric or none does.
+ *
+ * An optional PROFILES section between the two names travel time profiles, one
+ * per line, as a name followed by "time:factor" breakpoints:
+ *
+ *     PROFILES
+ *     rush;25200:1;30600:2.5;36000:1.2
+ *
+ * and in a map with this section an edge follows a profile if its fifth field
+ * names it, as in "Hobbiton;Bree;4;false;rush". The profiles are added to the given store and
+ * the edges given their IDs there. Without a store they are still checked, but
+ * the edges keep fixed costs.
+ *
+ * An optional RESTRICTIONS section after the edges lists turns, one per line,
+ * by the three nodes they pass: "Hobbiton;Bywater;Bree" forbids going on from
+ * the edge Hobbiton -> Bywater onto Bywater -> Bree, and a fourth field gives
+ * the turn a penalty instead (see TurnCosts.h). They are appended to the given
+ * list, if any.
+ */
+bool readRoadMapGraph(std::istream& input, Graph<RoadNode, RoadEdge>& graph,
+                      TravelTimeProfiles* profiles = nullptr,
+                      std::vector<TurnRestriction>* restrictions = nullptr);
+
+#endif // _roadmapreader_h
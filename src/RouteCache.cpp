@@ -0,0 +1,146 @@
+/**
+ * @brief This file implements the route cache.
+ * @headerfile RouteCache.h
+ * @version 2026/10/16
+ */
+
+#include "RouteCache.h"
+
+/* Private helper functions only needed in this file. */
+namespace {
+    /*
+     * The bookkeeping charged to every entry besides its encoded path: the list
+     * node, the hash table node and its bucket, all approximately.
+     */
+    const size_t ENTRY_OVERHEAD = 6 * sizeof(void*);
+
+    /* Appends a signed number in zigzag form, seven bits per byte, low bits first. */
+    void appendNumber(std::string& bytes, int number) {
+        unsigned value = (static_cast<unsigned>(number) << 1) ^ static_cast<unsigned>(number >> 31);
+        while (value >= 0x80) {
+            bytes.push_back(static_cast<char>((value & 0x7f) | 0x80));
+            value >>= 7;
+        }
+        bytes.push_back(static_cast<char>(value));
+    }
+
+    /* Reads a number written by appendNumber, starting at position, and moves past it. */
+    int readNumber(const std::string& bytes, size_t& position) {
+        unsigned value = 0;
+        int shift = 0;
+        unsigned char byte;
+        do {
+            byte = static_cast<unsigned char>(bytes[position++]);
+            value |= static_cast<unsigned>(byte & 0x7f) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+        return static_cast<int>(value >> 1) ^ -static_cast<int>(value & 1);
+    }
+
+    /* Encodes a path as its first node ID followed by the steps between IDs. */
+    std::string encodePath(const std::vector<int>& path) {
+        std::string bytes;
+        int previous = 0;
+        for (int id : path) {
+            appendNumber(bytes, id - previous);
+            previous = id;
+        }
+        return bytes;
+    }
+
+    void decodePath(const std::string& bytes, std::vector<int>& path) {
+        path.clear();
+        int previous = 0;
+        size_t position = 0;
+        while (position < bytes.size()) {
+            previous += readNumber(bytes, position);
+            path.push_back(previous);
+        }
+    }
+}
+
+size_t RouteCache::KeyHash::operator ()(const RouteKey& key) const {
+    size_t hash = key.graphVersion;
+    hash = hash * 1000003u ^ static_cast<unsigned>(key.source);
+    hash = hash * 1000003u ^ static_cast<unsigned>(key.target);
+    hash = hash * 1000003u ^ key.algorithm;
+    return hash;
+}
+
+RouteCache::RouteCache(size_t maxBytes)
+    : maxBytes(maxBytes) {
+    // empty
+}
+
+bool RouteCache::lookup(const RouteKey& key, std::vector<int>& path, double& cost) {
+    std::lock_guard<std::mutex> guard(lock);
+    auto found = followVersion(key) ? index.find(key) : index.end();
+    if (found == index.end()) {
+        counters.misses++;
+        return false;
+    }
+    counters.hits++;
+    entries.splice(entries.begin(), entries, found->second);
+    decodePath(found->second->encodedPath, path);
+    cost = found->second->cost;
+    return true;
+}
+
+void RouteCache::store(const RouteKey& key, const std::vector<int>& path, double cost) {
+    Entry entry = { key, cost, encodePath(path) };
+    size_t size = costOf(entry);
+
+    std::lock_guard<std::mutex> guard(lock);
+    if (!followVersion(key) || size > maxBytes) {
+        return;
+    }
+    auto found = index.find(key);
+    if (found != index.end()) {
+        counters.bytes -= costOf(*found->second);
+        entries.erase(found->second);
+        index.erase(found);
+    }
+    while (counters.bytes + size > maxBytes) {
+        evict(--entries.end());
+        counters.evictions++;
+    }
+    entries.push_front(std::move(entry));
+    index[key] = entries.begin();
+    counters.bytes += size;
+    counters.entries = entries.size();
+}
+
+void RouteCache::clear() {
+    std::lock_guard<std::mutex> guard(lock);
+    entries.clear();
+    index.clear();
+    counters.bytes = 0;
+    counters.entries = 0;
+}
+
+RouteCacheStats RouteCache::stats() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return counters;
+}
+
+bool RouteCache::followVersion(const RouteKey& key) {
+    if (key.graphVersion > graphVersion) {
+        graphVersion = key.graphVersion;
+        entries.clear();
+        index.clear();
+        counters.bytes = 0;
+        counters.entries = 0;
+    }
+    return key.graphVersion == graphVersion;
+}
+
+void RouteCache::evict(std::list<Entry>::iterator entry) {
+    counters.bytes -= costOf(*entry);
+    index.erase(entry->key);
+    entries.erase(entry);
+    counters.entries = entries.size();
+}
+
+size_t RouteCache::costOf(const Entry& entry) {
+    return sizeof(Entry) + entry.encodedPath.capacity() + ENTRY_OVERHEAD;
+}
@@ -0,0 +1,116 @@
+/**
+ * @brief This file declares the route cache, which remembers the answers to recent
+ * point-to-point queries so that repeated queries skip the search.
+ * @class RouteCache.cpp
+ * @version 2026/10/16
+ */
+
+#ifndef _routecache_h
+#define _routecache_h
+
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * What a cached route is filed under: the version of the graph it was found on
+ * (see RoadGraph::version()), its endpoints as node IDs, and a tag chosen by the
+ * caller that tells apart searches that may return different routes for the same
+ * endpoints, such as different algorithms or heuristics.
+ */
+struct RouteKey {
+    unsigned graphVersion;
+    int source;
+    int target;
+    unsigned algorithm;
+
+    bool operator ==(const RouteKey& other) const {
+        return graphVersion == other.graphVersion && source == other.source
+                && target == other.target && algorithm == other.algorithm;
+    }
+};
+
+/* The counters of a route cache, taken together at one point in time. */
+struct RouteCacheStats {
+    unsigned long long hits = 0;
+    unsigned long long misses = 0;
+    unsigned long long evictions = 0;
+    size_t entries = 0;
+    size_t bytes = 0;
+};
+
+/*
+ * A thread-safe, size-bounded cache of routes with least-recently-used eviction.
+ *
+ * Paths are stored compactly, as the first node ID followed by the differences
+ * between consecutive IDs in a variable-length byte encoding, so a route of a few
+ * hundred nodes usually takes a few hundred bytes. The cache charges each entry
+ * for its encoded path plus an estimate of its bookkeeping, and evicts the least
+ * recently used entries whenever the total would exceed its budget.
+ *
+ * The cache follows the newest graph version it has been asked about. A key with
+ * a newer version empties the cache, so bumping the version of a graph is all it
+ * takes to invalidate every route found on it, and keys with an older version
+ * always miss and are never stored.
+ *
+ * All members may be called from several threads at once; a single mutex guards
+ * the cache, which is cheap next to the searches it saves.
+ */
+class RouteCache {
+public:
+    /* The budget used when none is given: 4 MiB. */
+    enum { DEFAULT_MAX_BYTES = 4 << 20 };
+
+    /* Creates an empty cache that holds at most the given number of bytes. */
+    explicit RouteCache(size_t maxBytes = DEFAULT_MAX_BYTES);
+
+    /*
+     * Looks up a route. On a hit, fills path with its node IDs, sets cost and
+     * returns true; otherwise returns false and leaves both alone.
+     */
+    bool lookup(const RouteKey& key, std::vector<int>& path, double& cost);
+
+    /*
+     * Stores a route, replacing any route stored under the same key. An empty
+     * path records that the target cannot be reached. A route too big for the
+     * whole budget is not stored.
+     */
+    void store(const RouteKey& key, const std::vector<int>& path, double cost);
+
+    /* Removes every route, keeping the counters. */
+    void clear();
+
+    /* Returns the counters and the current size of the cache. */
+    RouteCacheStats stats() const;
+
+private:
+    struct Entry {
+        RouteKey key;
+        double cost;
+        std::string encodedPath;
+    };
+
+    struct KeyHash {
+        size_t operator ()(const RouteKey& key) const;
+    };
+
+    size_t maxBytes;
+    unsigned graphVersion = 0;   // newest graph version seen
+    std::list<Entry> entries;    // most recently used first
+    std::unordered_map<RouteKey, std::list<Entry>::iterator, KeyHash> index;
+    RouteCacheStats counters;
+    mutable std::mutex lock;
+
+    /*
+     * Empties the cache if the key is for a newer graph, and returns whether the
+     * key is for the graph the cache follows.
+     */
+    bool followVersion(const RouteKey& key);
+    void evict(std::list<Entry>::iterator entry);
+    static size_t costOf(const Entry& entry);
+};
+
+#endif // _routecache_h
@@ -0,0 +1,94 @@
+/**
+ * @brief This file declares and implements the tracer policies that the search
+ * algorithms report their progress to.
+ * @class SearchTracer.h
+ * @version 2026/10/16
+ */
+
+#ifndef _searchtracer_h
+#define _searchtracer_h
+
+#include "CompiledRoadGraph.h"
+#include "Color.h"
+#include "RoadGraph.h"
+#include <vector>
+
+/*
+ * The searches in pathfinder.cpp are templates on a tracer type and call two
+ * members of it, both taking a dense node ID:
+ *
+ *     reached(id)     the node entered the frontier, or its g-score improved
+ *     expanded(id)    the node was taken off the frontier and expanded
+ *
+ * The calls are resolved at compile time, so a tracer whose members are empty
+ * inline functions costs nothing at all.
+ */
+
+/* A tracer that does nothing; searches run with it at full speed. */
+struct NullTracer {
+    void reached(int) {}
+    void expanded(int) {}
+};
+
+/*
+ * A tracer that colors nodes as the search goes, yellow when reached and green
+ * when expanded. The colors reach the GUI through the nodes' observers.
+ */
+class AnimationTracer {
+public:
+    explicit AnimationTracer(const CompiledRoadGraph& compiled) : compiled(compiled) {}
+
+    void reached(int id) { compiled.nodeAt(id)->setColor(Color::YELLOW); }
+    void expanded(int id) { compiled.nodeAt(id)->setColor(Color::GREEN); }
+
+private:
+    const CompiledRoadGraph& compiled;
+};
+
+/*
+ * A tracer that counts what a search did: how many nodes it expanded, how many
+ * times it reached a node, and the largest number of nodes that were waiting in
+ * its frontier (reached but not yet expanded since) at any one time.
+ */
+class CountingTracer {
+public:
+    /* Creates a tracer for graphs with the given number of nodes. */
+    explicit CountingTracer(int nodeCount) : inFrontier(nodeCount, false) {}
+
+    /* Zeroes the counters before another search. */
+    void reset() {
+        inFrontier.assign(inFrontier.size(), false);
+        expansions = 0;
+        reaches = 0;
+        frontier = 0;
+        frontierPeak = 0;
+    }
+
+    void reached(int id) {
+        reaches++;
+        if (!inFrontier[id]) {
+            inFrontier[id] = true;
+            if (++frontier > frontierPeak) {
+                frontierPeak = frontier;
+            }
+        }
+    }
+
+    void expanded(int id) {
+        expansions++;
+        if (inFrontier[id]) {
+            inFrontier[id] = false;
+            frontier--;
+        }
+    }
+
+    long long expansions = 0;
+    long long reaches = 0;
+    int frontierPeak = 0;
+
+private:
+    std::vector<bool> inFrontier;
+    int frontier = 0;
+};
+
+#endif // _searchtracer_h
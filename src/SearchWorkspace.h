@@ -0,0 +1,158 @@
+/**
+ * @brief This file declares and implements the reusable per-search state (g-scores,
+ * predecessors, open set, depth-first stack) of the point-to-point searches.
+ * @class SearchWorkspace.h
+ * @version 2026/10/16
+ */
+
+#ifndef _searchworkspace_h
+#define _searchworkspace_h
+
+#include "IndexedHeap.h"
+#include "TranspositionTable.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+/*
+ * The g-score, predecessor and open set of one side of a search over dense node
+ * IDs.
+ *
+ * Entries are tagged with the search they were written in, so starting a new
+ * search does not touch the arrays: an entry left over from an earlier search
+ * reads as unreached. A thread that answers many queries can therefore keep one
+ * workspace and pay for its allocation once.
+ */
+class SearchWorkspace {
+public:
+    /* Creates a workspace for graphs with the given number of nodes. */
+    explicit SearchWorkspace(int nodeCount = 0) {
+        resize(nodeCount);
+    }
+
+    /* Makes the workspace able to hold the given number of nodes, and empties it. */
+    void resize(int nodeCount) {
+        gScores.assign(nodeCount, INFINITY);
+        predecessors.assign(nodeCount, -1);
+        stamps.assign(nodeCount, 0);
+        currentStamp = 1;
+        open.reset(nodeCount);
+    }
+
+    /* Returns the number of nodes the workspace can hold. */
+    int nodeCount() const { return static_cast<int>(stamps.size()); }
+
+    /* Forgets everything written by the previous search. */
+    void begin() {
+        if (++currentStamp == 0) {
+            stamps.assign(stamps.size(), 0);
+            currentStamp = 1;
+        }
+        open.clear();
+    }
+
+    /* Returns the g-score of a node, or INFINITY if this search has not reached it. */
+    double gScore(int id) const {
+        return stamps[id] == currentStamp ? gScores[id] : INFINITY;
+    }
+
+    /* Returns the node a node was reached from, or -1 if it has none. */
+    int predecessor(int id) const {
+        return stamps[id] == currentStamp ? predecessors[id] : -1;
+    }
+
+    /* Records that a node was reached with the given g-score from the given node. */
+    void reach(int id, double gScore, int from) {
+        gScores[id] = gScore;
+        predecessors[id] = from;
+        stamps[id] = currentStamp;
+    }
+
+    /* Appends the nodes from the root of the predecessor chain down to id to path. */
+    void retrace(int id, std::vector<int>& path) const {
+        int first = static_cast<int>(path.size());
+        for (int v = id; v != -1; v = predecessor(v)) {
+            path.push_back(v);
+        }
+        std::reverse(path.begin() + first, path.end());
+    }
+
+    /* The open set of the search. */
+    IndexedHeap open;
+
+private:
+    std::vector<double> gScores;
+    std::vector<int> predecessors;
+    std::vector<unsigned> stamps;   // search in which each entry was written
+    unsigned currentStamp = 1;
+};
+
+/*
+ * The state of a depth-first search over dense node IDs, as used by IDA*: the
+ * current path from the root with the g-score of each node on it and the next
+ * arc to try from it, a per-node flag for membership in that path, and a
+ * transposition table capped at a fixed number of bytes.
+ *
+ * Only the table depends on the byte budget; the rest grows with the depth of
+ * the search, and the path flags with the size of the graph.
+ */
+class DepthFirstWorkspace {
+public:
+    /* The table budget used when none is given: 1 MiB, or 65536 nodes' entries. */
+    enum { DEFAULT_TABLE_BYTES = 1 << 20 };
+
+    /* Creates a workspace for graphs with the given number of nodes. */
+    explicit DepthFirstWorkspace(int nodeCount = 0, size_t tableBytes = DEFAULT_TABLE_BYTES)
+        : table(nodeCount, tableBytes),
+          onPath(nodeCount, false) {
+        // empty
+    }
+
+    /* Returns whether the given node is on the current path. */
+    bool isOnPath(int id) const { return onPath[id]; }
+
+    /* Returns the number of nodes on the current path. */
+    int depth() const { return static_cast<int>(path.size()); }
+
+    /* Extends the path by a node reached with the given g-score. */
+    void push(int id, double gScore, int firstArc) {
+        path.push_back(id);
+        gScores.push_back(gScore);
+        nextArcs.push_back(firstArc);
+        onPath[id] = true;
+    }
+
+    /* Removes the last node of the path. */
+    void pop() {
+        onPath[path.back()] = false;
+        path.pop_back();
+        gScores.pop_back();
+        nextArcs.pop_back();
+    }
+
+    /* Empties the path. */
+    void clear() {
+        while (!path.empty()) {
+            pop();
+        }
+    }
+
+    /* The last node of the path, its g-score, and the next arc to try from it. */
+    int top() const { return path.back(); }
+    double topGScore() const { return gScores.back(); }
+    int& topNextArc() { return nextArcs.back(); }
+
+    /* The nodes on the current path, from the root. */
+    const std::vector<int>& nodes() const { return path; }
+
+    /* Best g-scores the search has reached nodes with. */
+    TranspositionTable table;
+
+private:
+    std::vector<int> path;
+    std::vector<double> gScores;
+    std::vector<int> nextArcs;
+    std::vector<bool> onPath;
+};
+
+#endif // _searchworkspace_h
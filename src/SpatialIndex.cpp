@@ -0,0 +1,233 @@
+/**
+ * @brief This file implements the grid over node locations.
+ * @headerfile SpatialIndex.h
+ * @version 2026/10/16
+ */
+
+#include "SpatialIndex.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+namespace {
+    /* The average number of nodes a cell is sized to hold. */
+    const double NODES_PER_CELL = 2;
+}
+
+/*
+ * The cells are sized from the area of the bounding box, but never so small
+ * that a map whose nodes lie along one line gets more columns or rows than
+ * it has nodes.
+ */
+SpatialIndex::SpatialIndex(const CompiledRoadGraph& graph) {
+    int n = graph.nodeCount();
+    if (n > 0) {
+        double maxX = graph.x(0), maxY = graph.y(0);
+        minX = maxX;
+        minY = maxY;
+        for (int id = 1; id < n; id++) {
+            minX = std::min(minX, graph.x(id));
+            maxX = std::max(maxX, graph.x(id));
+            minY = std::min(minY, graph.y(id));
+            maxY = std::max(maxY, graph.y(id));
+        }
+        double width = maxX - minX;
+        double height = maxY - minY;
+        cellSize = std::max(std::sqrt(width * height * NODES_PER_CELL / n),
+                            std::max(width, height) / n);
+        if (!(cellSize > 0)) {
+            cellSize = 1;   // all nodes are at one spot
+        }
+        columns = static_cast<int>(width / cellSize) + 1;
+        rows = static_cast<int>(height / cellSize) + 1;
+    }
+
+    /* Sort the nodes into their cells by counting, keeping ID order within a cell. */
+    std::vector<int> cells(n);
+    cellOffsets.assign(columns * rows + 1, 0);
+    for (int id = 0; id < n; id++) {
+        cells[id] = cellRow(graph.y(id)) * columns + cellColumn(graph.x(id));
+        cellOffsets[cells[id] + 1]++;
+    }
+    for (int cell = 0; cell < columns * rows; cell++) {
+        cellOffsets[cell + 1] += cellOffsets[cell];
+    }
+    std::vector<int> next(cellOffsets.begin(), cellOffsets.end() - 1);
+    ids.resize(n);
+    xs.resize(n);
+    ys.resize(n);
+    slots.resize(n);
+    for (int id = 0; id < n; id++) {
+        int slot = next[cells[id]]++;
+        ids[slot] = id;
+        xs[slot] = graph.x(id);
+        ys[slot] = graph.y(id);
+        slots[id] = slot;
+    }
+}
+
+int SpatialIndex::cellColumn(double x) const {
+    double column = std::floor((x - minX) / cellSize);
+    return static_cast<int>(std::max(0.0, std::min(column, columns - 1.0)));
+}
+
+int SpatialIndex::cellRow(double y) const {
+    double row = std::floor((y - minY) / cellSize);
+    return static_cast<int>(std::max(0.0, std::min(row, rows - 1.0)));
+}
+
+/*
+ * Before ring r is read, every node not yet visited lies outside the block of
+ * cells the earlier rings cover, so it is at least as far away as the nearest
+ * side of that block past which the grid goes on.
+ */
+template <typename Visitor>
+void SpatialIndex::visitRings(double x, double y, Visitor visit) const {
+    int centerColumn = cellColumn(x);
+    int centerRow = cellRow(y);
+    double limit = INFINITY;
+    for (int r = 0; ; r++) {
+        if (r > 0) {
+            double gap = INFINITY;
+            if (centerColumn - r >= 0) {
+                gap = std::min(gap, x - (minX + (centerColumn - r + 1) * cellSize));
+            }
+            if (centerColumn + r < columns) {
+                gap = std::min(gap, minX + (centerColumn + r) * cellSize - x);
+            }
+            if (centerRow - r >= 0) {
+                gap = std::min(gap, y - (minY + (centerRow - r + 1) * cellSize));
+            }
+            if (centerRow + r < rows) {
+                gap = std::min(gap, minY + (centerRow + r) * cellSize - y);
+            }
+            if (gap == INFINITY) {
+                return;   // the rings have covered the whole grid
+            } else if (gap > 0 && gap * gap > limit) {
+                return;
+            }
+        }
+
+        int firstRow = std::max(centerRow - r, 0);
+        int lastRow = std::min(centerRow + r, rows - 1);
+        for (int row = firstRow; row <= lastRow; row++) {
+            bool wholeRow = row == centerRow - r || row == centerRow + r;
+            int step = wholeRow || r == 0 ? 1 : 2 * r;
+            for (int column = centerColumn - r; column <= centerColumn + r; column += step) {
+                if (column < 0 || column >= columns) {
+                    continue;
+                }
+                int cell = row * columns + column;
+                for (int slot = cellOffsets[cell]; slot < cellOffsets[cell + 1]; slot++) {
+                    double dx = xs[slot] - x;
+                    double dy = ys[slot] - y;
+                    limit = visit(ids[slot], dx * dx + dy * dy);
+                }
+            }
+        }
+    }
+}
+
+int SpatialIndex::nearest(double x, double y) const {
+    return nearest(x, y, INFINITY);
+}
+
+int SpatialIndex::nearest(double x, double y, double maxDistance) const {
+    if (ids.empty() || !(maxDistance >= 0)) {
+        return -1;
+    }
+    double bestDistance = maxDistance * maxDistance;
+    int best = INT_MAX;   // beaten by any node within maxDistance
+    visitRings(x, y, [&](int id, double distance) {
+        if (distance < bestDistance || (distance == bestDistance && id < best)) {
+            bestDistance = distance;
+            best = id;
+        }
+        return bestDistance;
+    });
+    return best == INT_MAX ? -1 : best;
+}
+
+/*
+ * The k best nodes so far are kept in result as a heap with the farthest on
+ * top, which is the one the next closer node replaces.
+ */
+void SpatialIndex::nearest(double x, double y, int k, std::vector<int>& result) const {
+    result.clear();
+    if (k <= 0) {
+        return;
+    }
+    auto closer = [&](int a, int b) {
+        double distanceA = squaredDistance(x, y, a);
+        double distanceB = squaredDistance(x, y, b);
+        return distanceA < distanceB || (distanceA == distanceB && a < b);
+    };
+    double farthest = INFINITY;   // squared distance of the heap top once the heap is full
+    visitRings(x, y, [&](int id, double distance) {
+        if (static_cast<int>(result.size()) < k) {
+            result.push_back(id);
+            std::push_heap(result.begin(), result.end(), closer);
+        } else if (distance < farthest || (distance == farthest && id < result.front())) {
+            std::pop_heap(result.begin(), result.end(), closer);
+            result.back() = id;
+            std::push_heap(result.begin(), result.end(), closer);
+        } else {
+            return farthest;
+        }
+        if (static_cast<int>(result.size()) == k) {
+            farthest = squaredDistance(x, y, result.front());
+        }
+        return farthest;
+    });
+    std::sort_heap(result.begin(), result.end(), closer);
+}
+
+void SpatialIndex::withinRadius(double x, double y, double radius,
+                                std::vector<int>& result) const {
+    result.clear();
+    if (ids.empty() || !(radius >= 0)) {
+        return;
+    }
+    double limit = radius * radius;
+    int lastRow = cellRow(y + radius);
+    int lastColumn = cellColumn(x + radius);
+    for (int row = cellRow(y - radius); row <= lastRow; row++) {
+        for (int column = cellColumn(x - radius); column <= lastColumn; column++) {
+            int cell = row * columns + column;
+            for (int slot = cellOffsets[cell]; slot < cellOffsets[cell + 1]; slot++) {
+                double dx = xs[slot] - x;
+                double dy = ys[slot] - y;
+                if (dx * dx + dy * dy <= limit) {
+                    result.push_back(ids[slot]);
+                }
+            }
+        }
+    }
+}
+
+void SpatialIndex::inRectangle(double left, double top, double right, double bottom,
+                               std::vector<int>& result) const {
+    result.clear();
+    if (left > right) {
+        std::swap(left, right);
+    }
+    if (top > bottom) {
+        std::swap(top, bottom);
+    }
+    if (ids.empty()) {
+        return;
+    }
+    int lastRow = cellRow(bottom);
+    int lastColumn = cellColumn(right);
+    for (int row = cellRow(top); row <= lastRow; row++) {
+        for (int column = cellColumn(left); column <= lastColumn; column++) {
+            int cell = row * columns + column;
+            for (int slot = cellOffsets[cell]; slot < cellOffsets[cell + 1]; slot++) {
+                if (xs[slot] >= left && xs[slot] <= right
+                        && ys[slot] >= top && ys[slot] <= bottom) {
+                    result.push_back(ids[slot]);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,95 @@
+/**
+ * @brief This file declares a grid over the node locations of a compiled graph
+ * that finds the nodes near a point or inside a rectangle.
+ * @class SpatialIndex.cpp
+ * @version 2026/10/16
+ */
+
+#ifndef _spatialindex_h
+#define _spatialindex_h
+
+#include "CompiledRoadGraph.h"
+#include <vector>
+
+/*
+ * A uniform grid over the on-screen locations of the nodes of a compiled graph.
+ *
+ * The bounding box of the nodes is cut into square cells sized so that a cell
+ * holds about two nodes on average, and the nodes are stored cell by cell in
+ * compressed-sparse-row form: the nodes of cell c occupy [cellOffsets[c],
+ * cellOffsets[c + 1]) of parallel ID and coordinate arrays. A query only reads
+ * the cells that overlap its region, so it takes microseconds however large
+ * the map is, and it allocates nothing beyond what its output vector needs.
+ *
+ * The index copies the coordinates it needs, so it stays valid after the graph
+ * it was built from is gone. Node IDs are those of that graph.
+ */
+class SpatialIndex {
+public:
+    /* Builds the index over the nodes of the given graph. */
+    explicit SpatialIndex(const CompiledRoadGraph& graph);
+
+    /* Returns the number of nodes in the index. */
+    int nodeCount() const { return static_cast<int>(ids.size()); }
+
+    /*
+     * Returns the ID of the node closest to (x, y), or -1 if the graph has no
+     * nodes. Of nodes at the same distance, the one with the smallest ID is chosen.
+     */
+    int nearest(double x, double y) const;
+
+    /*
+     * Like nearest(x, y), but returns -1 unless the closest node is at most
+     * maxDistance away.
+     */
+    int nearest(double x, double y, double maxDistance) const;
+
+    /*
+     * Fills result with the IDs of the k nodes closest to (x, y), closest first
+     * and ties broken by ID, or with every node if there are fewer than k.
+     */
+    void nearest(double x, double y, int k, std::vector<int>& result) const;
+
+    /*
+     * Fills result with the IDs of the nodes at most radius away from (x, y),
+     * in no particular order.
+     */
+    void withinRadius(double x, double y, double radius, std::vector<int>& result) const;
+
+    /*
+     * Fills result with the IDs of the nodes inside the rectangle with the given
+     * corners, edges included, in no particular order.
+     */
+    void inRectangle(double left, double top, double right, double bottom,
+                     std::vector<int>& result) const;
+
+private:
+    /* Returns the squared distance from (x, y) to a node. */
+    double squaredDistance(double x, double y, int id) const {
+        double dx = xs[slots[id]] - x;
+        double dy = ys[slots[id]] - y;
+        return dx * dx + dy * dy;
+    }
+
+    int cellColumn(double x) const;
+    int cellRow(double y) const;
+
+    /*
+     * Visits the cells in square rings of growing size around the cell nearest
+     * (x, y), handing each stored node to visit, which returns the squared
+     * distance beyond which nodes no longer matter. Stops once every cell left
+     * is farther away than that.
+     */
+    template <typename Visitor>
+    void visitRings(double x, double y, Visitor visit) const;
+
+    double minX = 0, minY = 0;
+    double cellSize = 1;
+    int columns = 1, rows = 1;
+    std::vector<int> cellOffsets;   // columns * rows + 1 offsets into the node arrays
+    std::vector<int> ids;           // node IDs, cell by cell
+    std::vector<double> xs, ys;     // their coordinates
+    std::vector<int> slots;         // where each node ID is in the node arrays
+};
+
+#endif // _spatialindex_h
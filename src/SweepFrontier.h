@@ -0,0 +1,112 @@
+/**
+ * @brief This file declares and implements the frontier of the periphery sweep
+ * and memory-optimized IDA* searches.
+ * @class SweepFrontier.h
+ * @version 2026/10/16
+ */
+
+#ifndef _sweepfrontier_h
+#define _sweepfrontier_h
+
+#include <vector>
+
+/*
+ * An ordered list of node IDs in [0, capacity), each stored next to the f-score
+ * it had when it was added, that the threshold sweeps walk from front to back.
+ *
+ * Entries live in two parallel arrays in the order they were added. Adding an ID
+ * that is already listed moves it to the back; removing one leaves a hole behind,
+ * so positions do not change while a sweep is walking the arrays, and entries
+ * added during a sweep are reached later in the same sweep. compact() squeezes
+ * the holes out between sweeps. A sweep therefore reads its candidates and their
+ * f-scores from contiguous memory, and only touches the graph and the g-scores for
+ * the nodes it actually expands.
+ */
+class SweepFrontier {
+public:
+    /* The ID read back from a slot whose entry was removed. */
+    enum { REMOVED = -1 };
+
+    /* Creates an empty frontier that can hold IDs in [0, capacity). */
+    explicit SweepFrontier(int capacity = 0) {
+        reset(capacity);
+    }
+
+    /* Empties the frontier and makes it able to hold IDs in [0, capacity). */
+    void reset(int capacity) {
+        ids.clear();
+        fScores.clear();
+        slotOf.assign(capacity, NOT_LISTED);
+        live = 0;
+    }
+
+    /* Empties the frontier in time proportional to its current size. */
+    void clear() {
+        for (int id : ids) {
+            if (id != REMOVED) {
+                slotOf[id] = NOT_LISTED;
+            }
+        }
+        ids.clear();
+        fScores.clear();
+        live = 0;
+    }
+
+    /* Returns whether no IDs are listed. */
+    bool isEmpty() const { return live == 0; }
+
+    /* Returns the number of slots, including those left behind by removals. */
+    int slotCount() const { return static_cast<int>(ids.size()); }
+
+    /* Returns the ID in a slot, or REMOVED, and the f-score it was added with. */
+    int idAt(int slot) const { return ids[slot]; }
+    double fScoreAt(int slot) const { return fScores[slot]; }
+
+    /* Returns whether the given ID is listed. */
+    bool contains(int id) const { return slotOf[id] != NOT_LISTED; }
+
+    /* Lists an ID at the back with the given f-score, moving it if already listed. */
+    void pushBack(int id, double fScore) {
+        remove(id);
+        slotOf[id] = static_cast<int>(ids.size());
+        ids.push_back(id);
+        fScores.push_back(fScore);
+        live++;
+    }
+
+    /* Removes an ID from the frontier; does nothing if it is not listed. */
+    void remove(int id) {
+        int slot = slotOf[id];
+        if (slot != NOT_LISTED) {
+            ids[slot] = REMOVED;
+            slotOf[id] = NOT_LISTED;
+            live--;
+        }
+    }
+
+    /* Closes the holes left by removals, keeping the listed IDs in order. */
+    void compact() {
+        int kept = 0;
+        for (int slot = 0; slot < static_cast<int>(ids.size()); slot++) {
+            int id = ids[slot];
+            if (id != REMOVED) {
+                ids[kept] = id;
+                fScores[kept] = fScores[slot];
+                slotOf[id] = kept;
+                kept++;
+            }
+        }
+        ids.resize(kept);
+        fScores.resize(kept);
+    }
+
+private:
+    enum { NOT_LISTED = -1 };
+
+    std::vector<int> ids;          // listed IDs in order, REMOVED for holes
+    std::vector<double> fScores;   // the f-score each slot's ID was added with
+    std::vector<int> slotOf;       // slot of each listed ID, NOT_LISTED otherwise
+    int live;                      // number of listed IDs
+};
+
+#endif // _sweepfrontier_h
@@ -0,0 +1,119 @@
+/**
+ * @brief This file declares and implements a fixed-size table of the best g-scores
+ * an iterative-deepening search has reached nodes with.
+ * @class TranspositionTable.h
+ * @version 2026/10/16
+ */
+
+#ifndef _transpositiontable_h
+#define _transpositiontable_h
+
+#include <cstddef>
+#include <vector>
+
+/*
+ * A direct-mapped cache from node ID to the cheapest g-score the current search
+ * has reached the node with, used by IDA* to skip paths that are known to be no
+ * better than one it has already followed.
+ *
+ * The table never grows past the byte budget it is created with. If the budget
+ * covers one entry per node of the graph, each node gets its own slot; otherwise
+ * the table holds the largest power of two of entries that fits, and a node whose
+ * slot is taken simply evicts the entry there. Losing an entry only costs
+ * pruning, never correctness, so the budget trades memory for re-expansions. A
+ * budget too small for a single entry turns the table off.
+ *
+ * Entries are stamped with the search and iteration that wrote them, so starting
+ * either one does not touch the table.
+ */
+class TranspositionTable {
+public:
+    /*
+     * Creates a table for graphs with the given number of nodes that uses at most
+     * the given number of bytes.
+     */
+    TranspositionTable(int nodeCount, size_t maxBytes) {
+        if (static_cast<size_t>(nodeCount) * sizeof(Entry) <= maxBytes) {
+            entries.resize(nodeCount);
+            direct = true;
+        } else if (sizeof(Entry) <= maxBytes) {
+            size_t capacity = 1;
+            while (capacity * 2 * sizeof(Entry) <= maxBytes) {
+                capacity *= 2;
+            }
+            entries.resize(capacity);
+            while ((size_t(1) << indexBits) < capacity) {
+                indexBits++;
+            }
+        }
+    }
+
+    /* Returns the number of entries the table holds. */
+    int capacity() const { return static_cast<int>(entries.size()); }
+
+    /* Forgets every entry written by earlier searches. */
+    void beginSearch() {
+        beginIteration();
+        searchStamp = stamp;
+    }
+
+    /*
+     * Starts another iteration of the same search. Entries from earlier iterations
+     * are kept, but a node may be reached again with the same g-score once per
+     * iteration.
+     */
+    void beginIteration() {
+        if (++stamp == 0) {
+            for (Entry& entry : entries) {
+                entry.stamp = 0;
+            }
+            stamp = 1;
+            searchStamp = 1;
+        }
+    }
+
+    /*
+     * Returns whether a node reached with the given g-score is worth searching
+     * from, and records the g-score if so. It is not if this search has already
+     * reached the node more cheaply, or equally cheaply in this iteration.
+     */
+    bool admit(int id, double gScore) {
+        if (entries.empty()) {
+            return true;
+        }
+        Entry& entry = entries[slotOf(id)];
+        if (entry.id == id && entry.stamp >= searchStamp) {
+            if (gScore > entry.gScore || (gScore == entry.gScore && entry.stamp == stamp)) {
+                return false;
+            }
+        }
+        entry.id = id;
+        entry.stamp = stamp;
+        entry.gScore = gScore;
+        return true;
+    }
+
+private:
+    struct Entry {
+        int id = -1;
+        unsigned stamp = 0;   // iteration that wrote the entry
+        double gScore = 0;
+    };
+
+    /* Returns the slot of an ID, spreading IDs over a small table (Fibonacci hashing). */
+    size_t slotOf(int id) const {
+        if (direct) {
+            return id;
+        }
+        unsigned hash = static_cast<unsigned>(id) * 2654435769u;
+        return indexBits == 0 ? 0 : hash >> (32 - indexBits);
+    }
+
+    std::vector<Entry> entries;
+    bool direct = false;        // one slot per node
+    int indexBits = 0;          // log2 of the capacity of a hashed table
+    unsigned stamp = 0;         // current iteration
+    unsigned searchStamp = 0;   // first iteration of the current search
+};
+
+#endif // _transpositiontable_h
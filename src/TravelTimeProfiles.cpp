@@ -0,0 +1,64 @@
+/**
+ * @brief This file implements the store of travel time profiles.
+ * @headerfile TravelTimeProfiles.h
+ * @version 2026/10/16
+ */
+
+#include "TravelTimeProfiles.h"
+#include "error.h"
+#include <functional>
+
+/*
+ * Identical profiles are found by hashing their breakpoints; the profiles
+ * with the same hash are then compared point by point.
+ */
+int TravelTimeProfiles::add(const std::vector<Breakpoint>& breakpoints) {
+    if (breakpoints.empty()) {
+        error("TravelTimeProfiles::add: a profile needs at least one breakpoint");
+    }
+    size_t hash = breakpoints.size();
+    std::hash<double> hashDouble;
+    for (size_t i = 0; i < breakpoints.size(); i++) {
+        if (i > 0 && !(breakpoints[i].time > breakpoints[i - 1].time)) {
+            error("TravelTimeProfiles::add: breakpoint times must strictly increase");
+        }
+        if (!(breakpoints[i].factor > 0)) {
+            error("TravelTimeProfiles::add: factors must be positive");
+        }
+        hash = hash * 31 + hashDouble(breakpoints[i].time);
+        hash = hash * 31 + hashDouble(breakpoints[i].factor);
+    }
+
+    auto range = byHash.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        int profile = it->second;
+        if (offsets[profile + 1] - offsets[profile] != static_cast<int>(breakpoints.size())) {
+            continue;
+        }
+        const Breakpoint* stored = points.data() + offsets[profile];
+        bool same = true;
+        for (size_t i = 0; i < breakpoints.size() && same; i++) {
+            same = stored[i].time == breakpoints[i].time
+                    && stored[i].factor == breakpoints[i].factor;
+        }
+        if (same) {
+            return profile;
+        }
+    }
+
+    int profile = profileCount();
+    double minimum = breakpoints[0].factor;
+    double fall = 0;
+    for (size_t i = 1; i < breakpoints.size(); i++) {
+        minimum = std::min(minimum, breakpoints[i].factor);
+        fall = std::min(fall, (breakpoints[i].factor - breakpoints[i - 1].factor)
+                              / (breakpoints[i].time - breakpoints[i - 1].time));
+    }
+    points.insert(points.end(), breakpoints.begin(), breakpoints.end());
+    offsets.push_back(static_cast<int>(points.size()));
+    minimums.push_back(minimum);
+    falls.push_back(fall);
+    smallest = profile == 0 ? minimum : std::min(smallest, minimum);
+    byHash.insert(std::make_pair(hash, profile));
+    return profile;
+}
@@ -0,0 +1,93 @@
+/**
+ * @brief This file declares the store of travel time profiles that make edge
+ * costs depend on the time of day.
+ * @class TravelTimeProfiles.cpp
+ * @version 2026/10/16
+ */
+
+#ifndef _traveltimeprofiles_h
+#define _traveltimeprofiles_h
+
+#include <algorithm>
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * A set of travel time profiles, each a piecewise-linear function of the time
+ * at which an edge is entered. A profile is given by breakpoints (time, factor)
+ * with strictly increasing times; between two breakpoints the factor is
+ * interpolated linearly, and before the first or after the last one it stays
+ * at that breakpoint's factor. The travel time of an edge with a profile is its
+ * weight times the factor at the time it is entered, so one profile (a morning
+ * rush hour, say) can be shared by every edge that follows it. Times are in the
+ * same units as the edge weights.
+ *
+ * All profiles are kept back to back in one array of breakpoints, and adding a
+ * profile that is already in the store returns the ID of the one stored, so a
+ * map with many edges that share a handful of shapes stores each shape once.
+ * Evaluating a profile only reads that array.
+ */
+class TravelTimeProfiles {
+public:
+    /* One breakpoint of a profile. */
+    struct Breakpoint {
+        double time;
+        double factor;
+    };
+
+    /* Returns the number of distinct profiles. */
+    int profileCount() const { return static_cast<int>(offsets.size()) - 1; }
+
+    /* Returns the total number of breakpoints stored. */
+    int breakpointCount() const { return static_cast<int>(points.size()); }
+
+    /*
+     * Adds a profile and returns its ID, or the ID of an identical profile
+     * that is already stored.
+     *
+     * Throws an ErrorException if there are no breakpoints, their times do not
+     * strictly increase, or a factor is not positive.
+     */
+    int add(const std::vector<Breakpoint>& breakpoints);
+
+    /* Returns the factor of a profile at the given time. */
+    double factorAt(int profile, double time) const {
+        const Breakpoint* first = points.data() + offsets[profile];
+        const Breakpoint* last = points.data() + offsets[profile + 1] - 1;
+        if (time <= first->time) {
+            return first->factor;
+        } else if (time >= last->time) {
+            return last->factor;
+        }
+        const Breakpoint* after = std::upper_bound(first, last, time,
+                [](double t, const Breakpoint& point) { return t < point.time; });
+        const Breakpoint* before = after - 1;
+        return before->factor + (after->factor - before->factor)
+                * (time - before->time) / (after->time - before->time);
+    }
+
+    /* Returns the smallest factor of a profile. */
+    double minimumFactor(int profile) const { return minimums[profile]; }
+
+    /* Returns the smallest factor of any profile, or 1 if there are none. */
+    double minimumFactor() const { return smallest; }
+
+    /*
+     * Returns the steepest fall of a profile's factor per unit of time, as a
+     * negative slope, or 0 if it never falls. An edge of weight w with the
+     * profile can be left earlier by entering it later, which searches do not
+     * expect, unless w times this slope is at least -1.
+     */
+    double steepestFall(int profile) const { return falls[profile]; }
+
+private:
+    std::vector<int> offsets = std::vector<int>(1, 0);   // profileCount() + 1 offsets into points
+    std::vector<Breakpoint> points;
+    std::vector<double> minimums;
+    std::vector<double> falls;
+    double smallest = 1;
+    std::unordered_multimap<size_t, int> byHash;   // profiles by the hash of their breakpoints
+};
+
+#endif // _traveltimeprofiles_h
@@ -0,0 +1,78 @@
+/**
+ * @brief This file implements the turn cost model.
+ * @headerfile TurnCosts.h
+ * @version 2026/10/16
+ */
+
+#include "TurnCosts.h"
+#include "error.h"
+#include <algorithm>
+
+TurnCosts::TurnCosts(const CompiledRoadGraph& graph, const TurnPenalties& penalties,
+                     const std::vector<TurnRestriction>& restrictions)
+    : graph(graph),
+      penalties(penalties),
+      hasRestrictions(graph.nodeCount(), false) {
+    if (penalties.leftTurn < 0 || penalties.rightTurn < 0 || penalties.uTurn < 0) {
+        error("TurnCosts::TurnCosts: turn penalties must not be negative");
+    }
+    for (const TurnRestriction& restriction : restrictions) {
+        int inArc = restriction.from ? graph.arcOf(restriction.from) : -1;
+        int outArc = restriction.to ? graph.arcOf(restriction.to) : -1;
+        if (inArc == -1 || outArc == -1) {
+            error("TurnCosts::TurnCosts: restricted edge is not in the graph");
+        }
+        int via = graph.arcTarget(inArc);
+        if (graph.idOf(restriction.to->from()) != via) {
+            error("TurnCosts::TurnCosts: restricted edges do not meet at a node");
+        }
+        if (!(restriction.penalty >= 0)) {
+            error("TurnCosts::TurnCosts: turn penalties must not be negative");
+        }
+        Turn turn = { inArc, outArc, restriction.penalty };
+        restricted.push_back(turn);
+        hasRestrictions[via] = true;
+    }
+
+    /* Keep one entry per turn, with the highest penalty listed for it. */
+    std::sort(restricted.begin(), restricted.end(), [](const Turn& a, const Turn& b) {
+        return a < b || (!(b < a) && a.penalty > b.penalty);
+    });
+    restricted.erase(std::unique(restricted.begin(), restricted.end(),
+                                 [](const Turn& a, const Turn& b) {
+                                     return !(a < b) && !(b < a);
+                                 }),
+                     restricted.end());
+}
+
+/*
+ * The bend is measured with the cross and dot products of the two directions:
+ * it is sharper than 45 degrees exactly when the cross product outweighs the dot
+ * product, so no angle has to be computed. With y growing downward, a negative
+ * cross product is a turn to the left.
+ */
+double TurnCosts::cost(int from, int via, int inArc, int outArc) const {
+    int to = graph.arcTarget(outArc);
+    if (hasRestrictions[via]) {
+        Turn key = { inArc, outArc, 0 };
+        auto found = std::lower_bound(restricted.begin(), restricted.end(), key);
+        if (found != restricted.end() && found->inArc == inArc && found->outArc == outArc) {
+            return found->penalty;
+        }
+    }
+    if (to == from) {
+        return penalties.uTurn;
+    }
+    double inX = graph.x(via) - graph.x(from);
+    double inY = graph.y(via) - graph.y(from);
+    double outX = graph.x(to) - graph.x(via);
+    double outY = graph.y(to) - graph.y(via);
+    double cross = inX * outY - inY * outX;
+    double dot = inX * outX + inY * outY;
+    if (std::fabs(cross) <= dot) {
+        return 0;
+    } else if (cross == 0) {
+        return penalties.uTurn;   // straight back along another road
+    }
+    return cross < 0 ? penalties.leftTurn : penalties.rightTurn;
+}
@@ -0,0 +1,83 @@
+/**
+ * @brief This file declares the turn cost model used by the edge-based search:
+ * penalties for left turns, right turns and U-turns taken from the geometry of
+ * each junction, and turn restrictions read from the map file.
+ * @class TurnCosts.cpp
+ * @version 2026/10/16
+ */
+
+#ifndef _turncosts_h
+#define _turncosts_h
+
+#include "CompiledRoadGraph.h"
+#include "RoadGraph.h"
+#include <cmath>
+#include <vector>
+
+/* The penalty added for each kind of turn, in the units of the edge costs. */
+struct TurnPenalties {
+    double leftTurn = 0;
+    double rightTurn = 0;
+    double uTurn = 0;
+};
+
+/*
+ * A turn listed in the map file: going on from one edge onto another that
+ * leaves the node the first one enters costs the given penalty instead of what
+ * the geometry says, and an infinite penalty forbids the turn.
+ */
+struct TurnRestriction {
+    RoadEdge* from = nullptr;
+    RoadEdge* to = nullptr;
+    double penalty = INFINITY;
+};
+
+/*
+ * The cost of every turn of a compiled graph, worked out when it is asked for
+ * rather than stored per pair of arcs.
+ *
+ * A turn from u -> v onto v -> w is a U-turn if w is u. Otherwise it is a left
+ * or right turn if the road bends by more than 45 degrees that way at v, judged
+ * from the node locations on screen (where y grows downward), and free if it
+ * bends less. Turns listed as restrictions are kept in a sorted array that is
+ * only searched at nodes that have any; if a turn is listed twice, the higher
+ * penalty applies.
+ */
+class TurnCosts {
+public:
+    /*
+     * Prepares the turn costs of the given graph, which must outlive them.
+     *
+     * Throws an ErrorException if a restriction names an edge that is not in
+     * the graph, if its edges do not meet at a node, or if a penalty is negative.
+     */
+    TurnCosts(const CompiledRoadGraph& graph, const TurnPenalties& penalties,
+              const std::vector<TurnRestriction>& restrictions = std::vector<TurnRestriction>());
+
+    /*
+     * Returns the cost of going on from inArc, which runs from "from" to via, onto
+     * outArc, which leaves via.
+     */
+    double cost(int from, int via, int inArc, int outArc) const;
+
+    /* Returns the number of turns with a restriction. */
+    int restrictionCount() const { return static_cast<int>(restricted.size()); }
+
+private:
+    struct Turn {
+        int inArc;
+        int outArc;
+        double penalty;
+
+        bool operator <(const Turn& other) const {
+            return inArc < other.inArc || (inArc == other.inArc && outArc < other.outArc);
+        }
+    };
+
+    const CompiledRoadGraph& graph;
+    TurnPenalties penalties;
+    std::vector<Turn> restricted;       // sorted by arc pair
+    std::vector<bool> hasRestrictions;  // per node: whether a listed turn passes it
+};
+
+#endif // _turncosts_h
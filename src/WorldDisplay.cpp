@@ -3,11 +3,17 @@
  * See WorldDisplay.h for declarations and documentation of each member.
  * @headerfile WorldDisplay.h
  * @author Richik Vivek Sen
+ * @version 2026/10/17
+ * - maps are read with RoadMapReader and compiled for searching once read
+ * - vertex picking uses the spatial index
+ * - full redraws are sent to the back-end as one batch
+ * - search animations are drawn on a renderer thread (see AsyncRenderer)
+ * - the turn restrictions of a map are kept for the edge-based search
  * @version 2019/04/08
- * @attention Do not modify this file
  */
 
 #include "WorldDisplay.h"
+#include "RoadMapReader.h"
 #include <cmath>
 #include <fstream>
 #include <sstream>
@@ -42,25 +48,19 @@ namespace {
 
     const double PATH_LINE_WIDTH = 3.0;
 
+    /* Returns the string form of a node color, for drawing. */
+    std::string colorString(Color c) {
+        int r, g, b;
+        colorToRGB(c, r, g, b);
+        return rgbToColor(r, g, b);
+    }
+
     void polarMove(double x, double y, double r, double theta, double& newX, double& newY) {
         double dx = std::cos(theta) * r;
         double dy = std::sin(theta) * -r;
         newX = x + dx;
         newY = y - dy;
     }
-
-    /* Reads files from the stream until a non-empty, non-comment line is read. */
-    bool getMeaningfulLine(std::istream& input, std::string& line) {
-        std::string lineOut;
-        while (getline(input, lineOut)) {
-            trimInPlace(lineOut);
-            if (!lineOut.empty() && lineOut[0] != '#') {
-                line = lineOut;
-                return true;
-            }
-        }
-        return false;
-    }
 }
 
 const int WorldDisplay::WINDOW_MARGIN = 5;
@@ -71,9 +71,12 @@ WorldDisplay::WorldDisplay(GWindow* gwnd)
       windowWidth(0),
       windowHeight(0),
       graph(nullptr),
+      roadGraph(nullptr),
       selectedStart(nullptr),
       selectedEnd(nullptr),
-      backgroundImage(nullptr) {
+      backgroundImage(nullptr),
+      renderer(nullptr),
+      repaintBeforeAnimation(true) {
     largeMapDisplay = true;
     windowWidth = gwnd->getWidth() - 2 * WINDOW_MARGIN;
     windowHeight = gwnd->getHeight() - 2 * WINDOW_MARGIN;
@@ -84,10 +87,13 @@ WorldDisplay::~WorldDisplay() {
     clearPath(false);
 
     delete backgroundImage;
+    delete renderer;
+    delete roadGraph;
     delete graph;
 }
 
 void WorldDisplay::clearPath(bool redraw) {
+    gwnd->beginBatch();
     for (GLine* line : highlightedPath) {
         gwnd->remove(line);
         delete line;
@@ -97,6 +103,7 @@ void WorldDisplay::clearPath(bool redraw) {
     if (redraw) {
         draw();
     }
+    gwnd->endBatch();
 }
 
 void WorldDisplay::clearSelection(bool redraw) {
@@ -111,6 +118,14 @@ Graph<RoadNode, RoadEdge>* WorldDisplay::getGraph() const {
     return graph;
 }
 
+const RoadGraph* WorldDisplay::getRoadGraph() const {
+    return roadGraph;
+}
+
+const std::vector<TurnRestriction>& WorldDisplay::getTurnRestrictions() const {
+    return turnRestrictions;
+}
+
 const GDimension& WorldDisplay::getPreferredSize() const {
     return preferredSize;
 }
@@ -228,9 +243,14 @@ void WorldDisplay::drawVertexCircle(RoadNode* v, std::string color, bool fill) {
     gwnd->draw(&oval);
 }
 
+/*
+ * The whole scene is collected in a batch and sent to the back end in one
+ * write; on large maps, which draw no labels, nothing in it waits for a reply.
+ */
 void WorldDisplay::draw() {
     bool before = gwnd->isRepaintImmediately();
     gwnd->setRepaintImmediately(false);
+    gwnd->beginBatch();
     if (backgroundImage) {
         gwnd->draw(backgroundImage);
     }
@@ -255,11 +275,13 @@ void WorldDisplay::draw() {
     }
     gwnd->setRepaintImmediately(before);
     gwnd->repaint();
+    gwnd->endBatch();
 }
 
 void WorldDisplay::drawPath(Vector<RoadNode*>& path, std::string color) {
     bool before = gwnd->isRepaintImmediately();
     gwnd->setRepaintImmediately(false);
+    gwnd->beginBatch();
     for (int i = 1; i < path.size(); i++) {
         // highlight connection between path[i - 1] and path[i]
         Point p1 = path[i - 1]->location();
@@ -272,6 +294,7 @@ void WorldDisplay::drawPath(Vector<RoadNode*>& path, std::string color) {
     }
     gwnd->repaint();
     gwnd->setRepaintImmediately(before);
+    gwnd->endBatch();
 }
 
 std::string WorldDisplay::getDescription(double x, double y) const {
@@ -291,17 +314,16 @@ std::string WorldDisplay::getType() const {
     return "map";
 }
 
+/*
+ * Asks the spatial index for the closest node within a vertex radius of the
+ * click, so that picking does not touch every node on the map.
+ */
 RoadNode* WorldDisplay::getVertex(double x, double y) const {
-    for (auto* v : *graph) {
-        Point p = v->location();
-        GOval oval(p.getX() - VERTEX_RADIUS,
-                   p.getY() - VERTEX_RADIUS,
-                   2 * VERTEX_RADIUS, 2 * VERTEX_RADIUS);
-        if (oval.contains(x, y)) {
-            return v;
-        }
+    if (!roadGraph) {
+        return nullptr;
     }
-    return nullptr;
+    int id = roadGraph->spatialIndex().nearest(x, y, VERTEX_RADIUS);
+    return id == -1 ? nullptr : roadGraph->compile().nodeAt(id);
 }
 
 void WorldDisplay::handleClick(double x, double y) {
@@ -336,166 +358,55 @@ void WorldDisplay::handleClick(double x, double y) {
 }
 
 bool WorldDisplay::read(std::istream& input) {
+    if (renderer) {
+        delete renderer;
+        renderer = nullptr;
+    }
+    if (roadGraph) {
+        delete roadGraph;
+        roadGraph = nullptr;
+    }
     if (graph) {
         delete graph;
     }
     graph = new Graph<RoadNode, RoadEdge>();
+    turnRestrictions.clear();
     largeMapDisplay = false;
 
-    std::string line;
-    if (!getMeaningfulLine(input, line)) {   // "FLAGS or IMAGE"
-        std::cerr << "Invalid input file; file is empty" << std::endl;
-        return false;
-    }
-    if(line == "FLAGS") {
-        std::string flagLine;
-        while (true) {
-            if(!getMeaningfulLine(input, flagLine)) {
-                std::cerr << "Invalid input file; missing \"IMAGE\" header" << std::endl;
-                return false;
-            }
-            if(flagLine == "IMAGE") break;
-            Vector<std::string> parts = stringSplit(flagLine, "=");
-            if(parts[0] == "largeMapDisplay") {
-                largeMapDisplay = parts[1] == "true";
-            }
-        }
-    }
-
-
-    std::string imageFile;
-    if (!getMeaningfulLine(input, imageFile)) {
-        std::cerr << "Invalid input file; missing image file name" << std::endl;
-        return false;
-    }
-    if (!fileExists(imageFile)) {
-        std::cerr << "Invalid input file; specified image file \""
-                  << imageFile << "\" does not exist" << std::endl;
-        return false;
-    }
-    backgroundImage = new GImage(imageFile);
-
-    int width = 0;
-    if (!getMeaningfulLine(input, line)) {
-        std::cerr << "Invalid input file; missing width" << std::endl;
-        return false;
-    }
-    if (!stringIsInteger(line)) {
-        std::cerr << "Invalid input file; non-integer width \""
-                  << line << "\"" << std::endl;
-        return false;
-    }
-    width = stringToInteger(line);
-
-    int height = 0;
-    if (!getMeaningfulLine(input, line)) {
-        std::cerr << "Invalid input file; missing height" << std::endl;
+    RoadMapHeader header;
+    if (!readRoadMapHeader(input, header)) {
         return false;
     }
-    if (!stringIsInteger(line)) {
-        std::cerr << "Invalid input file; non-integer height \""
-                  << line << "\"" << std::endl;
-        return false;
-    }
-    height = stringToInteger(line);
-    preferredSize = GDimension(width, height);
-    windowWidth = width;
-    windowHeight = height;
-
-    getline(input, line);  // VERTICES
-    while (getMeaningfulLine(input, line)) {
-        // "Hobbiton;147;86"
-        std::vector<std::string> tokens = stringSplit(line, ";");
-        if (tokens.size() >= 1 && (tokens[0] == "ARCS" || tokens[0] == "EDGES")) {
-            break;
-        } else if (tokens.size() < 3) {
-            continue;
-        }
-
-        std::string name = trim(tokens[0]);
-        if (graph->containsNode(name)) {
-            std::cerr << "Invalid input file; duplicate vertex \""
-                      << name << "\"" << std::endl;
-            return false;
-        }
-
-        if (!stringIsInteger(tokens[1]) || !stringIsInteger(tokens[2])) {
-            std::cerr << "Invalid input file; non-integer coordinates for vertex \""
-                      << name << "\"" << std::endl;
-            return false;
-        }
-        int vertexX = stringToInteger(tokens[1]);
-        int vertexY = stringToInteger(tokens[2]);
-        if (vertexX < 0 || vertexY < 0) {
-            std::cerr << "Invalid input file; negative coordinates for vertex \""
-                      << name << "\"" << std::endl;
-            return false;
-        }
-
-        RoadNode* node = new RoadNode(name, {vertexX, vertexY});
+    largeMapDisplay = header.largeMapDisplay;
+    backgroundImage = new GImage(header.imageFile);
+    preferredSize = GDimension(header.width, header.height);
+    windowWidth = header.width;
+    windowHeight = header.height;
+
+    /*
+     * The GUI only runs static searches and has no way to pick a departure time,
+     * so the travel time profiles a map may name are checked but not stored, and
+     * every edge keeps its fixed cost. The benchmark runs the time-dependent search.
+     * The turn restrictions are kept for the edge-based search.
+     */
+    bool graphRead = readRoadMapGraph(input, *graph, nullptr, &turnRestrictions);
+    for (RoadNode* node : *graph) {
         node->addObserver(this);
-        graph->addNode(node);
     }
-
-    while (getMeaningfulLine(input, line)) {
-        // "Hobbiton;Southfarthing;1"
-        std::vector<std::string> tokens = stringSplit(line, ";");
-        if (tokens.size() < 3) {
-            break;
-        }
-        std::string name1 = trim(tokens[0]);
-        std::string name2 = trim(tokens[1]);
-
-        if (!graph->containsNode(name1)) {
-            std::cerr << "Invalid input file; when reading edge between \""
-                      << name1 << "\" and \"" << name2
-                      << "\", graph does not contain a vertex named \""
-                      << name1 << "\"" << std::endl;
-            return false;
-        }
-        if (!graph->containsNode(name2)) {
-            std::cerr << "Invalid input file; when reading edge between \""
-                      << name1 << "\" and \"" << name2
-                      << "\", graph does not contain a vertex named \""
-                      << name2 << "\"" << std::endl;
-            return false;
-        }
-
-        if (!stringIsReal(tokens[2])) {
-            std::cerr << "Invalid input file; non-numeric weight for edge between \""
-                      << name1 << "\" and \"" << name2 << "\"" << std::endl;
-            return false;
-        }
-
-        double weight = stringToReal(tokens[2]);
-        if (weight < 0) {
-            std::cerr << "Invalid input file; negative weight for edge between \""
-                      << name1 << "\" and \"" << name2 << "\"" << std::endl;
-            return false;
-        }
-
-
-
-        // edges are undirected (both ways) by default
-        bool directed = false;
-        if (tokens.size() >= 4 && stringIsBool(tokens[3])) {
-            directed = stringToBool(tokens[3]);
-        }
-
-        /* Add the forward edge. */
-        RoadEdge* edge = new RoadEdge(graph->getNode(name1), graph->getNode(name2), weight);
-        graph->addArc(edge);
-
-        /* The graph might be undirected, in which case we should add the reverse edge as
-         * well.
-         */
-        if (!directed) {
-            RoadEdge* revEdge = new RoadEdge(graph->getNode(name2), graph->getNode(name1), weight);
-            graph->addArc(revEdge);
-        }
+    if (!graphRead) {
+        return false;
     }
 
-
+    /* Freeze the finished graph once so every search can share the snapshot,
+     * and index its node locations for picking vertices.
+     */
+    roadGraph = new RoadGraph(graph);
+    roadGraph->compile();
+    roadGraph->spatialIndex();
+    renderer = new AsyncRenderer(roadGraph->compile().nodeCount(),
+                                 [this](const std::vector<ColorEvent>& frame) {
+                                     drawColorFrame(frame);
+                                 });
     return true;
 }
 
@@ -515,10 +426,12 @@ void WorldDisplay::resetState() {
 void WorldDisplay::update(Observable<Color>* obs, const Color& c) {
     auto* v = static_cast<RoadNode*>(obs);
 
-    int r, g, b;
-    colorToRGB(c, r, g, b);
-    std::string color = rgbToColor(r, g, b);
-    drawVertexCircle(v, color);
+    bool animating = renderer && renderer->isRunning();
+    if (animating) {
+        renderer->publish(roadGraph->compile().idOf(v), c);
+    } else {
+        drawVertexCircle(v, colorString(c));
+    }
 
     /* Record the color for posterity.
      *
@@ -532,7 +445,49 @@ void WorldDisplay::update(Observable<Color>* obs, const Color& c) {
     /* Don't notify the observers if a node is colored gray. The observers
      * are only notified in cases where the animation delay should be put into
      * effect, and no (correct) implementation of these algorithms ever does
-     * this as part of routine processing.
+     * this as part of routine processing. During an animation the renderer
+     * thread paces the drawing instead, so there is nothing to wait for.
      */
-    if (c != Color::WHITE) notifyObservers(UIEvent::VERTEX_COLORED);
+    if (c != Color::WHITE && !animating) notifyObservers(UIEvent::VERTEX_COLORED);
+}
+
+void WorldDisplay::beginAnimation(int frameIntervalMS) {
+    if (!renderer || renderer->isRunning()) {
+        return;
+    }
+    repaintBeforeAnimation = gwnd->isRepaintImmediately();
+    gwnd->setRepaintImmediately(false);
+    renderer->start(frameIntervalMS);
+}
+
+/*
+ * If the search outran the renderer so far that some colors were dropped, the
+ * final ones are drawn again from the yellow and green nodes recorded here.
+ */
+void WorldDisplay::endAnimation() {
+    if (!renderer || !renderer->isRunning()) {
+        return;
+    }
+    if (renderer->stop()) {
+        gwnd->beginBatch();
+        for (RoadNode* v : yellowNodes) {
+            drawVertexCircle(v, colorString(Color::YELLOW));
+        }
+        for (RoadNode* v : greenNodes) {
+            drawVertexCircle(v, colorString(Color::GREEN));
+        }
+        gwnd->endBatch();
+    }
+    gwnd->setRepaintImmediately(repaintBeforeAnimation);
+    gwnd->repaint();
+}
+
+void WorldDisplay::drawColorFrame(const std::vector<ColorEvent>& frame) {
+    const CompiledRoadGraph& compiled = roadGraph->compile();
+    gwnd->beginBatch();
+    for (const ColorEvent& event : frame) {
+        drawVertexCircle(compiled.nodeAt(event.node), colorString(event.color));
+    }
+    gwnd->repaint();
+    gwnd->endBatch();
 }
@@ -0,0 +1,1080 @@
+/**
+ * @brief This file contains the headless benchmark driver, which runs every search
+ * algorithm over a seeded random query set on one map and reports how each fared,
+ * and times the other query services on the same map and queries.
+ * @version 2026/10/16
+ *
+ * Usage: pathfinder-benchmark <map file> [--mode M] [--queries N] [--seed S]
+ *                             [--algorithms name,name,...] [--ida-table-bytes N]
+ *                             [--budget C] [--table NxM] [--threads T]
+ *                             [--binary F] [--replans R] [--updates U]
+ *                             [--departure T] [--turn-penalties L,R,U]
+ *
+ * Modes:
+ *   queries      every point-to-point search on the query set (the default);
+ *                the time-dependent one leaves at time T (0 if not given), and
+ *                the edge-based one charges L, R and U for left turns, right
+ *                turns and U-turns (none if not given) on top of the map's
+ *                turn restrictions
+ *   one-to-all   budgeted one-to-all searches from the query sources, with one
+ *                search object reused and with a fresh one per run
+ *   table        an N-by-M distance table between random nodes, with a sample
+ *                of its cells checked against A*
+ *   load         loading the text map against mapping the binary map F (made
+ *                from it by pathfinder-compile-map), and the ID-based searches
+ *                on the mapped graph, with its second metric if it has one
+ *   replan       an incremental planner per query, re-planning R times after U
+ *                random cost rises each, against A* from scratch
+ *   customize    re-weighting the graph's customizable hierarchy after R rounds
+ *                of U random cost changes, against contracting from scratch; on
+ *                a map with a second metric, also switching a hierarchy between
+ *                the two metrics R times
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "CustomizableHierarchy.h"
+#include "DistanceTableEngine.h"
+#include "IndexedHeap.h"
+#include "IncrementalPlanner.h"
+#include "OneToAllSearch.h"
+#include "RoadGraph.h"
+#include "RoadMapBinary.h"
+#include "RoadMapReader.h"
+#include "TravelTimeProfiles.h"
+#include "TurnCosts.h"
+#include "error.h"
+#include "pathfinder.h"
+
+/*
+ * The benchmark does not start the Java back-end, so it opts out of the library's
+ * main() wrapper, which would, and takes its arguments directly.
+ */
+#undef main
+
+/* Allocation counters, fed by the global operator new below. */
+namespace {
+    unsigned long long allocatedBytes = 0;
+    unsigned long long allocationCount = 0;
+}
+
+void* operator new(std::size_t size) {
+    allocatedBytes += size;
+    allocationCount++;
+    if (void* block = std::malloc(size ? size : 1)) {
+        return block;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* block) noexcept {
+    std::free(block);
+}
+
+void operator delete[](void* block) noexcept {
+    operator delete(block);
+}
+
+/* Constants, types and helper functions local to this file. */
+namespace {
+    const int DEFAULT_QUERY_COUNT = 200;
+    const unsigned DEFAULT_SEED = 20190408;
+    const int DEFAULT_TABLE_SIZE = 1000;
+
+    /* The number of times each way of loading a map is timed; the best time counts. */
+    const int LOAD_RUNS = 5;
+
+    const int DEFAULT_REPLANS = 10;
+    const int DEFAULT_UPDATES = 20;
+
+    /* The most a random cost change multiplies a cost by, and how often it closes the arc. */
+    const double MAX_COST_RISE = 3;
+    const int CLOSURE_ONE_IN = 10;
+
+    /* The search algorithms the benchmark knows how to run. */
+    enum class Kind {
+        A_STAR,
+        BIDIRECTIONAL_A_STAR,
+        PERIPHERY_SWEEP,
+        MEMORY_OPTIMIZED_IDA_STAR,
+        IDA_STAR,
+        CONTRACTION_HIERARCHY,
+        TIME_DEPENDENT_A_STAR,
+        EDGE_BASED_A_STAR
+    };
+
+    struct Algorithm {
+        const char* name;
+        Kind kind;
+    };
+
+    /* Every algorithm the benchmark runs, in the order the report lists them. */
+    const Algorithm ALGORITHMS[] = {
+        { "a_star",                    Kind::A_STAR                    },
+        { "bidirectional_a_star",      Kind::BIDIRECTIONAL_A_STAR      },
+        { "periphery_sweep",           Kind::PERIPHERY_SWEEP           },
+        { "memory_optimized_ida_star", Kind::MEMORY_OPTIMIZED_IDA_STAR },
+        { "ida_star",                  Kind::IDA_STAR                  },
+        { "contraction_hierarchy",     Kind::CONTRACTION_HIERARCHY     },
+        { "time_dependent_a_star",     Kind::TIME_DEPENDENT_A_STAR     },
+        { "edge_based_a_star",         Kind::EDGE_BASED_A_STAR         },
+    };
+
+    /* The command-line settings of a run. */
+    struct Options {
+        std::string mapFile;
+        int queries = DEFAULT_QUERY_COUNT;
+        unsigned seed = DEFAULT_SEED;
+        std::string mode = "queries";
+        std::vector<std::string> algorithms;   // empty means all
+        size_t idaTableBytes = DepthFirstWorkspace::DEFAULT_TABLE_BYTES;
+        double budget = -1;                    // negative: the cost of each query
+        int tableRows = DEFAULT_TABLE_SIZE;
+        int tableColumns = DEFAULT_TABLE_SIZE;
+        int threads = 0;                       // 0: one per hardware thread
+        std::string binaryFile;
+        int replans = DEFAULT_REPLANS;
+        int updates = DEFAULT_UPDATES;
+        double departure = 0;
+        TurnPenalties turnPenalties;
+    };
+
+    /* What one algorithm did on the whole query set. */
+    struct Report {
+        std::vector<double> latencies;   // microseconds, one per query
+        int found = 0;
+        int suboptimal = 0;
+        unsigned long long expansions = 0;
+        unsigned long long frontierPeaks = 0;
+        unsigned long long bytes = 0;
+        unsigned long long allocations = 0;
+    };
+
+    /*
+     * Returns the cost of a path of node IDs, taking the cheapest arc between each
+     * pair of nodes.
+     */
+    double pathCost(const CompiledRoadGraph& compiled, const std::vector<int>& path) {
+        double cost = 0;
+        for (size_t i = 1; i < path.size(); i++) {
+            int from = path[i - 1];
+            int to = path[i];
+            double cheapest = INFINITY;
+            for (int arc = compiled.firstArc(from); arc < compiled.endArc(from); arc++) {
+                if (compiled.arcTarget(arc) == to) {
+                    cheapest = std::min(cheapest, compiled.arcCost(arc));
+                }
+            }
+            cost += cheapest;
+        }
+        return cost;
+    }
+
+    /* Returns the cost of a path, as above. */
+    double pathCost(const CompiledRoadGraph& compiled, const Path& path) {
+        std::vector<int> ids;
+        for (RoadNode* node : path) {
+            ids.push_back(compiled.idOf(node));
+        }
+        return pathCost(compiled, ids);
+    }
+
+    /* Returns whether a cost agrees with a reference cost up to rounding. */
+    bool sameCost(double cost, double reference) {
+        return cost == reference || std::fabs(cost - reference) <= 1e-9 * reference;
+    }
+
+    /* Returns the value below which the given fraction of the sorted samples fall. */
+    double percentile(const std::vector<double>& sorted, double fraction) {
+        int rank = static_cast<int>(std::ceil(fraction * sorted.size())) - 1;
+        return sorted[std::max(0, std::min(rank, static_cast<int>(sorted.size()) - 1))];
+    }
+
+    void printReport(const std::string& name, Report& report) {
+        int runs = static_cast<int>(report.latencies.size());
+        std::sort(report.latencies.begin(), report.latencies.end());
+        std::cout << std::left << std::setw(27) << name << std::right
+                  << std::setw(6) << report.found
+                  << std::setw(6) << report.suboptimal
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(11) << percentile(report.latencies, 0.50)
+                  << std::setw(11) << percentile(report.latencies, 0.90)
+                  << std::setw(11) << percentile(report.latencies, 0.99)
+                  << std::setw(12) << static_cast<double>(report.expansions) / runs
+                  << std::setw(11) << static_cast<double>(report.frontierPeaks) / runs
+                  << std::setw(14) << static_cast<double>(report.bytes) / runs
+                  << std::setw(11) << static_cast<double>(report.allocations) / runs
+                  << std::endl;
+    }
+
+    /* The map and the query set every mode works on. */
+    struct Setup {
+        RoadGraph* graph;
+        TravelTimeProfiles profiles;     // those of the map, if it has any
+        std::vector<TurnRestriction> restrictions;   // those of the map, if it has any
+        const TurnCosts* turns;          // the restrictions and the turn penalties
+        std::vector<std::pair<RoadNode*, RoadNode*>> queries;
+        std::vector<double> reference;   // Dijkstra cost of each query, or INFINITY
+    };
+
+    /* No guidance at all, which turns A* into Dijkstra's algorithm. */
+    class ZeroHeuristic : public Heuristic {
+    public:
+        double estimate(int, int) const override {
+            return 0;
+        }
+    };
+
+    /* Runs one query with the given algorithm, reporting to the given tracer. */
+    template <typename Tracer>
+    Path search(Kind kind, const Setup& setup, const Options& options, RoadNode* source,
+                RoadNode* target, const Heuristic& heuristic, Tracer& tracer) {
+        const RoadGraph& graph = *setup.graph;
+        switch (kind) {
+        case Kind::A_STAR:
+            return a_star(graph, source, target, heuristic, tracer);
+        case Kind::BIDIRECTIONAL_A_STAR:
+            return bidirectional_a_star(graph, source, target, heuristic, tracer);
+        case Kind::PERIPHERY_SWEEP:
+            return periphery_sweep(graph, source, target, heuristic, tracer);
+        case Kind::MEMORY_OPTIMIZED_IDA_STAR:
+            return memory_optimized_ida_star(graph, source, target, heuristic, tracer);
+        case Kind::IDA_STAR:
+            return ida_star(graph, source, target, heuristic, tracer, options.idaTableBytes);
+        case Kind::CONTRACTION_HIERARCHY:
+            return contraction_hierarchy(graph, source, target, tracer);
+        case Kind::TIME_DEPENDENT_A_STAR:
+            return time_dependent_a_star(graph, setup.profiles, source, target,
+                                         options.departure, heuristic, tracer);
+        case Kind::EDGE_BASED_A_STAR:
+            return edge_based_a_star(graph, *setup.turns, source, target, heuristic, tracer);
+        }
+        return Path();
+    }
+
+    /*
+     * Returns whether the path an algorithm found for query i costs more than the
+     * cheapest one. The time-dependent search costs its paths by the time they are
+     * driven at, and the edge-based one adds the cost of its turns, so their
+     * answers are checked by running their cores again, guided by the heuristic
+     * and by none (Dijkstra on the same costs). The time-dependent core takes a
+     * workspace sized for the nodes of the graph, the edge-based one one sized
+     * for its arcs.
+     */
+    bool costsMore(Kind kind, const Setup& setup, const Options& options, size_t i,
+                   const Path& path, const Heuristic& heuristic,
+                   SearchWorkspace& nodeWorkspace, SearchWorkspace& arcWorkspace) {
+        const CompiledRoadGraph& compiled = setup.graph->compile();
+        int source = compiled.idOf(setup.queries[i].first);
+        int target = compiled.idOf(setup.queries[i].second);
+        std::vector<int> ids;
+        double cost;
+        double cheapest;
+        if (kind == Kind::TIME_DEPENDENT_A_STAR) {
+            cost = time_dependent_a_star(compiled, setup.profiles, source, target,
+                                         options.departure, heuristic, nodeWorkspace, ids);
+            cheapest = time_dependent_a_star(compiled, setup.profiles, source, target,
+                                             options.departure, ZeroHeuristic(),
+                                             nodeWorkspace, ids);
+        } else if (kind == Kind::EDGE_BASED_A_STAR) {
+            cost = edge_based_a_star(compiled, *setup.turns, source, target, heuristic,
+                                     arcWorkspace, ids);
+            cheapest = edge_based_a_star(compiled, *setup.turns, source, target,
+                                         ZeroHeuristic(), arcWorkspace, ids);
+        } else {
+            return pathCost(compiled, path) > setup.reference[i] * (1 + 1e-9);
+        }
+        return cost > cheapest * (1 + 1e-9);
+    }
+
+    double secondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    /*
+     * Runs each algorithm over the whole query set. Every query is run twice: once
+     * timed with a NullTracer, which also counts the bytes the search allocates,
+     * and once untimed with a CountingTracer to count expansions and the frontier.
+     * One-off preprocessing (the contraction hierarchy) happens before any timing
+     * starts.
+     */
+    bool runQueries(const Options& options, Setup& setup) {
+        RoadGraph& roadGraph = *setup.graph;
+        const CompiledRoadGraph& compiled = roadGraph.compile();
+        std::cout << std::left << std::setw(27) << "algorithm" << std::right
+                  << std::setw(6) << "found" << std::setw(6) << "worse"
+                  << std::setw(11) << "p50 us" << std::setw(11) << "p90 us"
+                  << std::setw(11) << "p99 us" << std::setw(12) << "expanded"
+                  << std::setw(11) << "frontier" << std::setw(14) << "bytes"
+                  << std::setw(11) << "allocs" << std::endl;
+
+        CrowFlyHeuristic heuristic(roadGraph);
+        NullTracer nullTracer;
+        CountingTracer counter(compiled.nodeCount());
+        SearchWorkspace nodeWorkspace(compiled.nodeCount());
+        SearchWorkspace arcWorkspace(compiled.arcCount());
+        for (const Algorithm& algorithm : ALGORITHMS) {
+            bool named = std::find(options.algorithms.begin(), options.algorithms.end(),
+                                   algorithm.name) != options.algorithms.end();
+            if (!options.algorithms.empty() && !named) {
+                continue;
+            }
+            if (algorithm.kind == Kind::CONTRACTION_HIERARCHY) {
+                roadGraph.hierarchy();
+            }
+
+            Report report;
+            for (size_t i = 0; i < setup.queries.size(); i++) {
+                RoadNode* source = setup.queries[i].first;
+                RoadNode* target = setup.queries[i].second;
+
+                unsigned long long bytesBefore = allocatedBytes;
+                unsigned long long allocationsBefore = allocationCount;
+                auto start = std::chrono::steady_clock::now();
+                Path path = search(algorithm.kind, setup, options, source, target, heuristic,
+                                   nullTracer);
+                auto finish = std::chrono::steady_clock::now();
+                report.bytes += allocatedBytes - bytesBefore;
+                report.allocations += allocationCount - allocationsBefore;
+                report.latencies.push_back(
+                        std::chrono::duration<double, std::micro>(finish - start).count());
+
+                if (!path.isEmpty()) {
+                    report.found++;
+                    if (costsMore(algorithm.kind, setup, options, i, path, heuristic,
+                                  nodeWorkspace, arcWorkspace)) {
+                        report.suboptimal++;
+                    }
+                }
+
+                counter.reset();
+                search(algorithm.kind, setup, options, source, target, heuristic, counter);
+                report.expansions += counter.expansions;
+                report.frontierPeaks += counter.frontierPeak;
+            }
+            printReport(algorithm.name, report);
+        }
+        return true;
+    }
+
+    /*
+     * Runs a one-to-all search from the source of every query, within the given
+     * budget or else within the cost of the query, so that the searches cover
+     * areas of many sizes. The runs are made twice: with one OneToAllSearch kept
+     * for all of them, and with a new one for each, which has to allocate and
+     * clear arrays for the whole map before it settles anything.
+     */
+    bool runOneToAll(const Options& options, Setup& setup) {
+        const CompiledRoadGraph& compiled = setup.graph->compile();
+        std::cout << std::left << std::setw(16) << "search" << std::right
+                  << std::setw(8) << "runs" << std::setw(14) << "settled/run"
+                  << std::setw(14) << "settled/s" << std::setw(14) << "bytes/run"
+                  << std::setw(12) << "allocs/run" << std::endl;
+
+        OneToAllSearch kept(compiled);
+        std::vector<unsigned long long> totals;
+        for (bool reuse : { true, false }) {
+            unsigned long long settled = 0;
+            unsigned long long bytesBefore = allocatedBytes;
+            unsigned long long allocationsBefore = allocationCount;
+            auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < setup.queries.size(); i++) {
+                int source = compiled.idOf(setup.queries[i].first);
+                double budget = options.budget >= 0 ? options.budget : setup.reference[i];
+                if (reuse) {
+                    kept.run(source, budget);
+                    settled += kept.reachedNodes().size();
+                } else {
+                    OneToAllSearch fresh(compiled);
+                    fresh.run(source, budget);
+                    settled += fresh.reachedNodes().size();
+                }
+            }
+            double seconds = secondsSince(start);
+            double runs = static_cast<double>(setup.queries.size());
+            std::cout << std::left << std::setw(16) << (reuse ? "reused" : "fresh")
+                      << std::right << std::fixed << std::setprecision(1)
+                      << std::setw(8) << setup.queries.size()
+                      << std::setw(14) << settled / runs
+                      << std::setw(14) << std::setprecision(0) << settled / seconds
+                      << std::setw(14) << std::setprecision(1)
+                      << (allocatedBytes - bytesBefore) / runs
+                      << std::setw(12) << (allocationCount - allocationsBefore) / runs
+                      << std::endl;
+            totals.push_back(settled);
+        }
+        if (totals[0] != totals[1]) {
+            std::cerr << "The reused and the fresh searches settled different nodes" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    /*
+     * Computes a distance table between randomly drawn nodes and checks a sample
+     * of its cells, one per query, against A* with the straight-line bound, which
+     * is consistent and so finds the cheapest path. The hierarchy is built before
+     * the timing starts.
+     */
+    bool runTable(const Options& options, Setup& setup) {
+        RoadGraph& roadGraph = *setup.graph;
+        const CompiledRoadGraph& compiled = roadGraph.compile();
+        auto start = std::chrono::steady_clock::now();
+        roadGraph.hierarchy();
+        double hierarchySeconds = secondsSince(start);
+
+        std::mt19937 random(options.seed);
+        std::uniform_int_distribution<int> pick(0, compiled.nodeCount() - 1);
+        std::vector<RoadNode*> sources;
+        std::vector<RoadNode*> targets;
+        for (int i = 0; i < options.tableRows; i++) {
+            sources.push_back(compiled.nodeAt(pick(random)));
+        }
+        for (int i = 0; i < options.tableColumns; i++) {
+            targets.push_back(compiled.nodeAt(pick(random)));
+        }
+
+        DistanceTableEngine engine(roadGraph, options.threads);
+        start = std::chrono::steady_clock::now();
+        DistanceTable table = engine.run(sources, targets);
+        double tableSeconds = secondsSince(start);
+        double cells = static_cast<double>(table.rowCount()) * table.columnCount();
+        std::cout << std::fixed << std::setprecision(3)
+                  << "hierarchy  " << hierarchySeconds << " s" << std::endl
+                  << "table      " << table.rowCount() << " x " << table.columnCount()
+                  << " on " << engine.threadCount() << " threads: " << tableSeconds
+                  << " s, " << std::setprecision(0) << cells / tableSeconds
+                  << " cells/s" << std::endl;
+
+        StraightLineHeuristic heuristic(compiled);
+        SearchWorkspace workspace(compiled.nodeCount());
+        std::vector<int> path;
+        std::uniform_int_distribution<int> pickRow(0, table.rowCount() - 1);
+        std::uniform_int_distribution<int> pickColumn(0, table.columnCount() - 1);
+        int wrong = 0;
+        for (int i = 0; i < options.queries; i++) {
+            int row = pickRow(random);
+            int column = pickColumn(random);
+            double expected = a_star(compiled, table.sources[row], table.targets[column],
+                                     heuristic, workspace, path);
+            engine.unpackPath(table, row, column, path);
+            double unpacked = path.empty() ? INFINITY : pathCost(compiled, path);
+            if (!sameCost(table.cost(row, column), expected) || !sameCost(unpacked, expected)) {
+                wrong++;
+            }
+        }
+        std::cout << "checked    " << options.queries << " cells against a_star, "
+                  << wrong << " wrong" << std::endl;
+        return wrong == 0;
+    }
+
+    /*
+     * Reads a text map, and its travel time profiles and turn restrictions into the
+     * given containers if there are any, printing the reason to cerr if it cannot.
+     */
+    bool readTextMap(const std::string& fileName, Graph<RoadNode, RoadEdge>& graph,
+                     TravelTimeProfiles* profiles = nullptr,
+                     std::vector<TurnRestriction>* restrictions = nullptr) {
+        std::ifstream input(fileName.c_str());
+        if (input.fail()) {
+            std::cerr << "Cannot open " << fileName << std::endl;
+            return false;
+        }
+        RoadMapHeader header;
+        return readRoadMapHeader(input, header, /* checkImage */ false)
+                && readRoadMapGraph(input, graph, profiles, restrictions);
+    }
+
+    /* The workspaces of the ID-based searches, sized for one graph. */
+    struct Workspaces {
+        Workspaces(int nodeCount, size_t idaTableBytes)
+            : forward(nodeCount), backward(nodeCount), frontier(nodeCount),
+              depthFirst(nodeCount, idaTableBytes) {}
+
+        SearchWorkspace forward;
+        SearchWorkspace backward;
+        SweepFrontier frontier;
+        DepthFirstWorkspace depthFirst;
+    };
+
+    /* Returns whether an algorithm has a core over node IDs (see pathfinder.h). */
+    bool hasIdCore(Kind kind) {
+        return kind == Kind::A_STAR || kind == Kind::BIDIRECTIONAL_A_STAR
+                || kind == Kind::PERIPHERY_SWEEP || kind == Kind::IDA_STAR;
+    }
+
+    /* Runs one query with the ID-based core of the given algorithm and returns its cost. */
+    double searchIds(Kind kind, const CompiledRoadGraph& compiled, int source, int target,
+                     const Heuristic& heuristic, Workspaces& workspaces) {
+        std::vector<int> path;
+        switch (kind) {
+        case Kind::A_STAR:
+            return a_star(compiled, source, target, heuristic, workspaces.forward, path);
+        case Kind::BIDIRECTIONAL_A_STAR:
+            return bidirectional_a_star(compiled, source, target, heuristic,
+                                        workspaces.forward, workspaces.backward, path);
+        case Kind::PERIPHERY_SWEEP:
+            return periphery_sweep(compiled, source, target, heuristic, workspaces.forward,
+                                   workspaces.frontier, path);
+        case Kind::IDA_STAR:
+            return ida_star(compiled, source, target, heuristic, workspaces.depthFirst, path);
+        default:
+            error("searchIds: the algorithm has no core over node IDs");
+            return INFINITY;
+        }
+    }
+
+    /*
+     * Times reading and compiling the text map against mapping the binary map and
+     * viewing it as a compiled graph, best of LOAD_RUNS each, and then runs every
+     * algorithm that has an ID-based core on the mapped graph. Queries are carried
+     * over by node name, and each answer must match the one the same search gives
+     * on the graph compiled from the text map. If the map has a second metric, a
+     * hierarchy customized with the mapped copy of it must also answer the queries
+     * as the text map's does.
+     */
+    bool runLoad(const Options& options, Setup& setup) {
+        if (options.binaryFile.empty()) {
+            std::cerr << "The load mode needs a binary map (--binary)" << std::endl;
+            return false;
+        }
+        double textSeconds = INFINITY;
+        for (int run = 0; run < LOAD_RUNS; run++) {
+            auto start = std::chrono::steady_clock::now();
+            Graph<RoadNode, RoadEdge> graph;
+            if (!readTextMap(options.mapFile, graph)) {
+                return false;
+            }
+            RoadGraph roadGraph(&graph);
+            roadGraph.compile();
+            textSeconds = std::min(textSeconds, secondsSince(start));
+        }
+        double mappedSeconds = INFINITY;
+        MappedRoadMap map;
+        for (int run = 0; run < LOAD_RUNS; run++) {
+            auto start = std::chrono::steady_clock::now();
+            if (!map.open(options.binaryFile)) {
+                return false;
+            }
+            CompiledRoadGraph view(map);
+            mappedSeconds = std::min(mappedSeconds, secondsSince(start));
+        }
+        CompiledRoadGraph mapped(map);
+        const CompiledRoadGraph& compiled = setup.graph->compile();
+        bool matches = mapped.nodeCount() == compiled.nodeCount()
+                && mapped.arcCount() == compiled.arcCount()
+                && mapped.secondMetric() == compiled.secondMetric();
+        if (!matches) {
+            std::cerr << options.binaryFile << " is not a compiled " << options.mapFile
+                      << std::endl;
+            return false;
+        }
+        std::cout << std::fixed << std::setprecision(3)
+                  << "read and compile text map  " << textSeconds * 1000 << " ms" << std::endl
+                  << "map and view binary map    " << mappedSeconds * 1000 << " ms"
+                  << std::endl;
+
+        std::vector<std::pair<int, int>> queries;
+        for (const auto& query : setup.queries) {
+            queries.push_back(std::make_pair(map.idOfName(query.first->nodeName()),
+                                             map.idOfName(query.second->nodeName())));
+        }
+        CrowFlyHeuristic heuristic(mapped, map.maxRoadSpeed());
+        CrowFlyHeuristic textHeuristic(*setup.graph);
+        Workspaces workspaces(mapped.nodeCount(), options.idaTableBytes);
+        std::cout << std::left << std::setw(27) << "algorithm on mapped graph" << std::right
+                  << std::setw(6) << "found" << std::setw(6) << "worse"
+                  << std::setw(8) << "differ"
+                  << std::setw(11) << "p50 us" << std::setw(11) << "p90 us"
+                  << std::setw(11) << "p99 us" << std::endl;
+        bool allRight = true;
+        for (const Algorithm& algorithm : ALGORITHMS) {
+            bool named = std::find(options.algorithms.begin(), options.algorithms.end(),
+                                   algorithm.name) != options.algorithms.end();
+            if ((!options.algorithms.empty() && !named) || !hasIdCore(algorithm.kind)) {
+                continue;
+            }
+            std::vector<double> latencies;
+            int found = 0;
+            int worse = 0;
+            int differ = 0;
+            for (size_t i = 0; i < queries.size(); i++) {
+                auto start = std::chrono::steady_clock::now();
+                double cost = searchIds(algorithm.kind, mapped, queries[i].first,
+                                        queries[i].second, heuristic, workspaces);
+                latencies.push_back(std::chrono::duration<double, std::micro>(
+                        std::chrono::steady_clock::now() - start).count());
+                found += cost != INFINITY;
+                worse += cost > setup.reference[i] * (1 + 1e-9);
+
+                double textCost = searchIds(algorithm.kind, compiled,
+                                            compiled.idOf(setup.queries[i].first),
+                                            compiled.idOf(setup.queries[i].second),
+                                            textHeuristic, workspaces);
+                differ += !sameCost(cost, textCost);
+            }
+            std::sort(latencies.begin(), latencies.end());
+            std::cout << std::left << std::setw(27) << algorithm.name << std::right
+                      << std::setw(6) << found << std::setw(6) << worse
+                      << std::setw(8) << differ << std::setprecision(1)
+                      << std::setw(11) << percentile(latencies, 0.50)
+                      << std::setw(11) << percentile(latencies, 0.90)
+                      << std::setw(11) << percentile(latencies, 0.99) << std::endl;
+            allRight = allRight && differ == 0;
+        }
+
+        if (mapped.hasSecondMetric()) {
+            CustomizableHierarchy mappedHierarchy(mapped);
+            mappedHierarchy.customize(mapped.secondMetric());
+            ContractionHierarchyQuery query(mappedHierarchy.hierarchy());
+            ContractionHierarchyQuery textQuery(setup.graph->secondMetricHierarchy());
+            int differ = 0;
+            for (size_t i = 0; i < queries.size(); i++) {
+                double cost = query.run(queries[i].first, queries[i].second);
+                differ += !sameCost(cost, textQuery.run(compiled.idOf(setup.queries[i].first),
+                                                        compiled.idOf(setup.queries[i].second)));
+            }
+            std::cout << "second metric on mapped graph: " << differ << " of "
+                      << queries.size() << " queries differ" << std::endl;
+            allRight = allRight && differ == 0;
+        }
+        return allRight;
+    }
+
+    /*
+     * Keeps an incremental planner for each query and re-plans it a number of
+     * times, each after a number of random cost rises made with setEdgeCost: every
+     * other one on an arc of the current route, the rest anywhere on the map, and
+     * some of them closures. After every re-plan, A* with the straight-line bound
+     * computed before any change (which stays consistent as costs rise) searches
+     * from scratch, and the two costs must agree. The changes are cumulative and
+     * are not undone.
+     */
+    bool runReplan(const Options& options, Setup& setup) {
+        RoadGraph& roadGraph = *setup.graph;
+        const CompiledRoadGraph& compiled = roadGraph.compile();
+        StraightLineHeuristic heuristic(compiled);
+        SearchWorkspace workspace(compiled.nodeCount());
+        CountingTracer counter(compiled.nodeCount());
+        std::mt19937 random(options.seed);
+        std::uniform_int_distribution<int> pickArc(0, compiled.arcCount() - 1);
+        std::uniform_real_distribution<double> pickRise(1, MAX_COST_RISE);
+
+        unsigned long long firstExpanded = 0;
+        unsigned long long replanExpanded = 0;
+        unsigned long long freshExpanded = 0;
+        double firstSeconds = 0;
+        double replanSeconds = 0;
+        double freshSeconds = 0;
+        int wrong = 0;
+        std::vector<int> route;
+        std::vector<int> freshPath;
+        for (const auto& query : setup.queries) {
+            int source = compiled.idOf(query.first);
+            int target = compiled.idOf(query.second);
+            IncrementalPlanner planner(roadGraph, heuristic, source, target);
+            auto start = std::chrono::steady_clock::now();
+            planner.plan(route);
+            firstSeconds += secondsSince(start);
+            firstExpanded += planner.expandedNodes();
+
+            for (int replan = 0; replan < options.replans; replan++) {
+                for (int update = 0; update < options.updates; update++) {
+                    int arc = pickArc(random);
+                    if (update % 2 == 0 && route.size() > 1) {
+                        size_t step = random() % (route.size() - 1);
+                        for (int a = compiled.firstArc(route[step]);
+                                a < compiled.endArc(route[step]); a++) {
+                            if (compiled.arcTarget(a) == route[step + 1]) {
+                                arc = a;
+                            }
+                        }
+                    }
+                    double cost = random() % CLOSURE_ONE_IN == 0
+                            ? INFINITY : compiled.arcCost(arc) * pickRise(random);
+                    roadGraph.setEdgeCost(compiled.arcEdge(arc), cost);
+                }
+
+                start = std::chrono::steady_clock::now();
+                double cost = planner.plan(route);
+                replanSeconds += secondsSince(start);
+                replanExpanded += planner.expandedNodes();
+
+                start = std::chrono::steady_clock::now();
+                double freshCost = a_star(compiled, source, target, heuristic, workspace,
+                                          freshPath);
+                freshSeconds += secondsSince(start);
+                counter.reset();
+                a_star(roadGraph, query.first, query.second, heuristic, counter);
+                freshExpanded += counter.expansions;
+                if (!sameCost(cost, freshCost)) {
+                    wrong++;
+                }
+            }
+        }
+
+        int plans = static_cast<int>(setup.queries.size());
+        int replans = plans * options.replans;
+        std::cout << options.updates << " cost rises before each re-plan" << std::endl
+                  << std::left << std::setw(20) << "search" << std::right
+                  << std::setw(8) << "runs" << std::setw(12) << "expanded"
+                  << std::setw(11) << "us/run" << std::endl
+                  << std::fixed << std::setprecision(1);
+        auto printRow = [](const char* name, int runs, unsigned long long expanded,
+                           double seconds) {
+            std::cout << std::left << std::setw(20) << name << std::right
+                      << std::setw(8) << runs
+                      << std::setw(12) << static_cast<double>(expanded) / runs
+                      << std::setw(11) << seconds * 1e6 / runs << std::endl;
+        };
+        printRow("first plan", plans, firstExpanded, firstSeconds);
+        printRow("incremental replan", replans, replanExpanded, replanSeconds);
+        printRow("fresh a_star", replans, freshExpanded, freshSeconds);
+        std::cout << wrong << " re-plans disagree with a_star" << std::endl;
+        return wrong == 0;
+    }
+
+    /*
+     * Changes the costs of the given number of random arcs with setEdgeCost, each
+     * rising by up to MAX_COST_RISE times or, one time in CLOSURE_ONE_IN, closing.
+     */
+    void raiseRandomCosts(RoadGraph& roadGraph, int count, std::mt19937& random) {
+        const CompiledRoadGraph& compiled = roadGraph.compile();
+        std::uniform_int_distribution<int> pickArc(0, compiled.arcCount() - 1);
+        std::uniform_real_distribution<double> pickRise(1, MAX_COST_RISE);
+        for (int i = 0; i < count; i++) {
+            int arc = pickArc(random);
+            double cost = random() % CLOSURE_ONE_IN == 0
+                    ? INFINITY : compiled.arcCost(arc) * pickRise(random);
+            roadGraph.setEdgeCost(compiled.arcEdge(arc), cost);
+        }
+    }
+
+    /*
+     * Returns the cost of the cheapest path from source to target under the given
+     * arc costs, by Dijkstra's algorithm, reusing the given heap and array.
+     */
+    double dijkstraCost(const CompiledRoadGraph& compiled, const std::vector<double>& arcCosts,
+                        int source, int target, IndexedHeap& heap,
+                        std::vector<double>& distances) {
+        distances.assign(compiled.nodeCount(), INFINITY);
+        heap.clear();
+        distances[source] = 0;
+        heap.pushOrDecrease(source, 0);
+        while (!heap.isEmpty()) {
+            int node = heap.pop();
+            if (node == target) {
+                break;
+            }
+            for (int arc = compiled.firstArc(node); arc < compiled.endArc(node); arc++) {
+                int next = compiled.arcTarget(arc);
+                double distance = distances[node] + arcCosts[arc];
+                if (distance < distances[next]) {
+                    distances[next] = distance;
+                    heap.pushOrDecrease(next, distance);
+                }
+            }
+        }
+        return distances[target];
+    }
+
+    /*
+     * Follows the graph's hierarchy through cost changes. The first use after a
+     * change builds the structure of the customizable hierarchy and customizes it;
+     * each later round of changes only customizes it again. At the end the query
+     * set is answered on it and on a hierarchy contracted from scratch for the
+     * final costs, and both must agree with Dijkstra on those costs.
+     *
+     * If the map has a second metric, one more customizable hierarchy is then
+     * switched back and forth between the final costs and the second metric R
+     * times, and the query set is answered on it after each of the last two
+     * switches and on the graph's own second metric hierarchy, checked against
+     * Dijkstra on the metric in use.
+     */
+    bool runCustomize(const Options& options, Setup& setup) {
+        RoadGraph& roadGraph = *setup.graph;
+        const CompiledRoadGraph& compiled = roadGraph.compile();
+        std::mt19937 random(options.seed);
+
+        raiseRandomCosts(roadGraph, options.updates, random);
+        auto start = std::chrono::steady_clock::now();
+        roadGraph.hierarchy();
+        double switchSeconds = secondsSince(start);
+        std::vector<double> customizeSeconds;
+        for (int round = 0; round < options.replans; round++) {
+            raiseRandomCosts(roadGraph, options.updates, random);
+            start = std::chrono::steady_clock::now();
+            roadGraph.hierarchy();
+            customizeSeconds.push_back(secondsSince(start));
+        }
+        std::sort(customizeSeconds.begin(), customizeSeconds.end());
+        double customize = customizeSeconds.empty() ? 0 : percentile(customizeSeconds, 0.5);
+
+        start = std::chrono::steady_clock::now();
+        ContractionHierarchy contracted(compiled);
+        double contractSeconds = secondsSince(start);
+
+        auto printTime = [](const std::string& label, double seconds) {
+            std::cout << std::left << std::setw(31) << label << std::right << std::fixed
+                      << std::setprecision(1) << seconds * 1000 << " ms" << std::endl;
+        };
+        printTime("contract from scratch", contractSeconds);
+        printTime("build customizable structure", switchSeconds - customize);
+        printTime("customize (median of " + std::to_string(options.replans) + ")", customize);
+
+        /* The final costs and, if the map has one, its second metric. */
+        std::vector<double> metrics[2];
+        for (int arc = 0; arc < compiled.arcCount(); arc++) {
+            metrics[0].push_back(compiled.arcCost(arc));
+        }
+        metrics[1] = compiled.secondMetric();
+        int metricCount = metrics[1].empty() ? 1 : 2;
+
+        CustomizableHierarchy switching(compiled);
+        std::vector<double> metricSwitchSeconds;
+        for (int round = 0; metricCount == 2 && round < options.replans; round++) {
+            for (const std::vector<double>* metric : { &metrics[1], &metrics[0] }) {
+                start = std::chrono::steady_clock::now();
+                switching.customize(*metric);
+                metricSwitchSeconds.push_back(secondsSince(start));
+            }
+        }
+        if (!metricSwitchSeconds.empty()) {
+            std::sort(metricSwitchSeconds.begin(), metricSwitchSeconds.end());
+            printTime("switch metric (median of " + std::to_string(metricSwitchSeconds.size())
+                      + ")", percentile(metricSwitchSeconds, 0.5));
+        }
+
+        std::cout << std::left << std::setw(27) << "queries on hierarchy" << std::right
+                  << std::setw(10) << "settled" << std::setw(11) << "p50 us"
+                  << std::setw(11) << "p90 us" << std::setw(7) << "wrong" << std::endl;
+        std::vector<double> references[2];
+        IndexedHeap heap(compiled.nodeCount());
+        std::vector<double> distances;
+        for (int metric = 0; metric < metricCount; metric++) {
+            for (const auto& query : setup.queries) {
+                references[metric].push_back(
+                        dijkstraCost(compiled, metrics[metric], compiled.idOf(query.first),
+                                     compiled.idOf(query.second), heap, distances));
+            }
+        }
+
+        /* Answers the query set on a hierarchy and prints a row; returns whether all agree. */
+        auto answerQueries = [&](const std::string& label,
+                                 const ContractionHierarchy& hierarchy,
+                                 const std::vector<double>& reference) {
+            ContractionHierarchyQuery query(hierarchy);
+            std::vector<double> latencies;
+            unsigned long long settled = 0;
+            int wrong = 0;
+            for (size_t i = 0; i < setup.queries.size(); i++) {
+                start = std::chrono::steady_clock::now();
+                double cost = query.run(compiled.idOf(setup.queries[i].first),
+                                        compiled.idOf(setup.queries[i].second));
+                latencies.push_back(secondsSince(start) * 1e6);
+                settled += query.settledNodes().size();
+                wrong += !sameCost(cost, reference[i]);
+            }
+            std::sort(latencies.begin(), latencies.end());
+            std::cout << std::left << std::setw(27) << label << std::right << std::setw(10)
+                      << static_cast<double>(settled) / latencies.size()
+                      << std::setw(11) << percentile(latencies, 0.50)
+                      << std::setw(11) << percentile(latencies, 0.90)
+                      << std::setw(7) << wrong << std::endl;
+            return wrong == 0;
+        };
+        bool allRight = answerQueries("contracted for final costs", contracted, references[0]);
+        allRight = answerQueries("customizable", roadGraph.hierarchy(), references[0])
+                && allRight;
+        if (metricCount == 2) {
+            switching.customize(metrics[1]);
+            allRight = answerQueries("switched to second metric", switching.hierarchy(),
+                                     references[1]) && allRight;
+            switching.customize(metrics[0]);
+            allRight = answerQueries("switched back to costs", switching.hierarchy(),
+                                     references[0]) && allRight;
+            allRight = answerQueries("graph's second metric",
+                                     roadGraph.secondMetricHierarchy(), references[1])
+                    && allRight;
+        }
+        return allRight;
+    }
+
+    /* A way of running the benchmark, chosen with --mode. */
+    struct Mode {
+        const char* name;
+        bool (*run)(const Options& options, Setup& setup);
+    };
+
+    /* Every mode, the default first. */
+    const Mode MODES[] = {
+        { "queries",    runQueries  },
+        { "one-to-all", runOneToAll },
+        { "table",      runTable    },
+        { "load",       runLoad     },
+        { "replan",     runReplan   },
+        { "customize",  runCustomize },
+    };
+
+    void usage() {
+        std::cerr << "Usage: pathfinder-benchmark <map file> [--mode M] [--queries N]"
+                  << " [--seed S]" << std::endl
+                  << "                            [--algorithms name,name,...]"
+                  << " [--ida-table-bytes N]" << std::endl
+                  << "                            [--budget C] [--table NxM] [--threads T]"
+                  << " [--binary F]" << std::endl
+                  << "                            [--replans R] [--updates U] [--departure T]"
+                  << std::endl
+                  << "                            [--turn-penalties L,R,U]" << std::endl
+                  << "Modes:";
+        for (const Mode& mode : MODES) {
+            std::cerr << " " << mode.name;
+        }
+        std::cerr << std::endl << "Algorithms:";
+        for (const Algorithm& algorithm : ALGORITHMS) {
+            std::cerr << " " << algorithm.name;
+        }
+        std::cerr << std::endl;
+    }
+
+    bool parseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--mode" && hasValue) {
+                options.mode = argv[++i];
+            } else if (arg == "--queries" && hasValue) {
+                options.queries = std::atoi(argv[++i]);
+            } else if (arg == "--seed" && hasValue) {
+                options.seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+            } else if (arg == "--ida-table-bytes" && hasValue) {
+                options.idaTableBytes = std::strtoul(argv[++i], nullptr, 10);
+            } else if (arg == "--budget" && hasValue) {
+                options.budget = std::atof(argv[++i]);
+            } else if (arg == "--table" && hasValue) {
+                char separator = 0;
+                std::istringstream size(argv[++i]);
+                if (!(size >> options.tableRows >> separator >> options.tableColumns)
+                        || separator != 'x' || options.tableRows <= 0
+                        || options.tableColumns <= 0) {
+                    return false;
+                }
+            } else if (arg == "--threads" && hasValue) {
+                options.threads = std::atoi(argv[++i]);
+            } else if (arg == "--binary" && hasValue) {
+                options.binaryFile = argv[++i];
+            } else if (arg == "--replans" && hasValue) {
+                options.replans = std::atoi(argv[++i]);
+            } else if (arg == "--updates" && hasValue) {
+                options.updates = std::atoi(argv[++i]);
+            } else if (arg == "--departure" && hasValue) {
+                options.departure = std::atof(argv[++i]);
+            } else if (arg == "--turn-penalties" && hasValue) {
+                char comma1 = 0;
+                char comma2 = 0;
+                TurnPenalties& penalties = options.turnPenalties;
+                std::istringstream values(argv[++i]);
+                if (!(values >> penalties.leftTurn >> comma1 >> penalties.rightTurn
+                          >> comma2 >> penalties.uTurn)
+                        || comma1 != ',' || comma2 != ',' || penalties.leftTurn < 0
+                        || penalties.rightTurn < 0 || penalties.uTurn < 0) {
+                    return false;
+                }
+            } else if (arg == "--algorithms" && hasValue) {
+                std::string list = argv[++i];
+                size_t start = 0;
+                while (start <= list.size()) {
+                    size_t comma = list.find(',', start);
+                    if (comma == std::string::npos) {
+                        comma = list.size();
+                    }
+                    options.algorithms.push_back(list.substr(start, comma - start));
+                    start = comma + 1;
+                }
+            } else if (arg.compare(0, 2, "--") != 0 && options.mapFile.empty()) {
+                options.mapFile = arg;
+            } else {
+                return false;
+            }
+        }
+        return !options.mapFile.empty() && options.queries > 0;
+    }
+}
+
+/*
+ * Loads the map, draws the query set, computes the reference cost of every
+ * query, and runs the chosen mode. It exits with status 1 if the arguments or
+ * the map are bad, or if the mode finds a wrong answer.
+ */
+int main(int argc, char** argv) {
+    Options options;
+    const Mode* mode = nullptr;
+    if (parseOptions(argc, argv, options)) {
+        for (const Mode& candidate : MODES) {
+            if (options.mode == candidate.name) {
+                mode = &candidate;
+            }
+        }
+    }
+    if (!mode) {
+        usage();
+        return 1;
+    }
+
+    Setup setup;
+    Graph<RoadNode, RoadEdge> graph;
+    if (!readTextMap(options.mapFile, graph, &setup.profiles, &setup.restrictions)) {
+        return 1;
+    }
+    RoadGraph roadGraph(&graph);
+    const CompiledRoadGraph& compiled = roadGraph.compile();
+    int nodeCount = compiled.nodeCount();
+    if (nodeCount == 0) {
+        std::cerr << options.mapFile << " has no nodes" << std::endl;
+        return 1;
+    }
+
+    setup.graph = &roadGraph;
+    TurnCosts turns(compiled, options.turnPenalties, setup.restrictions);
+    setup.turns = &turns;
+    std::mt19937 random(options.seed);
+    std::uniform_int_distribution<int> pick(0, nodeCount - 1);
+    for (int i = 0; i < options.queries; i++) {
+        int source = pick(random);
+        int target = pick(random);
+        setup.queries.push_back(std::make_pair(compiled.nodeAt(source),
+                                               compiled.nodeAt(target)));
+    }
+
+    /*
+     * The reference costs come from plain Dijkstra: the crow-fly bound skips the
+     * shortest roads when it finds the fastest one, so A* guided by it is not
+     * guaranteed to be optimal itself.
+     */
+    OneToAllSearch dijkstra(compiled);
+    for (const auto& query : setup.queries) {
+        dijkstra.run(compiled.idOf(query.first));
+        setup.reference.push_back(dijkstra.distance(compiled.idOf(query.second)));
+    }
+
+    std::cout << options.mapFile << ": " << nodeCount << " nodes, "
+              << compiled.arcCount() << " arcs, " << setup.profiles.profileCount()
+              << " travel time profiles, " << turns.restrictionCount()
+              << " turn restrictions, " << options.queries
+              << " queries (seed " << options.seed << ")" << std::endl;
+    return mode->run(options, setup) ? 0 : 1;
+}
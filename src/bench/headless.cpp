@@ -0,0 +1,19 @@
+/**
+ * @brief This file stands in for the start-up code of the Stanford C++ library in
+ * the headless builds: the benchmark, the map compiler and the checks.
+ * @version 2026/10/16
+ *
+ * Every library header runs initializeStanfordCppLibrary() before main(), and the
+ * version in platform.cpp launches the Java back-end (spl.jar) and redirects the
+ * standard streams to its console. Those programs only use the collections and
+ * string utilities, so they link this no-op in place of platform.cpp and keep
+ * plain stdout/stderr.
+ */
+
+namespace stanfordcpplib {
+
+void initializeStanfordCppLibrary() {
+    // empty; there is no back-end to connect to
+}
+
+} // namespace stanfordcpplib
@@ -0,0 +1,109 @@
+/**
+ * @brief This file contains the driver of pathfinder-checks, which runs the
+ * correctness checks of the parts of the search code that the GUI cannot show
+ * to be right: the renderer thread, the spatial queries and the edge-based search.
+ * @version 2026/10/17
+ *
+ * Usage: pathfinder-checks [--maps D] [check ...]
+ *
+ * Runs the named checks, or all of them, reading maps from the directory D
+ * (res if not given). It exits with status 1 if any check fails.
+ */
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "RoadMapReader.h"
+#include "checks.h"
+
+/*
+ * The checks do not start the Java back-end, so they opt out of the library's
+ * main() wrapper, which would, and take their arguments directly.
+ */
+#undef main
+
+namespace {
+    /* The number of failed comparisons a check prints before it only counts them. */
+    const int MAX_REPORTED = 10;
+
+    struct Check {
+        const char* name;
+        bool (*run)(const std::string& mapDirectory);
+    };
+
+    const Check CHECKS[] = {
+        { "event-ring",    checkEventRing    },
+        { "spatial-index", checkSpatialIndex },
+        { "turn-costs",    checkTurnCosts    },
+    };
+
+    void usage() {
+        std::cerr << "Usage: pathfinder-checks [--maps D] [check ...]" << std::endl
+                  << "Checks:";
+        for (const Check& check : CHECKS) {
+            std::cerr << " " << check.name;
+        }
+        std::cerr << std::endl;
+    }
+}
+
+bool CheckLog::expect(bool holds, const std::string& what) {
+    if (!holds) {
+        failed++;
+        if (failed <= MAX_REPORTED) {
+            std::cerr << check << ": " << what << std::endl;
+        }
+    }
+    return holds;
+}
+
+bool readCheckMap(const std::string& directory, const std::string& name,
+                  Graph<RoadNode, RoadEdge>& graph) {
+    std::string fileName = directory + "/" + name;
+    std::ifstream input(fileName.c_str());
+    if (input.fail()) {
+        std::cerr << "Cannot open " << fileName << std::endl;
+        return false;
+    }
+    RoadMapHeader header;
+    return readRoadMapHeader(input, header, /* checkImage */ false)
+            && readRoadMapGraph(input, graph);
+}
+
+int main(int argc, char** argv) {
+    std::string mapDirectory = "res";
+    std::vector<const Check*> chosen;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        const Check* named = nullptr;
+        for (const Check& check : CHECKS) {
+            if (arg == check.name) {
+                named = &check;
+            }
+        }
+        if (arg == "--maps" && i + 1 < argc) {
+            mapDirectory = argv[++i];
+        } else if (named) {
+            chosen.push_back(named);
+        } else {
+            usage();
+            return 1;
+        }
+    }
+    if (chosen.empty()) {
+        for (const Check& check : CHECKS) {
+            chosen.push_back(&check);
+        }
+    }
+
+    int failed = 0;
+    for (const Check* check : chosen) {
+        bool passed = check->run(mapDirectory);
+        std::cout << check->name << ": " << (passed ? "passed" : "FAILED") << std::endl;
+        if (!passed) {
+            failed++;
+        }
+    }
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,50 @@
+/**
+ * @brief This file declares the checks that pathfinder-checks runs and the few
+ * helpers they share.
+ * @version 2026/10/17
+ */
+
+#ifndef _checks_h
+#define _checks_h
+
+#include <string>
+#include "RoadGraph.h"
+
+/*
+ * Counts the comparisons of one check that came out wrong, printing the first
+ * few of them to cerr.
+ */
+class CheckLog {
+public:
+    explicit CheckLog(const std::string& check) : check(check) {}
+
+    /*
+     * Records the outcome of a comparison, printing the given description if it
+     * failed, and returns the outcome.
+     */
+    bool expect(bool holds, const std::string& what);
+
+    /* Returns the number of failed comparisons. */
+    int failures() const { return failed; }
+
+private:
+    std::string check;
+    int failed = 0;
+};
+
+/*
+ * Reads the map file of the given name from the given directory into a graph,
+ * printing the reason to cerr if it cannot.
+ */
+bool readCheckMap(const std::string& directory, const std::string& name,
+                  Graph<RoadNode, RoadEdge>& graph);
+
+/*
+ * The checks. Each reads the maps it needs from the given directory and returns
+ * whether every comparison it made came out right.
+ */
+bool checkEventRing(const std::string& mapDirectory);
+bool checkSpatialIndex(const std::string& mapDirectory);
+bool checkTurnCosts(const std::string& mapDirectory);
+
+#endif // _checks_h
@@ -0,0 +1,151 @@
+/**
+ * @brief This file contains the stress check of EventRing and AsyncRenderer.
+ * @version 2026/10/17
+ *
+ * The check is meant to run in the ThreadSanitizer build of pathfinder-checks,
+ * which reports any data race between the publishing thread and the renderer
+ * thread even when the colors come out right.
+ */
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AsyncRenderer.h"
+#include "EventRing.h"
+#include "checks.h"
+
+namespace {
+    /* The number of events passed between two threads through a small ring. */
+    const int HANDOFF_EVENTS = 200000;
+
+    /* The graph size, burst count and burst size of each renderer run. */
+    const int RENDER_NODES = 5000;
+    const int RENDER_BURSTS = 40;
+    const int RENDER_BURST_EVENTS = 10000;
+
+    /* The number of events published without pause to a renderer that draws slowly. */
+    const int FLOOD_EVENTS = 1000000;
+
+    /* Pushes and pops on one thread, across the wrap of the indices. */
+    void checkSingleThread(CheckLog& log) {
+        EventRing<int> ring(5);
+        log.expect(ring.capacity() == 8, "a ring for 5 events should hold 8");
+        for (int i = 0; i < 8; i++) {
+            log.expect(ring.push(i), "push into a ring that is not full failed");
+        }
+        log.expect(!ring.push(8), "push into a full ring succeeded");
+        int event = -1;
+        for (int i = 0; i < 3; i++) {
+            log.expect(ring.pop(event) && event == i, "pop returned the wrong event");
+        }
+        for (int i = 8; i < 11; i++) {
+            log.expect(ring.push(i), "push after pops failed");
+        }
+        int expected = 3;
+        int drained = ring.drain([&](int drainedEvent) {
+            log.expect(drainedEvent == expected++, "drain returned the events out of order");
+        });
+        log.expect(drained == 8, "drain returned the wrong count");
+        log.expect(!ring.pop(event), "pop from a drained ring succeeded");
+    }
+
+    /* Passes a numbered sequence through a small ring from one thread to another. */
+    void checkHandoff(CheckLog& log) {
+        EventRing<int> ring(1024);
+        int outOfOrder = 0;
+        std::thread consumer([&]() {
+            int expected = 0;
+            int event;
+            while (expected < HANDOFF_EVENTS) {
+                if (ring.pop(event)) {
+                    if (event != expected) {
+                        outOfOrder++;
+                    }
+                    expected++;
+                }
+            }
+        });
+        for (int i = 0; i < HANDOFF_EVENTS; ) {
+            if (ring.push(i)) {
+                i++;
+            }
+        }
+        consumer.join();
+        log.expect(outOfOrder == 0, "the consumer saw events out of order");
+    }
+
+    /*
+     * Publishes bursts of random colors to a renderer with the given frame interval
+     * whose frames take the given time to draw, and checks that the colors drawn
+     * last are those published last unless the renderer reported dropping events.
+     * The renderer is started twice to check that it can be restarted.
+     */
+    void checkRenderer(CheckLog& log, int frameIntervalMS, int drawMS) {
+        std::vector<Color> drawn(RENDER_NODES, Color::WHITE);
+        std::vector<Color> published(RENDER_NODES, Color::WHITE);
+        AsyncRenderer renderer(RENDER_NODES, [&](const std::vector<ColorEvent>& frame) {
+            for (const ColorEvent& event : frame) {
+                drawn[event.node] = event.color;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(drawMS));
+        });
+        std::string run = "interval " + std::to_string(frameIntervalMS) + " ms, drawing "
+                + std::to_string(drawMS) + " ms: ";
+
+        std::mt19937 random(frameIntervalMS * 100 + drawMS);
+        std::uniform_int_distribution<int> pick(0, RENDER_NODES - 1);
+        for (int start = 0; start < 2; start++) {
+            renderer.start(frameIntervalMS);
+            for (int burst = 0; burst < RENDER_BURSTS; burst++) {
+                for (int i = 0; i < RENDER_BURST_EVENTS; i++) {
+                    int node = pick(random);
+                    published[node] = random() % 2 ? Color::YELLOW : Color::GREEN;
+                    renderer.publish(node, published[node]);
+                }
+                std::this_thread::sleep_for(std::chrono::microseconds(500));
+            }
+            bool dropped = renderer.stop();
+            log.expect(dropped || drawn == published,
+                       run + "the final frame does not show the colors published last");
+            log.expect(frameIntervalMS > 0 || renderer.framesDrawn() == 1,
+                       run + "a renderer without an interval drew more than the final frame");
+        }
+    }
+
+    /*
+     * Publishes without pause to a renderer that draws slowly, which fills the
+     * ring, and checks that a run which dropped nothing still ends right.
+     */
+    void checkFlood(CheckLog& log) {
+        const int nodes = 100;
+        std::vector<Color> drawn(nodes, Color::WHITE);
+        AsyncRenderer renderer(nodes, [&](const std::vector<ColorEvent>& frame) {
+            for (const ColorEvent& event : frame) {
+                drawn[event.node] = event.color;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        });
+        renderer.start(1);
+        for (int i = 0; i < FLOOD_EVENTS; i++) {
+            renderer.publish(i % nodes, Color::GREEN);
+        }
+        bool dropped = renderer.stop();
+        log.expect(dropped || drawn == std::vector<Color>(nodes, Color::GREEN),
+                   "flood: the final frame does not show the colors published last");
+    }
+}
+
+bool checkEventRing(const std::string&) {
+    CheckLog log("event-ring");
+    checkSingleThread(log);
+    checkHandoff(log);
+    for (int frameIntervalMS : { 0, 5, 33 }) {
+        for (int drawMS : { 0, 20 }) {
+            checkRenderer(log, frameIntervalMS, drawMS);
+        }
+    }
+    checkFlood(log);
+    return log.failures() == 0;
+}
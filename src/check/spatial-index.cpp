@@ -0,0 +1,142 @@
+/**
+ * @brief This file contains the check of SpatialIndex against brute force.
+ * @version 2026/10/17
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "SpatialIndex.h"
+#include "checks.h"
+
+namespace {
+    /* The number of random queries made of each graph. */
+    const int QUERIES_PER_GRAPH = 1000;
+
+    /* The largest k of the k-nearest queries. */
+    const int MAX_K = 20;
+
+    const char* const MAPS[] = {
+        "map-small.txt",
+        "map-directed.txt",
+        "map-middleearth.txt",
+        "map-usa.txt",
+        "map-san-francisco.txt",
+        "map-istanbul.txt",
+    };
+
+    /*
+     * Asks the index of a graph about random points between low and high in both
+     * coordinates, a third of them exactly on a node, and compares each answer with
+     * a scan of every node: the nearest node with and without a limit, the k nearest
+     * (closest first, ties by ID), the nodes within a radius and those in a rectangle.
+     */
+    void checkGraph(CheckLog& log, const std::string& name, RoadGraph& roadGraph,
+                    std::mt19937& random, double low, double high) {
+        const CompiledRoadGraph& compiled = roadGraph.compile();
+        const SpatialIndex& index = roadGraph.spatialIndex();
+        int n = compiled.nodeCount();
+        std::uniform_real_distribution<double> coordinate(low, high);
+        std::vector<std::pair<double, int>> byDistance;
+        std::vector<int> answer;
+        std::vector<int> expected;
+        for (int query = 0; query < QUERIES_PER_GRAPH; query++) {
+            double x = coordinate(random);
+            double y = coordinate(random);
+            if (query % 3 == 0 && n > 0) {
+                int id = random() % n;
+                x = compiled.x(id);
+                y = compiled.y(id);
+            }
+            std::string at = name + " at (" + std::to_string(x) + ", "
+                    + std::to_string(y) + "): ";
+
+            byDistance.clear();
+            for (int id = 0; id < n; id++) {
+                double dx = compiled.x(id) - x;
+                double dy = compiled.y(id) - y;
+                byDistance.push_back(std::make_pair(dx * dx + dy * dy, id));
+            }
+            std::sort(byDistance.begin(), byDistance.end());
+
+            int nearest = n > 0 ? byDistance[0].second : -1;
+            log.expect(index.nearest(x, y) == nearest, at + "wrong nearest node");
+
+            double radius = std::fabs(coordinate(random)) / 20;
+            int nearestWithin = n > 0 && byDistance[0].first <= radius * radius ? nearest : -1;
+            log.expect(index.nearest(x, y, radius) == nearestWithin,
+                       at + "wrong nearest node within " + std::to_string(radius));
+
+            int k = 1 + random() % MAX_K;
+            index.nearest(x, y, k, answer);
+            expected.clear();
+            for (int i = 0; i < std::min(k, n); i++) {
+                expected.push_back(byDistance[i].second);
+            }
+            log.expect(answer == expected, at + "wrong " + std::to_string(k) + " nearest nodes");
+
+            index.withinRadius(x, y, radius, answer);
+            std::sort(answer.begin(), answer.end());
+            expected.clear();
+            for (const auto& node : byDistance) {
+                if (node.first <= radius * radius) {
+                    expected.push_back(node.second);
+                }
+            }
+            std::sort(expected.begin(), expected.end());
+            log.expect(answer == expected,
+                       at + "wrong nodes within " + std::to_string(radius));
+
+            double x2 = coordinate(random);
+            double y2 = coordinate(random);
+            index.inRectangle(x, y, x2, y2, answer);
+            std::sort(answer.begin(), answer.end());
+            expected.clear();
+            for (int id = 0; id < n; id++) {
+                if (compiled.x(id) >= std::min(x, x2) && compiled.x(id) <= std::max(x, x2)
+                        && compiled.y(id) >= std::min(y, y2)
+                        && compiled.y(id) <= std::max(y, y2)) {
+                    expected.push_back(id);
+                }
+            }
+            log.expect(answer == expected, at + "wrong nodes in the rectangle to ("
+                       + std::to_string(x2) + ", " + std::to_string(y2) + ")");
+        }
+    }
+}
+
+bool checkSpatialIndex(const std::string& mapDirectory) {
+    CheckLog log("spatial-index");
+    std::mt19937 random(7);
+    for (const char* map : MAPS) {
+        Graph<RoadNode, RoadEdge> graph;
+        if (!readCheckMap(mapDirectory, map, graph)) {
+            return false;
+        }
+        RoadGraph roadGraph(&graph);
+        checkGraph(log, map, roadGraph, random, -200, 2000);
+    }
+
+    /* Graphs whose bounding box is a line, a point, or nothing at all. */
+    Graph<RoadNode, RoadEdge> line;
+    for (int i = 0; i < 50; i++) {
+        line.addNode(new RoadNode("line" + std::to_string(i), Point(i * 3, 5)));
+    }
+    RoadGraph lineGraph(&line);
+    checkGraph(log, "a line", lineGraph, random, -10, 200);
+
+    Graph<RoadNode, RoadEdge> point;
+    for (int i = 0; i < 5; i++) {
+        point.addNode(new RoadNode("point" + std::to_string(i), Point(4, 4)));
+    }
+    RoadGraph pointGraph(&point);
+    checkGraph(log, "a point", pointGraph, random, -10, 20);
+
+    Graph<RoadNode, RoadEdge> empty;
+    RoadGraph emptyGraph(&empty);
+    checkGraph(log, "no nodes", emptyGraph, random, 0, 1);
+    return log.failures() == 0;
+}
@@ -0,0 +1,234 @@
+/**
+ * @brief This file contains the check of TurnCosts and the edge-based search
+ * against Dijkstra's algorithm on an explicit line graph.
+ * @version 2026/10/17
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "IndexedHeap.h"
+#include "OneToAllSearch.h"
+#include "RoadMapReader.h"
+#include "TurnCosts.h"
+#include "checks.h"
+#include "pathfinder.h"
+
+namespace {
+    /* The number of random queries made of each map with each set of turn costs. */
+    const int QUERIES_PER_MAP = 60;
+
+    /* One arc in this many gets a random restriction at its end. */
+    const int RESTRICTED_ONE_IN = 10;
+
+    const char* const MAPS[] = {
+        "map-middleearth.txt",
+        "map-usa.txt",
+        "map-directed.txt",
+        "map-istanbul.txt",
+        "map-san-francisco.txt",
+    };
+
+    /* Three nodes: east from A to B, then south (down the screen) to C. */
+    const char* const CORNER_MAP =
+            "IMAGE\nnone.png\n10\n10\n"
+            "VERTICES\nA;0;0\nB;10;0\nC;10;10\n"
+            "EDGES\nA;B;1\nB;C;1\n";
+
+    bool sameCost(double cost, double reference) {
+        return cost == reference
+                || std::fabs(cost - reference) <= 1e-9 * std::max(1.0, reference);
+    }
+
+    /* Checks which kind of turn each turn at the corner of CORNER_MAP is. */
+    void checkCorner(CheckLog& log) {
+        Graph<RoadNode, RoadEdge> graph;
+        std::istringstream input(CORNER_MAP);
+        RoadMapHeader header;
+        if (!log.expect(readRoadMapHeader(input, header, /* checkImage */ false)
+                        && readRoadMapGraph(input, graph), "cannot read the corner map")) {
+            return;
+        }
+        RoadGraph roadGraph(&graph);
+        const CompiledRoadGraph& compiled = roadGraph.compile();
+        TurnPenalties penalties;
+        penalties.leftTurn = 5;
+        penalties.rightTurn = 1;
+        penalties.uTurn = 9;
+        TurnCosts turns(compiled, penalties);
+        int a = compiled.idOf(graph.getNode("A"));
+        int b = compiled.idOf(graph.getNode("B"));
+        int c = compiled.idOf(graph.getNode("C"));
+        int ab = compiled.arcOf(graph.getArc("A", "B"));
+        int ba = compiled.arcOf(graph.getArc("B", "A"));
+        int bc = compiled.arcOf(graph.getArc("B", "C"));
+        int cb = compiled.arcOf(graph.getArc("C", "B"));
+        log.expect(turns.cost(a, b, ab, bc) == 1, "A -> B -> C is not a right turn");
+        log.expect(turns.cost(c, b, cb, ba) == 5, "C -> B -> A is not a left turn");
+        log.expect(turns.cost(a, b, ab, ba) == 9, "A -> B -> A is not a U-turn");
+    }
+
+    /*
+     * Returns the cost of the cheapest path from source to target that Dijkstra's
+     * algorithm finds on the line graph, whose nodes are the arcs of the graph and
+     * whose arcs are its turns, each costing the turn and the arc it turns onto.
+     */
+    double lineGraphCost(const CompiledRoadGraph& compiled, const TurnCosts& turns,
+                         const std::vector<int>& arcSources, int source, int target) {
+        if (source == target) {
+            return 0;
+        }
+        std::vector<double> costs(compiled.arcCount(), INFINITY);
+        IndexedHeap heap(compiled.arcCount());
+        for (int arc = compiled.firstArc(source); arc < compiled.endArc(source); arc++) {
+            if (compiled.arcCost(arc) < costs[arc]) {
+                costs[arc] = compiled.arcCost(arc);
+                heap.pushOrDecrease(arc, costs[arc]);
+            }
+        }
+        while (!heap.isEmpty()) {
+            int arc = heap.pop();
+            int via = compiled.arcTarget(arc);
+            if (via == target) {
+                return costs[arc];
+            }
+            for (int next = compiled.firstArc(via); next < compiled.endArc(via); next++) {
+                double cost = costs[arc] + turns.cost(arcSources[arc], via, arc, next)
+                        + compiled.arcCost(next);
+                if (cost < costs[next]) {
+                    costs[next] = cost;
+                    heap.pushOrDecrease(next, cost);
+                }
+            }
+        }
+        return INFINITY;
+    }
+
+    /*
+     * Returns the cost of a path of node IDs with its turns, taking the cheapest
+     * choice among parallel arcs.
+     */
+    double turnPathCost(const CompiledRoadGraph& compiled, const TurnCosts& turns,
+                        const std::vector<int>& arcSources, const std::vector<int>& path) {
+        std::vector<std::pair<int, double>> reached;   // (last arc, cost) so far
+        std::vector<std::pair<int, double>> next;
+        for (size_t i = 1; i < path.size(); i++) {
+            next.clear();
+            for (int arc = compiled.firstArc(path[i - 1]); arc < compiled.endArc(path[i - 1]);
+                    arc++) {
+                if (compiled.arcTarget(arc) != path[i]) {
+                    continue;
+                }
+                double cheapest = i == 1 ? 0 : INFINITY;
+                for (const auto& before : reached) {
+                    cheapest = std::min(cheapest, before.second
+                            + turns.cost(arcSources[before.first], path[i - 1], before.first,
+                                         arc));
+                }
+                next.push_back(std::make_pair(arc, cheapest + compiled.arcCost(arc)));
+            }
+            reached.swap(next);
+        }
+        double cost = path.size() == 1 ? 0 : INFINITY;
+        for (const auto& last : reached) {
+            cost = std::min(cost, last.second);
+        }
+        return cost;
+    }
+
+    /*
+     * Runs random queries on a map, first with no turn costs, when the edge-based
+     * search must agree with the node-based one, and then with penalties of twice,
+     * half and ten times the mean arc cost for left, right and U-turns and random
+     * restrictions on a tenth of the arcs, half of them bans. Both times the cost
+     * the edge-based search returns and the cost of the path it returns must be
+     * the line graph's.
+     */
+    void checkMap(CheckLog& log, const std::string& name, const CompiledRoadGraph& compiled,
+                  std::mt19937& random) {
+        int n = compiled.nodeCount();
+        int arcCount = compiled.arcCount();
+        std::vector<int> arcSources(arcCount);
+        double meanCost = 0;
+        for (int node = 0; node < n; node++) {
+            for (int arc = compiled.firstArc(node); arc < compiled.endArc(node); arc++) {
+                arcSources[arc] = node;
+                meanCost += compiled.arcCost(arc) / arcCount;
+            }
+        }
+
+        std::vector<TurnRestriction> restrictions;
+        for (int i = 0; i < arcCount / RESTRICTED_ONE_IN; i++) {
+            int arc = random() % arcCount;
+            int via = compiled.arcTarget(arc);
+            if (compiled.endArc(via) == compiled.firstArc(via)) {
+                continue;
+            }
+            TurnRestriction restriction;
+            restriction.from = compiled.arcEdge(arc);
+            restriction.to = compiled.arcEdge(compiled.firstArc(via)
+                    + random() % (compiled.endArc(via) - compiled.firstArc(via)));
+            restriction.penalty = random() % 2 ? INFINITY : (random() % 100) / 100.0;
+            restrictions.push_back(restriction);
+        }
+
+        StraightLineHeuristic heuristic(compiled);
+        OneToAllSearch dijkstra(compiled);
+        SearchWorkspace workspace(arcCount);
+        std::vector<int> path;
+        for (int withTurns = 0; withTurns < 2; withTurns++) {
+            TurnPenalties penalties;
+            if (withTurns) {
+                penalties.leftTurn = meanCost * 2;
+                penalties.rightTurn = meanCost / 2;
+                penalties.uTurn = meanCost * 10;
+            }
+            TurnCosts turns(compiled, penalties,
+                            withTurns ? restrictions : std::vector<TurnRestriction>());
+            for (int query = 0; query < QUERIES_PER_MAP; query++) {
+                int source = random() % n;
+                int target = random() % n;
+                std::string what = name + (withTurns ? " with" : " without") + " turn costs, "
+                        + std::to_string(source) + " -> " + std::to_string(target) + ": ";
+                double expected = lineGraphCost(compiled, turns, arcSources, source, target);
+                double cost = edge_based_a_star(compiled, turns, source, target, heuristic,
+                                                workspace, path);
+                if (!withTurns) {
+                    dijkstra.run(source);
+                    log.expect(sameCost(expected, dijkstra.distance(target)),
+                               what + "the line graph disagrees with Dijkstra");
+                }
+                if (std::isinf(expected)) {
+                    log.expect(std::isinf(cost) && path.empty(),
+                               what + "found a path where there is none");
+                    continue;
+                }
+                log.expect(sameCost(cost, expected), what + "cost " + std::to_string(cost)
+                           + " instead of " + std::to_string(expected));
+                log.expect(!path.empty() && path.front() == source && path.back() == target
+                           && sameCost(turnPathCost(compiled, turns, arcSources, path),
+                                       expected),
+                           what + "the path does not cost what the search says");
+            }
+        }
+    }
+}
+
+bool checkTurnCosts(const std::string& mapDirectory) {
+    CheckLog log("turn-costs");
+    checkCorner(log);
+    std::mt19937 random(9);
+    for (const char* map : MAPS) {
+        Graph<RoadNode, RoadEdge> graph;
+        if (!readCheckMap(mapDirectory, map, graph)) {
+            return false;
+        }
+        RoadGraph roadGraph(&graph);
+        checkMap(log, map, roadGraph.compile(), random);
+    }
+    return log.failures() == 0;
+}
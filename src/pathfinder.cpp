@@ -2,213 +2,688 @@
  * @brief This file implements the graph search algorithms for the project.
  * @headerfile pathfinder.h
  * @author Richik Vivek Sen
+ * @version 2026/10/17
+ * - the searches run over the compiled graph with indexed heaps and parent
+ *   pointers, take a heuristic, and are templated on a tracer policy
+ * - added bidirectional A*, contraction hierarchy queries, time-dependent A*
+ *   and edge-based A*, and ID-based cores that reuse a workspace
+ * - IDA* is iterative and bounded by a transposition table; the periphery
+ *   sweep keeps its frontier in dense arrays
  * @version 2019/04/08
- * @attention All changes to be made in new copies of this file. Comment "TODO",
- * "EDITED", and "FIXME" wherever necessary.
  */
 
 #include "pathfinder.h"
-#include "pqueue.h"
-#include <list>
+#include "IndexedHeap.h"
+#include "SearchWorkspace.h"
+#include "SearchTracer.h"
+#include "SweepFrontier.h"
+#include <algorithm>
 #include <map>
 #include <cmath>
-#include <unordered_set>
-#include <unordered_map>
+#include <vector>
 
 using namespace std;
 
-static const int FOUND_END = -1;
-
 // forward declaring helper functions
 
-Path retrace_path(std::unordered_map<RoadNode*, RoadNode*>& predecessor_of,
-        RoadNode* current);
-Path iterative_deepening_weighted_path_helper(const RoadGraph& graph, RoadNode* source,
-        RoadNode* target, bool is_periphery_sweep);
-double ida_star_helper(const RoadGraph& graph, double g_score, double f_threshold,
-                       double max_speed, RoadNode* target, Path& best_path,
-                       std::unordered_set<RoadNode*> visited);
+Path to_path(const CompiledRoadGraph& compiled, const vector<int>& ids);
+template <typename Tracer>
+double iterative_deepening_weighted_path_helper(const CompiledRoadGraph& compiled,
+        int source_id, int target_id, const Heuristic& heuristic, bool is_periphery_sweep,
+        SearchWorkspace& workspace, SweepFrontier& frontier, vector<int>& best_path,
+        Tracer& tracer);
+template <typename Tracer>
+Path iterative_deepening_weighted_path(const RoadGraph& graph, RoadNode* source,
+        RoadNode* target, const Heuristic& heuristic, bool is_periphery_sweep, Tracer& tracer);
+template <typename Tracer>
+double ida_star_search(const CompiledRoadGraph& compiled, int source_id, int target_id,
+                       const Heuristic& heuristic, DepthFirstWorkspace& workspace,
+                       vector<int>& best_path, Tracer& tracer);
+
+/*
+ * A* that keeps one g-score and predecessor per node and a single heap entry per
+ * open node. A successor reached more cheaply has its heap entry lowered in place,
+ * and a node that was already expanded is only reopened if it is reached more
+ * cheaply than before, which can happen since a heuristic such as the crow-fly
+ * bound is not guaranteed to be consistent.
+ */
+template <typename Tracer>
+double a_star_search(const CompiledRoadGraph& compiled, int source_id, int target_id,
+                     const Heuristic& heuristic, SearchWorkspace& workspace,
+                     vector<int>& best_path, Tracer& tracer) {
+    best_path.clear();
+    workspace.begin();
+    workspace.reach(source_id, 0, -1);
+    workspace.open.pushOrDecrease(source_id, heuristic.estimate(source_id, target_id));
+
+    while (!workspace.open.isEmpty()) {
+        int current = workspace.open.pop();
+        tracer.expanded(current);
+
+        double current_g_score = workspace.gScore(current);
+        if (current == target_id) {
+            workspace.retrace(current, best_path);
+            return current_g_score;
+        }
+
+        for (int arc = compiled.firstArc(current); arc < compiled.endArc(current); arc++) {
+            int successor = compiled.arcTarget(arc);
+            double successor_g_score = current_g_score + compiled.arcCost(arc);
+            if (successor_g_score < workspace.gScore(successor)) {
+                workspace.reach(successor, successor_g_score, current);
+                workspace.open.pushOrDecrease(successor,
+                        successor_g_score + heuristic.estimate(successor, target_id));
+                tracer.reached(successor);
+            }
+        }
+    }
+    return INFINITY;
+}
 
 Path a_star(const RoadGraph& graph, RoadNode* source, RoadNode* target) {
-    PriorityQueue<Path> remaining;
-    unordered_set<RoadNode*> visited;
-    Path initial_path;
+    return a_star(graph, source, target, CrowFlyHeuristic(graph));
+}
+
+Path a_star(const RoadGraph& graph, RoadNode* source, RoadNode* target,
+            const Heuristic& heuristic) {
+    AnimationTracer tracer(graph.compile());
+    return a_star(graph, source, target, heuristic, tracer);
+}
+
+template <typename Tracer>
+Path a_star(const RoadGraph& graph, RoadNode* source, RoadNode* target,
+            const Heuristic& heuristic, Tracer& tracer) {
+    const CompiledRoadGraph& compiled = graph.compile();
+    SearchWorkspace workspace(compiled.nodeCount());
+    vector<int> best_path;
+    a_star_search(compiled, compiled.idOf(source), compiled.idOf(target), heuristic,
+                  workspace, best_path, tracer);
+    return to_path(compiled, best_path);
+}
+
+double a_star(const CompiledRoadGraph& compiled, int source, int target,
+              const Heuristic& heuristic, SearchWorkspace& workspace, vector<int>& path) {
+    NullTracer tracer;
+    return a_star_search(compiled, source, target, heuristic, workspace, path, tracer);
+}
+
+/*
+ * A* with arc costs evaluated at the time the search enters each arc, which is
+ * the departure time plus the g-score of the arc's start. The reader rejects
+ * profiles that would let a later start arrive earlier, so arriving at a node
+ * sooner never makes the rest of the path slower, and the g-score of a node can
+ * be its earliest arrival just as in a_star_search. Evaluating a profile reads
+ * a few breakpoints from one array, so the search allocates nothing more than
+ * the static one.
+ */
+template <typename Tracer>
+double time_dependent_a_star_search(const CompiledRoadGraph& compiled,
+                                    const TravelTimeProfiles& profiles, int source_id,
+                                    int target_id, double departure,
+                                    const Heuristic& heuristic, SearchWorkspace& workspace,
+                                    vector<int>& best_path, Tracer& tracer) {
+    double scale = min(1.0, profiles.minimumFactor());
+    best_path.clear();
+    workspace.begin();
+    workspace.reach(source_id, 0, -1);
+    workspace.open.pushOrDecrease(source_id, scale * heuristic.estimate(source_id, target_id));
+
+    while (!workspace.open.isEmpty()) {
+        int current = workspace.open.pop();
+        tracer.expanded(current);
+
+        double current_g_score = workspace.gScore(current);
+        if (current == target_id) {
+            workspace.retrace(current, best_path);
+            return current_g_score;
+        }
+
+        double entered = departure + current_g_score;
+        for (int arc = compiled.firstArc(current); arc < compiled.endArc(current); arc++) {
+            int successor = compiled.arcTarget(arc);
+            double cost = compiled.arcCost(arc);
+            int profile = compiled.arcProfile(arc);
+            if (profile != -1) {
+                cost *= profiles.factorAt(profile, entered);
+            }
+            double successor_g_score = current_g_score + cost;
+            if (successor_g_score < workspace.gScore(successor)) {
+                workspace.reach(successor, successor_g_score, current);
+                workspace.open.pushOrDecrease(successor,
+                        successor_g_score + scale * heuristic.estimate(successor, target_id));
+                tracer.reached(successor);
+            }
+        }
+    }
+    return INFINITY;
+}
+
+Path time_dependent_a_star(const RoadGraph& graph, const TravelTimeProfiles& profiles,
+                           RoadNode* source, RoadNode* target, double departure) {
+    return time_dependent_a_star(graph, profiles, source, target, departure,
+                                 CrowFlyHeuristic(graph));
+}
+
+Path time_dependent_a_star(const RoadGraph& graph, const TravelTimeProfiles& profiles,
+                           RoadNode* source, RoadNode* target, double departure,
+                           const Heuristic& heuristic) {
+    AnimationTracer tracer(graph.compile());
+    return time_dependent_a_star(graph, profiles, source, target, departure, heuristic,
+                                 tracer);
+}
 
-    initial_path.add(source);
-    double max_speed = graph.maxRoadSpeed();
-    double source_f_score = graph.crowFlyDistanceBetween(source, target) / max_speed;
-    remaining.enqueue(initial_path, source_f_score);
+template <typename Tracer>
+Path time_dependent_a_star(const RoadGraph& graph, const TravelTimeProfiles& profiles,
+                           RoadNode* source, RoadNode* target, double departure,
+                           const Heuristic& heuristic, Tracer& tracer) {
+    const CompiledRoadGraph& compiled = graph.compile();
+    SearchWorkspace workspace(compiled.nodeCount());
+    vector<int> best_path;
+    time_dependent_a_star_search(compiled, profiles, compiled.idOf(source),
+                                 compiled.idOf(target), departure, heuristic, workspace,
+                                 best_path, tracer);
+    return to_path(compiled, best_path);
+}
+
+double time_dependent_a_star(const CompiledRoadGraph& compiled,
+                             const TravelTimeProfiles& profiles, int source, int target,
+                             double departure, const Heuristic& heuristic,
+                             SearchWorkspace& workspace, vector<int>& path) {
+    NullTracer tracer;
+    return time_dependent_a_star_search(compiled, profiles, source, target, departure,
+                                        heuristic, workspace, path, tracer);
+}
 
-    while (!remaining.isEmpty()) {
-        double current_f_score = remaining.peekPriority();
-        Path current_path = remaining.dequeue();
-        RoadNode* current = current_path[current_path.size() - 1];
+/*
+ * A* over the line graph, whose states are the arcs of the graph: arc a, from u
+ * to v, stands for "arrived at v along a", and has one successor for every arc b
+ * leaving v, at the cost of the turn from a onto b plus the cost of b. The
+ * successors are read straight from the CSR arrays and the turn costs are worked
+ * out as they are needed, so the line graph itself is never built; only the
+ * workspace is indexed by arc. The node a state came from is the target of its
+ * predecessor, or the source for the arcs leaving the source.
+ */
+template <typename Tracer>
+double edge_based_a_star_search(const CompiledRoadGraph& compiled, const TurnCosts& turns,
+                                int source_id, int target_id, const Heuristic& heuristic,
+                                SearchWorkspace& workspace, vector<int>& best_path,
+                                Tracer& tracer) {
+    best_path.clear();
+    if (source_id == target_id) {
+        best_path.push_back(source_id);
+        return 0;
+    }
+    workspace.begin();
+    tracer.expanded(source_id);
+    for (int arc = compiled.firstArc(source_id); arc < compiled.endArc(source_id); arc++) {
+        int successor = compiled.arcTarget(arc);
+        double arc_g_score = compiled.arcCost(arc);
+        if (arc_g_score < workspace.gScore(arc)) {
+            workspace.reach(arc, arc_g_score, -1);
+            workspace.open.pushOrDecrease(arc,
+                    arc_g_score + heuristic.estimate(successor, target_id));
+            tracer.reached(successor);
+        }
+    }
 
-        double current_heuristic = graph.crowFlyDistanceBetween(current, target)
-                / max_speed;
-        double current_g_score = current_f_score - current_heuristic;
+    while (!workspace.open.isEmpty()) {
+        int current = workspace.open.pop();
+        int via = compiled.arcTarget(current);
+        tracer.expanded(via);
 
-        visited.insert(current);
-        current->setColor(Color::GREEN);
+        double current_g_score = workspace.gScore(current);
+        if (via == target_id) {
+            workspace.retrace(current, best_path);
+            for (int& step : best_path) {
+                step = compiled.arcTarget(step);
+            }
+            best_path.insert(best_path.begin(), source_id);
+            return current_g_score;
+        }
 
-        if (current == target) {
-            return current_path;
+        int previous = workspace.predecessor(current);
+        int from = previous == -1 ? source_id : compiled.arcTarget(previous);
+        for (int arc = compiled.firstArc(via); arc < compiled.endArc(via); arc++) {
+            int successor = compiled.arcTarget(arc);
+            double arc_g_score = current_g_score + turns.cost(from, via, current, arc)
+                    + compiled.arcCost(arc);
+            if (arc_g_score < workspace.gScore(arc)) {
+                workspace.reach(arc, arc_g_score, current);
+                workspace.open.pushOrDecrease(arc,
+                        arc_g_score + heuristic.estimate(successor, target_id));
+                tracer.reached(successor);
+            }
         }
+    }
+    return INFINITY;
+}
+
+Path edge_based_a_star(const RoadGraph& graph, const TurnCosts& turns,
+                       RoadNode* source, RoadNode* target) {
+    return edge_based_a_star(graph, turns, source, target, CrowFlyHeuristic(graph));
+}
 
-        for (RoadNode* successor : graph.neighborsOf(current)) {
-            RoadEdge* next_edge = graph.edgeBetween(current, successor);
-            if (!visited.count(successor)) {
-                successor->setColor(Color::YELLOW);
-                Path new_path = current_path;
-                new_path.add(successor);
+Path edge_based_a_star(const RoadGraph& graph, const TurnCosts& turns,
+                       RoadNode* source, RoadNode* target, const Heuristic& heuristic) {
+    AnimationTracer tracer(graph.compile());
+    return edge_based_a_star(graph, turns, source, target, heuristic, tracer);
+}
+
+template <typename Tracer>
+Path edge_based_a_star(const RoadGraph& graph, const TurnCosts& turns,
+                       RoadNode* source, RoadNode* target, const Heuristic& heuristic,
+                       Tracer& tracer) {
+    const CompiledRoadGraph& compiled = graph.compile();
+    SearchWorkspace workspace(compiled.arcCount());
+    vector<int> best_path;
+    edge_based_a_star_search(compiled, turns, compiled.idOf(source), compiled.idOf(target),
+                             heuristic, workspace, best_path, tracer);
+    return to_path(compiled, best_path);
+}
 
-                double successor_heuristic = graph.crowFlyDistanceBetween(successor, target)
-                        / max_speed;
-                double successor_g_score = current_g_score + next_edge->cost();
-                double successor_f_score = successor_g_score + successor_heuristic;
-                remaining.enqueue(new_path, successor_f_score);
+double edge_based_a_star(const CompiledRoadGraph& compiled, const TurnCosts& turns,
+                         int source, int target, const Heuristic& heuristic,
+                         SearchWorkspace& workspace, vector<int>& path) {
+    NullTracer tracer;
+    return edge_based_a_star_search(compiled, turns, source, target, heuristic, workspace,
+                                    path, tracer);
+}
+
+/*
+ * Bidirectional A* with the average potential pair of Ikeda et al.:
+ *
+ *     p_f(v) = (h(v, target) - h(source, v)) / 2,    p_r(v) = -p_f(v)
+ *
+ * where h is the heuristic. Both searches then see the same reduced arc
+ * costs, so the forward search from the source and the backward search from the
+ * target (over the reverse arcs, which matters for directed maps) can be
+ * stopped as soon as the two smallest open keys add up to at least the best
+ * source-target cost mu seen so far. Each step expands whichever side has the
+ * smaller open key.
+ */
+template <typename Tracer>
+double bidirectional_a_star_search(const CompiledRoadGraph& compiled, int source_id,
+                                   int target_id, const Heuristic& heuristic,
+                                   SearchWorkspace& forward, SearchWorkspace& backward,
+                                   vector<int>& best_path, Tracer& tracer) {
+    auto forward_potential = [&](int v) {
+        return (heuristic.estimate(v, target_id) - heuristic.estimate(source_id, v)) / 2;
+    };
+
+    best_path.clear();
+    forward.begin();
+    backward.begin();
+    forward.reach(source_id, 0, -1);
+    backward.reach(target_id, 0, -1);
+    forward.open.pushOrDecrease(source_id, forward_potential(source_id));
+    backward.open.pushOrDecrease(target_id, -forward_potential(target_id));
+
+    double mu = source_id == target_id ? 0 : INFINITY;
+    int meeting = source_id == target_id ? source_id : -1;
+
+    while (!forward.open.isEmpty() && !backward.open.isEmpty()
+           && forward.open.peekPriority() + backward.open.peekPriority() < mu) {
+        if (forward.open.peekPriority() <= backward.open.peekPriority()) {
+            int current = forward.open.pop();
+            tracer.expanded(current);
+            double current_g_score = forward.gScore(current);
+            for (int arc = compiled.firstArc(current); arc < compiled.endArc(current); arc++) {
+                int successor = compiled.arcTarget(arc);
+                double successor_g_score = current_g_score + compiled.arcCost(arc);
+                if (successor_g_score < forward.gScore(successor)) {
+                    forward.reach(successor, successor_g_score, current);
+                    forward.open.pushOrDecrease(successor,
+                            successor_g_score + forward_potential(successor));
+                    tracer.reached(successor);
+                    if (successor_g_score + backward.gScore(successor) < mu) {
+                        mu = successor_g_score + backward.gScore(successor);
+                        meeting = successor;
+                    }
+                }
+            }
+        } else {
+            int current = backward.open.pop();
+            tracer.expanded(current);
+            double current_g_score = backward.gScore(current);
+            for (int in_arc = compiled.firstInArc(current); in_arc < compiled.endInArc(current);
+                 in_arc++) {
+                int predecessor = compiled.inArcSource(in_arc);
+                double predecessor_g_score = current_g_score + compiled.inArcCost(in_arc);
+                if (predecessor_g_score < backward.gScore(predecessor)) {
+                    backward.reach(predecessor, predecessor_g_score, current);
+                    backward.open.pushOrDecrease(predecessor,
+                            predecessor_g_score - forward_potential(predecessor));
+                    tracer.reached(predecessor);
+                    if (forward.gScore(predecessor) + predecessor_g_score < mu) {
+                        mu = forward.gScore(predecessor) + predecessor_g_score;
+                        meeting = predecessor;
+                    }
+                }
             }
         }
     }
-    Path no_path;
-    return no_path;
+
+    if (meeting == -1) {
+        return INFINITY;
+    }
+    // the backward predecessors lead from the meeting node on to the target
+    forward.retrace(meeting, best_path);
+    for (int v = backward.predecessor(meeting); v != -1; v = backward.predecessor(v)) {
+        best_path.push_back(v);
+    }
+    return mu;
+}
+
+Path bidirectional_a_star(const RoadGraph& graph, RoadNode* source, RoadNode* target) {
+    return bidirectional_a_star(graph, source, target, CrowFlyHeuristic(graph));
+}
+
+Path bidirectional_a_star(const RoadGraph& graph, RoadNode* source, RoadNode* target,
+                          const Heuristic& heuristic) {
+    AnimationTracer tracer(graph.compile());
+    return bidirectional_a_star(graph, source, target, heuristic, tracer);
+}
+
+template <typename Tracer>
+Path bidirectional_a_star(const RoadGraph& graph, RoadNode* source, RoadNode* target,
+                          const Heuristic& heuristic, Tracer& tracer) {
+    const CompiledRoadGraph& compiled = graph.compile();
+    SearchWorkspace forward(compiled.nodeCount()), backward(compiled.nodeCount());
+    vector<int> best_path;
+    bidirectional_a_star_search(compiled, compiled.idOf(source), compiled.idOf(target),
+                                heuristic, forward, backward, best_path, tracer);
+    return to_path(compiled, best_path);
+}
+
+double bidirectional_a_star(const CompiledRoadGraph& compiled, int source, int target,
+                            const Heuristic& heuristic, SearchWorkspace& forward,
+                            SearchWorkspace& backward, vector<int>& path) {
+    NullTracer tracer;
+    return bidirectional_a_star_search(compiled, source, target, heuristic,
+                                       forward, backward, path, tracer);
 }
 
 Path periphery_sweep(const RoadGraph& graph, RoadNode *source, RoadNode *target) {
-    return iterative_deepening_weighted_path_helper(graph, source, target, true);
+    return periphery_sweep(graph, source, target, CrowFlyHeuristic(graph));
+}
+
+Path periphery_sweep(const RoadGraph& graph, RoadNode* source, RoadNode* target,
+                     const Heuristic& heuristic) {
+    AnimationTracer tracer(graph.compile());
+    return periphery_sweep(graph, source, target, heuristic, tracer);
+}
+
+template <typename Tracer>
+Path periphery_sweep(const RoadGraph& graph, RoadNode* source, RoadNode* target,
+                     const Heuristic& heuristic, Tracer& tracer) {
+    return iterative_deepening_weighted_path(graph, source, target, heuristic, true, tracer);
+}
+
+double periphery_sweep(const CompiledRoadGraph& compiled, int source, int target,
+                       const Heuristic& heuristic, SearchWorkspace& workspace,
+                       SweepFrontier& frontier, vector<int>& path) {
+    NullTracer tracer;
+    return iterative_deepening_weighted_path_helper(compiled, source, target, heuristic, true,
+                                                    workspace, frontier, path, tracer);
 }
 
 Path memory_optimized_ida_star(const RoadGraph& graph, RoadNode* source, RoadNode* target) {
-    return iterative_deepening_weighted_path_helper(graph, source, target, false);
+    return memory_optimized_ida_star(graph, source, target, CrowFlyHeuristic(graph));
 }
 
-Path iterative_deepening_weighted_path_helper(const RoadGraph& graph, RoadNode* source,
-        RoadNode* target, bool is_periphery_sweep) {
-    list<RoadNode*> frontier;
-    unordered_map<RoadNode*, list<RoadNode*>::iterator> node_location_in_frontier;
-    frontier.insert(frontier.begin(), source);
-    node_location_in_frontier[source] = frontier.begin();
+Path memory_optimized_ida_star(const RoadGraph& graph, RoadNode* source, RoadNode* target,
+                               const Heuristic& heuristic) {
+    AnimationTracer tracer(graph.compile());
+    return memory_optimized_ida_star(graph, source, target, heuristic, tracer);
+}
 
-    unordered_map<RoadNode*, double> g_score;
-    std::unordered_map<RoadNode*, RoadNode*> predecessor_of;
-    g_score[source] = 0;
-    predecessor_of[source] = nullptr;
-    double max_speed = graph.maxRoadSpeed();
+template <typename Tracer>
+Path memory_optimized_ida_star(const RoadGraph& graph, RoadNode* source, RoadNode* target,
+                               const Heuristic& heuristic, Tracer& tracer) {
+    return iterative_deepening_weighted_path(graph, source, target, heuristic, false, tracer);
+}
 
-    double f_threshold = graph.crowFlyDistanceBetween(source, target) / max_speed;
+template <typename Tracer>
+Path iterative_deepening_weighted_path(const RoadGraph& graph, RoadNode* source,
+        RoadNode* target, const Heuristic& heuristic, bool is_periphery_sweep, Tracer& tracer) {
+    const CompiledRoadGraph& compiled = graph.compile();
+    SearchWorkspace workspace(compiled.nodeCount());
+    SweepFrontier frontier(compiled.nodeCount());
+    vector<int> best_path;
+    iterative_deepening_weighted_path_helper(compiled, compiled.idOf(source),
+                                             compiled.idOf(target), heuristic,
+                                             is_periphery_sweep, workspace, frontier,
+                                             best_path, tracer);
+    return to_path(compiled, best_path);
+}
 
-    while (!frontier.empty()) {
+/*
+ * Sweeps the frontier from front to back once per f-threshold, expanding every node
+ * whose f-score is within it; a node reached more cheaply moves to the back of the
+ * frontier and is met again later in the same sweep. The periphery sweep drops a
+ * node from the frontier once it has been expanded, while memory-optimized IDA*
+ * keeps it and expands it again in every later sweep.
+ *
+ * Each frontier entry carries the f-score its node was listed with, which stays
+ * exact because a node is relisted whenever its g-score improves, so a node above
+ * the threshold costs one read of the frontier arrays and no heuristic call.
+ */
+template <typename Tracer>
+double iterative_deepening_weighted_path_helper(const CompiledRoadGraph& compiled,
+        int source_id, int target_id, const Heuristic& heuristic, bool is_periphery_sweep,
+        SearchWorkspace& workspace, SweepFrontier& frontier, vector<int>& best_path,
+        Tracer& tracer) {
+    best_path.clear();
+    workspace.begin();
+    frontier.clear();
+
+    double f_threshold = heuristic.estimate(source_id, target_id);
+    workspace.reach(source_id, 0, -1);
+    frontier.pushBack(source_id, f_threshold);
+
+    while (!frontier.isEmpty()) {
         double f_min = INFINITY;
-        for (RoadNode* current : frontier) {
-            double current_g_score = g_score[current];
-            double current_f_score = current_g_score +
-                    graph.crowFlyDistanceBetween(current, target) / max_speed;
-
+        bool relaxed = false;
+        for (int slot = 0; slot < frontier.slotCount(); slot++) {
+            int current = frontier.idAt(slot);
+            if (current == SweepFrontier::REMOVED) {
+                continue;
+            }
+            double current_f_score = frontier.fScoreAt(slot);
             if (current_f_score > f_threshold) {
                 f_min = min(current_f_score, f_min);
                 continue;
             }
 
-            current->setColor(Color::GREEN);
-            if (current == target) {
-                return retrace_path(predecessor_of, current);
+            tracer.expanded(current);
+            double current_g_score = workspace.gScore(current);
+            if (current == target_id) {
+                workspace.retrace(current, best_path);
+                frontier.clear();
+                return current_g_score;
             }
 
-           for (RoadNode* successor : graph.neighborsOf(current)) {
-                RoadEdge* next_edge = graph.edgeBetween(current, successor);
-                double successor_g_score = current_g_score + next_edge->cost();
-                if (g_score.count(successor)) {
-                    if (successor_g_score >= g_score[successor]) {
-                        continue;
-                    }
-                }
-
-                if (node_location_in_frontier.count(successor)) {
-                    frontier.erase(node_location_in_frontier[successor]);
-                    node_location_in_frontier.erase(successor);
+            for (int arc = compiled.firstArc(current); arc < compiled.endArc(current); arc++) {
+                int successor = compiled.arcTarget(arc);
+                double successor_g_score = current_g_score + compiled.arcCost(arc);
+                if (successor_g_score >= workspace.gScore(successor)) {
+                    continue;
                 }
-                frontier.insert(frontier.end(), successor);
-                node_location_in_frontier[successor]= --frontier.end();
-                g_score[successor] = successor_g_score;
-                predecessor_of[successor] = current;
-                successor->setColor(Color::YELLOW);
+                workspace.reach(successor, successor_g_score, current);
+                frontier.pushBack(successor,
+                        successor_g_score + heuristic.estimate(successor, target_id));
+                relaxed = true;
+                tracer.reached(successor);
             }
             if (is_periphery_sweep) {
-               frontier.erase(node_location_in_frontier[current]);
-               node_location_in_frontier.erase(current);
+                frontier.remove(current);
             }
         }
+        if (!relaxed && f_min == INFINITY) {
+            // every frontier node was expanded without improving anything, so the
+            // next sweep would repeat this one forever; the target is unreachable
+            break;
+        }
+        frontier.compact();
         f_threshold = f_min;
     }
-    Path no_path;
-    return no_path;
+    frontier.clear();
+    return INFINITY;
 }
 
-Path retrace_path(std::unordered_map<RoadNode*, RoadNode*>& predecessor_of,
-        RoadNode* current) {
-    Path best_path;
-    while (current) {
-        best_path.insert(0, current);
-        current = predecessor_of[current];
+Path to_path(const CompiledRoadGraph& compiled, const vector<int>& ids) {
+    Path path;
+    path.ensureCapacity(static_cast<int>(ids.size()));
+    for (int id : ids) {
+        path.add(compiled.nodeAt(id));
     }
-    return best_path;
+    return path;
 }
 
 Path ida_star(const RoadGraph& graph, RoadNode* source, RoadNode* target) {
-    double max_speed = graph.maxRoadSpeed();
-    double f_threshold = graph.crowFlyDistanceBetween(source, target) / max_speed;
-    Path best_path;
-    unordered_set<RoadNode*> visited;
-    best_path.add(source);
-    visited.insert(source);
+    return ida_star(graph, source, target, CrowFlyHeuristic(graph));
+}
 
+Path ida_star(const RoadGraph& graph, RoadNode* source, RoadNode* target,
+              const Heuristic& heuristic) {
+    AnimationTracer tracer(graph.compile());
+    return ida_star(graph, source, target, heuristic, tracer);
+}
+
+template <typename Tracer>
+Path ida_star(const RoadGraph& graph, RoadNode* source, RoadNode* target,
+              const Heuristic& heuristic, Tracer& tracer, size_t tableBytes) {
+    const CompiledRoadGraph& compiled = graph.compile();
+    DepthFirstWorkspace workspace(compiled.nodeCount(), tableBytes);
+    vector<int> best_path;
+    ida_star_search(compiled, compiled.idOf(source), compiled.idOf(target), heuristic,
+                    workspace, best_path, tracer);
+    return to_path(compiled, best_path);
+}
+
+double ida_star(const CompiledRoadGraph& compiled, int source, int target,
+                const Heuristic& heuristic, DepthFirstWorkspace& workspace,
+                vector<int>& path) {
+    NullTracer tracer;
+    return ida_star_search(compiled, source, target, heuristic, workspace, path, tracer);
+}
+
+/*
+ * Depth-first search from the source, cut off at nodes whose f-score exceeds the
+ * threshold, and repeated with the threshold raised to the smallest f-score that
+ * was cut off until the target is expanded. The path is kept on an explicit stack,
+ * so the depth of the search is not limited by the call stack, and a successor is
+ * skipped if it is already on the path (a cycle) or if the transposition table
+ * knows a cheaper way to it. The table outlives the iterations, so a node reached
+ * more cheaply in an earlier iteration is not searched from again.
+ */
+template <typename Tracer>
+double ida_star_search(const CompiledRoadGraph& compiled, int source_id, int target_id,
+                       const Heuristic& heuristic, DepthFirstWorkspace& workspace,
+                       vector<int>& best_path, Tracer& tracer) {
+    best_path.clear();
+    workspace.clear();
+    workspace.table.beginSearch();
+
+    double f_threshold = heuristic.estimate(source_id, target_id);
     while (true) {
-        double cost = ida_star_helper(graph, 0, f_threshold, max_speed, target,
-                best_path, visited);
-        if (cost == FOUND_END) {
-            return best_path;
+        tracer.expanded(source_id);
+        if (source_id == target_id) {
+            best_path.push_back(source_id);
+            return 0;
         }
-        if (cost == INFINITY) {
-            break;
+        workspace.table.admit(source_id, 0);
+        workspace.push(source_id, 0, compiled.firstArc(source_id));
+
+        double f_min = INFINITY;
+        while (workspace.depth() > 0) {
+            int current = workspace.top();
+            int& arc = workspace.topNextArc();
+            if (arc == compiled.endArc(current)) {
+                workspace.pop();
+                continue;
+            }
+            int successor = compiled.arcTarget(arc);
+            double successor_g_score = workspace.topGScore() + compiled.arcCost(arc);
+            arc++;
+
+            if (workspace.isOnPath(successor)
+                    || !workspace.table.admit(successor, successor_g_score)) {
+                continue;
+            }
+            tracer.reached(successor);
+            double successor_f_score =
+                    successor_g_score + heuristic.estimate(successor, target_id);
+            if (successor_f_score > f_threshold) {
+                f_min = min(f_min, successor_f_score);
+                continue;
+            }
+
+            tracer.expanded(successor);
+            workspace.push(successor, successor_g_score, compiled.firstArc(successor));
+            if (successor == target_id) {
+                best_path = workspace.nodes();
+                workspace.clear();
+                return successor_g_score;
+            }
         }
-        f_threshold = cost;
+        if (f_min == INFINITY) {
+            return INFINITY;
+        }
+        f_threshold = f_min;
+        workspace.table.beginIteration();
     }
-    Path no_path;
-    return no_path;
 }
 
-double ida_star_helper(const RoadGraph& graph, double current_g_score, double f_threshold,
-        double max_speed, RoadNode* target, Path& best_path, unordered_set<RoadNode*> visited) {
-    RoadNode* current = best_path[best_path.size() - 1];
-    double current_f_score = current_g_score + graph.crowFlyDistanceBetween(current, target)
-            / max_speed;
-
-    if (current_f_score > f_threshold) {
-        return current_f_score;
-    }
-    current->setColor(Color::GREEN);
+/*
+ * Answers the query on the graph's contraction hierarchy, which is built the first
+ * time it is needed. The nodes the upward searches settle are reported as expanded
+ * afterwards, in the order they were settled.
+ */
+Path contraction_hierarchy(const RoadGraph& graph, RoadNode* source, RoadNode* target) {
+    AnimationTracer tracer(graph.compile());
+    return contraction_hierarchy(graph, source, target, tracer);
+}
 
-    if (current == target) {
-        return FOUND_END;
+template <typename Tracer>
+Path contraction_hierarchy(const RoadGraph& graph, RoadNode* source, RoadNode* target,
+                           Tracer& tracer) {
+    const CompiledRoadGraph& compiled = graph.compile();
+    ContractionHierarchyQuery query(graph.hierarchy());
+    double cost = query.run(compiled.idOf(source), compiled.idOf(target));
+    for (int settled : query.settledNodes()) {
+        tracer.expanded(settled);
     }
-
-    double f_min = INFINITY;
-
-    for (RoadNode* successor : graph.neighborsOf(current)) {
-        if (!visited.count(successor)) {
-            successor->setColor(Color::YELLOW);
-            best_path.add(successor);
-            visited.insert(successor);
-            RoadEdge* next_edge = graph.edgeBetween(current, successor);
-            double temp_min = ida_star_helper(graph, current_g_score + next_edge->cost(),
-                    f_threshold, max_speed, target, best_path, visited);
-            if (temp_min == FOUND_END) {
-                return FOUND_END;
-            }
-            f_min = min(f_min, temp_min);
-            best_path.remove(best_path.size() - 1);
-        }
+    if (cost == INFINITY) {
+        Path no_path;
+        return no_path;
     }
-    return f_min;
+    vector<int> best_path;
+    query.unpackPath(best_path);
+    return to_path(compiled, best_path);
 }
 
+/*
+ * The searches are compiled once for each of the tracers in SearchTracer.h, so
+ * callers only need the declarations in pathfinder.h.
+ */
+#define INSTANTIATE_SEARCHES(Tracer) \
+    template Path a_star(const RoadGraph&, RoadNode*, RoadNode*, const Heuristic&, Tracer&); \
+    template Path bidirectional_a_star(const RoadGraph&, RoadNode*, RoadNode*, \
+                                       const Heuristic&, Tracer&); \
+    template Path periphery_sweep(const RoadGraph&, RoadNode*, RoadNode*, const Heuristic&, \
+                                  Tracer&); \
+    template Path memory_optimized_ida_star(const RoadGraph&, RoadNode*, RoadNode*, \
+                                            const Heuristic&, Tracer&); \
+    template Path ida_star(const RoadGraph&, RoadNode*, RoadNode*, const Heuristic&, Tracer&, \
+                           size_t); \
+    template Path contraction_hierarchy(const RoadGraph&, RoadNode*, RoadNode*, Tracer&); \
+    template Path time_dependent_a_star(const RoadGraph&, const TravelTimeProfiles&, \
+                                        RoadNode*, RoadNode*, double, const Heuristic&, \
+                                        Tracer&); \
+    template Path edge_based_a_star(const RoadGraph&, const TurnCosts&, RoadNode*, RoadNode*, \
+                                    const Heuristic&, Tracer&);
+
+INSTANTIATE_SEARCHES(NullTracer)
+INSTANTIATE_SEARCHES(AnimationTracer)
+INSTANTIATE_SEARCHES(CountingTracer)
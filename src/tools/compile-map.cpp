@@ -0,0 +1,99 @@
+/**
+ * @brief This file contains the map compiler, which turns a world text file into a
+ * binary map that can be memory-mapped and searched without parsing.
+ * @version 2026/10/16
+ *
+ * Usage: pathfinder-compile-map <map file> <binary map file>
+ *
+ * A map with a second metric keeps it in the binary map.
+ */
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "RoadGraph.h"
+#include "RoadMapBinary.h"
+#include "RoadMapReader.h"
+
+/* Like the benchmark, the compiler does without the Java back-end. */
+#undef main
+
+/* Helper functions local to this file. */
+namespace {
+    void usage() {
+        std::cerr << "Usage: pathfinder-compile-map <map file> <binary map file>" << std::endl;
+    }
+
+    double secondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+/*
+ * Reads the text map, writes the binary map, and then maps the result back in to
+ * check it, reporting how long parsing and mapping each took.
+ */
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        usage();
+        return 1;
+    }
+    std::string mapFile = argv[1];
+    std::string binaryFile = argv[2];
+
+    auto start = std::chrono::steady_clock::now();
+    std::ifstream input(mapFile.c_str());
+    if (input.fail()) {
+        std::cerr << "Cannot open " << mapFile << std::endl;
+        return 1;
+    }
+    Graph<RoadNode, RoadEdge> graph;
+    RoadMapHeader header;
+    TravelTimeProfiles profiles;
+    std::vector<TurnRestriction> restrictions;
+    if (!readRoadMapHeader(input, header, /* checkImage */ false)
+            || !readRoadMapGraph(input, graph, &profiles, &restrictions)) {
+        return 1;
+    }
+    if (profiles.profileCount() > 0) {
+        std::cerr << "Warning: binary maps do not hold travel time profiles; the "
+                  << profiles.profileCount() << " in " << mapFile << " are left out"
+                  << std::endl;
+    }
+    if (!restrictions.empty()) {
+        std::cerr << "Warning: binary maps do not hold turn restrictions; the "
+                  << restrictions.size() << " in " << mapFile << " are left out"
+                  << std::endl;
+    }
+    RoadGraph roadGraph(&graph);
+    roadGraph.compile();
+    double parseSeconds = secondsSince(start);
+
+    std::ofstream output(binaryFile.c_str(), std::ios::binary);
+    if (output.fail()) {
+        std::cerr << "Cannot create " << binaryFile << std::endl;
+        return 1;
+    }
+    if (!writeRoadMapBinary(output, header, roadGraph)) {
+        return 1;
+    }
+    output.close();
+
+    start = std::chrono::steady_clock::now();
+    MappedRoadMap mapped;
+    if (!mapped.open(binaryFile)) {
+        return 1;
+    }
+    CompiledRoadGraph view(mapped);
+    double mapSeconds = secondsSince(start);
+
+    std::cout << binaryFile << ": " << view.nodeCount() << " nodes, "
+              << view.arcCount() << " arcs"
+              << (view.hasSecondMetric() ? ", with a second metric" : "") << std::endl;
+    std::cout << "parse and compile " << mapFile << ": " << parseSeconds * 1000 << " ms"
+              << std::endl;
+    std::cout << "map " << binaryFile << ": " << mapSeconds * 1000 << " ms" << std::endl;
+    return 0;
+}